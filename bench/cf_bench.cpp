@@ -0,0 +1,367 @@
+/**
+ * @file cf_bench.cpp
+ * @brief Benchmark del parser del codice fiscale
+ *
+ * Uso:
+ *   cf_bench                      (entrambe le prove, dimensioni predefinite)
+ *   cf_bench cerca [MB]
+ *   cf_bench lotti [milioni di codici]
+ *
+ * cerca: cerca tutti i codici in un testo UTF-16 sintetico (parole, date,
+ * numeri, hash esadecimali e un codice fiscale ogni 400 caratteri circa)
+ * con la std::wregex usata prima dell'automa, con l'automa senza
+ * prefiltro e con il prefiltro vettoriale a ogni livello disponibile sulla
+ * CPU. La velocita' e' in GB/s di testo UTF-16 (2 byte per carattere) per
+ * tutte le righe; la regex, molto piu' lenta, viene misurata sul primo
+ * milione di caratteri.
+ *
+ * lotti: verifica e normalizza un elenco di record da 16 code unit UTF-16
+ * (un quinto con un carattere alterato) con validateBatch() e
+ * normalizeOmocodiaBatch(), confrontati con un ciclo su
+ * isValidCodiceFiscale() e normalizeOmocodia() per singolo codice.
+ *
+ * Da compilare in Release: i tempi di una build di debug non sono
+ * indicativi.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <random>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "cf_matcher.h"
+#include "cf_parser.h"
+#include "cf_simd.h"
+
+using namespace cfparser;
+
+// ============================================================================
+// Dati di prova
+// ============================================================================
+
+/// Regex della versione originale di extractCodiceFiscale()
+static const wchar_t* REGEX_PATTERN =
+    L"(?:(?:[B-DF-HJ-NP-TV-Z]|[AEIOU])[AEIOU][AEIOUX]|[B-DF-HJ-NP-TV-Z]{2}[A-Z]){2}"
+    L"[\\dLMNP-V]{2}"
+    L"(?:[A-EHLMPR-T](?:[04LQ][1-9MNP-V]|[1256MNRS][\\dLMNP-V])|[DHPS][37PT][0L]|[ACELMRT][37PT][01LM])"
+    L"(?:[A-MZ][1-9MNP-V][\\dLMNP-V]{2}|[A-M][0L](?:[1-9MNP-V][\\dLMNP-V]|[0L][1-9MNP-V]))"
+    L"[A-Z]";
+
+/// Caratteri su cui viene misurata la regex
+static constexpr size_t REGEX_LENGTH = 1 << 20;
+
+static const char* const WORDS[] = {
+    "paziente", "visita", "ricetta", "esenzione", "prescrizione", "ambulatorio",
+    "controllo", "terapia", "referto", "ore", "il", "di", "per", "con", "ASL",
+    "MMG", "ERR", "INFO", "2026-10-17", "09:41:12", "12345", "3,50", "n.", "pag."
+};
+
+class TextGenerator {
+public:
+    explicit TextGenerator(uint32_t seed) : m_random(seed) {}
+
+    /**
+     * @brief Codice fiscale valido casuale, omocodico in un caso su otto.
+     */
+    std::wstring code() {
+        static const wchar_t* const MONTHS = L"ABCDEHLMPRST";
+        static const wchar_t* const OMOCODES = L"LMNPQRSTUV";
+        wchar_t cf[16];
+        static const wchar_t* const CONSONANTS = L"BCDFGHJKLMNPQRSTVWXYZ";
+        for (int i = 0; i < 6; i += 3) {
+            // Due consonanti e una lettera qualsiasi: sempre nella grammatica
+            cf[i] = CONSONANTS[below(21)];
+            cf[i + 1] = CONSONANTS[below(21)];
+            cf[i + 2] = static_cast<wchar_t>(L'A' + below(26));
+        }
+        const unsigned day = 1 + below(28) + (below(2) ? 40 : 0);
+        cf[6] = static_cast<wchar_t>(L'0' + below(10));
+        cf[7] = static_cast<wchar_t>(L'0' + below(10));
+        cf[8] = MONTHS[below(12)];
+        cf[9] = static_cast<wchar_t>(L'0' + day / 10);
+        cf[10] = static_cast<wchar_t>(L'0' + day % 10);
+        cf[11] = static_cast<wchar_t>(L'A' + below(13));
+        cf[12] = static_cast<wchar_t>(L'1' + below(9));
+        cf[13] = static_cast<wchar_t>(L'0' + below(10));
+        cf[14] = static_cast<wchar_t>(L'0' + below(10));
+        if (below(8) == 0) {
+            cf[14] = OMOCODES[cf[14] - L'0'];
+        }
+        cf[15] = L'A';
+        std::wstring result(cf, 16);
+        result[15] = calculateCIN(result);
+        return result;
+    }
+
+    /**
+     * @brief Testo di length caratteri simile a un log o a un export di note.
+     */
+    std::u16string text(size_t length) {
+        std::u16string result;
+        result.reserve(length + 64);
+        while (result.size() < length) {
+            const unsigned kind = below(100);
+            if (kind < 2) {
+                const std::wstring cf = code();
+                result.append(cf.begin(), cf.end());
+            } else if (kind < 5) {
+                // Sequenze alfanumeriche lunghe che non sono codici
+                for (int i = 0; i < 32; i++) {
+                    result += u"0123456789abcdef"[below(16)];
+                }
+            } else {
+                const char* word = WORDS[below(sizeof(WORDS) / sizeof(WORDS[0]))];
+                result.append(word, word + std::strlen(word));
+            }
+            result += below(10) == 0 ? u'\n' : u' ';
+        }
+        result.resize(length);
+        return result;
+    }
+
+private:
+    unsigned below(unsigned n) { return std::uniform_int_distribution<unsigned>(0, n - 1)(m_random); }
+
+    std::mt19937 m_random;
+};
+
+// ============================================================================
+// Misure
+// ============================================================================
+
+struct Measure {
+    double seconds;
+    size_t found;
+};
+
+template <typename F>
+static Measure measure(F search) {
+    const auto start = std::chrono::steady_clock::now();
+    const size_t found = search();
+    return {std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), found};
+}
+
+static void printRow(const char* name, size_t characters, const Measure& m) {
+    const double gigabytes = static_cast<double>(characters) * 2 / 1e9;
+    std::printf("  %-28s %9.3f s %8.3f GB/s %9zu codici\n", name, m.seconds, gigabytes / m.seconds, m.found);
+}
+
+/// Tutti i codici, senza sovrapposizioni, con findCodiceFiscale()
+template <typename CharT>
+static size_t countCodes(std::basic_string_view<CharT> text) {
+    size_t found = 0;
+    size_t pos = findCodiceFiscale(text, 0);
+    while (pos != std::basic_string_view<CharT>::npos) {
+        found++;
+        pos = findCodiceFiscale(text, pos + 16);
+    }
+    return found;
+}
+
+/// Come countCodes(), con il prefiltro a un livello imposto
+static size_t countCodesAtLevel(const std::u16string& text, simd::Level level) {
+    size_t found = 0;
+    size_t candidate = simd::findCandidate(text.data(), text.size(), 0, level);
+    while (candidate != SIZE_MAX) {
+        if (matcher::matchesAt(text.data() + candidate)) {
+            found++;
+            candidate += 16;
+        } else {
+            candidate++;
+        }
+        candidate = simd::findCandidate(text.data(), text.size(), candidate, level);
+    }
+    return found;
+}
+
+/**
+ * @brief Ricerca in testo lungo: regex, automa e prefiltro vettoriale.
+ *
+ * @return false se i metodi non trovano gli stessi codici
+ */
+static bool benchSearch(size_t megabytes) {
+    const size_t length = megabytes << 20;
+    TextGenerator generator(20261017);
+    const std::u16string text = generator.text(length);
+    const std::u32string text32(text.begin(), text.end());
+    std::printf("Ricerca in %zu MB di testo (%zu caratteri)\n", megabytes, length);
+
+    // Regex originale su una porzione del testo, confrontata con l'automa
+    const size_t regexLength = std::min(length, REGEX_LENGTH);
+    const std::wstring slice(text.begin(), text.begin() + regexLength);
+    const std::wregex regex(REGEX_PATTERN, std::regex_constants::icase);
+    const Measure regexMeasure = measure([&] {
+        return static_cast<size_t>(std::distance(std::wsregex_iterator(slice.begin(), slice.end(), regex),
+                                                 std::wsregex_iterator()));
+    });
+    printRow("std::wregex (1M caratteri)", regexLength, regexMeasure);
+    bool same = regexMeasure.found == countCodes(std::u16string_view(text).substr(0, regexLength));
+
+    const Measure dfa = measure([&] { return countCodes(std::u32string_view(text32)); });
+    printRow("automa senza prefiltro", length, dfa);
+
+    static const struct {
+        simd::Level level;
+        const char* name;
+    } LEVELS[] = {
+        {simd::Level::Scalar, "prefiltro scalare"},
+        {simd::Level::SSE2, "prefiltro SSE2"},
+        {simd::Level::AVX2, "prefiltro AVX2"},
+    };
+    for (const auto& level : LEVELS) {
+        if (level.level > simd::detectLevel()) {
+            continue;
+        }
+        const Measure m = measure([&] { return countCodesAtLevel(text, level.level); });
+        printRow(level.name, length, m);
+        same = same && m.found == dfa.found;
+    }
+
+    const Measure find = measure([&] { return countCodes(std::u16string_view(text)); });
+    printRow("findCodiceFiscale (UTF-16)", length, find);
+    same = same && find.found == dfa.found;
+
+    if (!same) {
+        std::fprintf(stderr, "Errore: i metodi non trovano gli stessi codici\n");
+    }
+    return same;
+}
+
+// ============================================================================
+// Verifica a lotti
+// ============================================================================
+
+/**
+ * @brief Elenco di record da 16 code unit per la prova a lotti.
+ */
+static std::vector<char16_t> makeRecords(size_t count) {
+    TextGenerator generator(20261017);
+    std::mt19937 random(1);
+    std::vector<char16_t> records;
+    records.reserve(count * 16);
+    for (size_t i = 0; i < count; i++) {
+        std::wstring cf = generator.code();
+        if (random() % 5 == 0) {
+            cf[random() % 16] = L"0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"[random() % 36];
+        }
+        records.insert(records.end(), cf.begin(), cf.end());
+    }
+    return records;
+}
+
+static void printBatchRow(const char* name, size_t count, const Measure& m) {
+    std::printf("  %-36s %7.3f s %7.1f M codici/s %9zu\n", name, m.seconds,
+                static_cast<double>(count) / 1e6 / m.seconds, m.found);
+}
+
+/// Record diversi tra i due elenchi (codici omocodici normalizzati)
+static size_t countChanged(const std::vector<char16_t>& a, const std::vector<char16_t>& b) {
+    size_t changed = 0;
+    for (size_t i = 0; i < a.size(); i += 16) {
+        changed += std::memcmp(&a[i], &b[i], 16 * sizeof(char16_t)) != 0 ? 1 : 0;
+    }
+    return changed;
+}
+
+/**
+ * @brief Verifica e normalizzazione a lotti contro i cicli per codice.
+ *
+ * @return false se i risultati non coincidono
+ */
+static bool benchBatch(size_t millions) {
+    const size_t count = millions * 1000000;
+    const std::vector<char16_t> records = makeRecords(count);
+    const auto* batch = reinterpret_cast<const char16_t(*)[16]>(records.data());
+    std::printf("Verifica di %zu codici (colonna finale: validi / normalizzati)\n", count);
+
+    const Measure loop = measure([&] {
+        size_t valid = 0;
+        for (size_t i = 0; i < count; i++) {
+            const std::wstring cf(&records[i * 16], &records[i * 16] + 16);
+            valid += isValidCodiceFiscale(cf) ? 1 : 0;
+        }
+        return valid;
+    });
+    printBatchRow("isValidCodiceFiscale(wstring)", count, loop);
+
+    const Measure loopView = measure([&] {
+        size_t valid = 0;
+        for (size_t i = 0; i < count; i++) {
+            valid += isValidCodiceFiscale(std::u16string_view(&records[i * 16], 16)) ? 1 : 0;
+        }
+        return valid;
+    });
+    printBatchRow("isValidCodiceFiscale(u16string_view)", count, loopView);
+
+    std::vector<uint8_t> results(count);
+    const Measure validate = measure([&] {
+        validateBatch(batch, count, results.data());
+        return static_cast<size_t>(std::count(results.begin(), results.end(), 0));
+    });
+    printBatchRow("validateBatch", count, validate);
+
+    std::vector<char16_t> normalized(records.size());
+    Measure normalizeLoop = measure([&] {
+        for (size_t i = 0; i < count; i++) {
+            const std::wstring cf = normalizeOmocodia(std::wstring(&records[i * 16], &records[i * 16] + 16));
+            std::copy(cf.begin(), cf.end(), &normalized[i * 16]);
+        }
+        return size_t(0);
+    });
+    normalizeLoop.found = countChanged(records, normalized);
+    printBatchRow("normalizeOmocodia(wstring)", count, normalizeLoop);
+
+    std::vector<char16_t> normalizedBatch(records.size());
+    Measure normalizeBatch = measure([&] {
+        normalizeOmocodiaBatch(batch, reinterpret_cast<char16_t(*)[16]>(normalizedBatch.data()), count);
+        return size_t(0);
+    });
+    normalizeBatch.found = countChanged(records, normalizedBatch);
+    printBatchRow("normalizeOmocodiaBatch", count, normalizeBatch);
+
+    const bool same = loop.found == loopView.found && loop.found == validate.found &&
+                      normalized == normalizedBatch;
+    if (!same) {
+        std::fprintf(stderr, "Errore: i risultati a lotti non coincidono con quelli per codice\n");
+    }
+    return same;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+static const char* USAGE = "Uso: cf_bench [cerca [MB] | lotti [milioni di codici]]\n";
+
+int main(int argc, char** argv) {
+    if (argc == 1) {
+        const bool search = benchSearch(64);
+        std::printf("\n");
+        return search && benchBatch(10) ? 0 : 1;
+    }
+
+    const bool search = std::strcmp(argv[1], "cerca") == 0;
+    if ((!search && std::strcmp(argv[1], "lotti") != 0) || argc > 3) {
+        std::fprintf(stderr, "%s", USAGE);
+        return 2;
+    }
+    size_t size = search ? 64 : 10;
+    if (argc == 3) {
+        char* end = nullptr;
+        const unsigned long value = std::strtoul(argv[2], &end, 10);
+        if (*end != '\0' || value == 0) {
+            std::fprintf(stderr, "%s", USAGE);
+            return 2;
+        }
+        size = value;
+    }
+
+    return (search ? benchSearch(size) : benchBatch(size)) ? 0 : 1;
+}
@@ -0,0 +1,217 @@
+# ============================================================================
+# Generate-BelfioreTable.ps1 - Rigenera src/belfiore_data.inc
+# ============================================================================
+# Questo script costruisce la tabella dei codici catastali incorporata
+# nell'eseguibile a partire dai file ufficiali:
+#
+#   - Archivio comuni ANPR (CSV, comuni attuali e cessati con le date di
+#     istituzione e cessazione)
+#   - Elenco ISTAT delle unita' territoriali estere (CSV, codici Z...),
+#     eventualmente unito all'elenco degli stati cessati
+#
+# Per ogni codice viene tenuta la denominazione piu' recente e l'intervallo
+# di validita' complessivo (prima istituzione - ultima cessazione).
+#
+# I nomi delle colonne cambiano tra le versioni dei file: se necessario
+# indicarli con i parametri *Column.
+#
+# Uso:
+#   .\scripts\Generate-BelfioreTable.ps1 -ComuniCsv ANPR_archivio_comuni.csv `
+#       -EsteriCsv Elenco-codici-stati-esteri.csv
+#   .\scripts\Generate-BelfioreTable.ps1 -ComuniCsv comuni.csv -EsteriCsv esteri.csv `
+#       -EsteriCessatiCsv esteri-cessati.csv -EsteriDelimiter ";"
+# ============================================================================
+
+[CmdletBinding()]
+param(
+    [Parameter(Mandatory = $true)]
+    [string]$ComuniCsv,
+
+    [Parameter(Mandatory = $true)]
+    [string]$EsteriCsv,
+
+    [Parameter(Mandatory = $false)]
+    [string]$EsteriCessatiCsv = "",
+
+    [Parameter(Mandatory = $false)]
+    [string]$ComuniDelimiter = ",",
+
+    [Parameter(Mandatory = $false)]
+    [string]$EsteriDelimiter = ";",
+
+    [Parameter(Mandatory = $false)]
+    [string]$ComuniCodeColumn = "CODCATASTALE",
+
+    [Parameter(Mandatory = $false)]
+    [string]$ComuniNameColumn = "DENOMINAZIONE_IT",
+
+    [Parameter(Mandatory = $false)]
+    [string]$ComuniProvinceColumn = "SIGLAPROVINCIA",
+
+    [Parameter(Mandatory = $false)]
+    [string]$ComuniFromColumn = "DATAISTITUZIONE",
+
+    [Parameter(Mandatory = $false)]
+    [string]$ComuniToColumn = "DATACESSAZIONE",
+
+    [Parameter(Mandatory = $false)]
+    [string]$EsteriCodeColumn = "Codice AT",
+
+    [Parameter(Mandatory = $false)]
+    [string]$EsteriNameColumn = "Denominazione IT",
+
+    [Parameter(Mandatory = $false)]
+    [string]$EsteriToColumn = "Anno evento",
+
+    [Parameter(Mandatory = $false)]
+    [string]$OutputPath = ""
+)
+
+$ErrorActionPreference = "Stop"
+$ProjectRoot = Split-Path -Parent (Split-Path -Parent $MyInvocation.MyCommand.Path)
+
+if ([string]::IsNullOrWhiteSpace($OutputPath)) {
+    $OutputPath = Join-Path $ProjectRoot "src\belfiore_data.inc"
+}
+
+Write-Host "`n============================================" -ForegroundColor Cyan
+Write-Host "  MWCFExtractor - Tabella codici catastali" -ForegroundColor Cyan
+Write-Host "============================================`n" -ForegroundColor Cyan
+
+$CodeLetters = "ABCDEFGHIJKLMZ"
+
+# Converte una data (AAAA-MM-GG, GG/MM/AAAA o solo anno) in AAAAMMGG; 0 se assente
+function ConvertTo-DateKey {
+    param([string]$Value, [switch]$EndOfYear)
+
+    $v = $Value.Trim()
+    if ([string]::IsNullOrWhiteSpace($v)) { return 0 }
+    if ($v -match '^(\d{4})-(\d{2})-(\d{2})') {
+        $key = [int]("$($Matches[1])$($Matches[2])$($Matches[3])")
+    } elseif ($v -match '^(\d{2})/(\d{2})/(\d{4})') {
+        $key = [int]("$($Matches[3])$($Matches[2])$($Matches[1])")
+    } elseif ($v -match '^(\d{4})$') {
+        $key = if ($EndOfYear) { [int]"$($Matches[1])1231" } else { [int]"$($Matches[1])0101" }
+    } else {
+        return 0
+    }
+    # 9999-12-31 indica un codice ancora in uso
+    if ($key -ge 99990000) { return 0 }
+    return $key
+}
+
+# Chiave di ordinamento: indice della lettera * 1000 + numero
+function Get-SortKey {
+    param([string]$Code)
+    return $CodeLetters.IndexOf($Code[0]) * 1000 + [int]$Code.Substring(1)
+}
+
+# Letterale C++ wide: caratteri non ASCII come \uXXXX
+function ConvertTo-WideLiteral {
+    param([string]$Text)
+
+    $sb = New-Object System.Text.StringBuilder
+    [void]$sb.Append('L"')
+    foreach ($ch in $Text.ToCharArray()) {
+        $code = [int]$ch
+        if ($ch -eq '"' -or $ch -eq '\') {
+            [void]$sb.Append('\').Append($ch)
+        } elseif ($code -lt 0x20 -or $code -gt 0x7E) {
+            [void]$sb.Append(('\u{0:X4}' -f $code))
+        } else {
+            [void]$sb.Append($ch)
+        }
+    }
+    [void]$sb.Append('"')
+    return $sb.ToString()
+}
+
+$places = @{}
+
+# Aggiunge o unisce una riga: nome piu' recente, intervallo complessivo
+function Add-Place {
+    param([string]$Code, [string]$Name, [string]$Province, [int]$From, [int]$To)
+
+    $Code = $Code.Trim().ToUpperInvariant()
+    if ($Code -notmatch '^[A-MZ]\d{3}$') {
+        Write-Host "  Codice ignorato: '$Code' ($Name)" -ForegroundColor Yellow
+        return
+    }
+
+    if (-not $places.ContainsKey($Code)) {
+        $places[$Code] = [pscustomobject]@{
+            Code = $Code; Name = $Name.Trim(); Province = $Province.Trim()
+            From = $From; To = $To
+        }
+        return
+    }
+
+    $p = $places[$Code]
+    $isNewer = ($To -eq 0) -or ($p.To -ne 0 -and $To -gt $p.To)
+    if ($isNewer) {
+        $p.Name = $Name.Trim()
+        $p.Province = $Province.Trim()
+    }
+    if ($From -ne 0 -and ($p.From -eq 0 -or $From -lt $p.From)) { $p.From = $From }
+    if ($To -eq 0 -or $p.To -eq 0) { $p.To = 0 } elseif ($To -gt $p.To) { $p.To = $To }
+}
+
+# Comuni
+Write-Host "Lettura comuni: $ComuniCsv" -ForegroundColor Yellow
+foreach ($row in (Import-Csv -Path $ComuniCsv -Delimiter $ComuniDelimiter -Encoding UTF8)) {
+    Add-Place -Code $row.$ComuniCodeColumn -Name $row.$ComuniNameColumn `
+        -Province $row.$ComuniProvinceColumn `
+        -From (ConvertTo-DateKey $row.$ComuniFromColumn) `
+        -To (ConvertTo-DateKey $row.$ComuniToColumn -EndOfYear)
+}
+
+# Stati esteri (attuali ed eventualmente cessati)
+$esteriFiles = @($EsteriCsv)
+if (-not [string]::IsNullOrWhiteSpace($EsteriCessatiCsv)) {
+    $esteriFiles += $EsteriCessatiCsv
+}
+foreach ($file in $esteriFiles) {
+    Write-Host "Lettura stati esteri: $file" -ForegroundColor Yellow
+    $isCessati = ($file -eq $EsteriCessatiCsv)
+    foreach ($row in (Import-Csv -Path $file -Delimiter $EsteriDelimiter -Encoding UTF8)) {
+        $to = 0
+        if ($isCessati) {
+            $to = ConvertTo-DateKey $row.$EsteriToColumn -EndOfYear
+        }
+        Add-Place -Code $row.$EsteriCodeColumn -Name $row.$EsteriNameColumn `
+            -Province "EE" -From 0 -To $to
+    }
+}
+
+if ($places.Count -eq 0) {
+    Write-Host "Errore: nessun codice letto" -ForegroundColor Red
+    exit 1
+}
+
+# Scrittura
+$sorted = $places.Values | Sort-Object { Get-SortKey $_.Code }
+$lines = New-Object System.Collections.Generic.List[string]
+$lines.Add("// ============================================================================")
+$lines.Add("// belfiore_data.inc - Tabella dei codici catastali (comuni e stati esteri)")
+$lines.Add("// ============================================================================")
+$lines.Add("// Generato da scripts/Generate-BelfioreTable.ps1: non modificare a mano.")
+$lines.Add("//")
+$lines.Add("// Fonti: $(Split-Path -Leaf $ComuniCsv), $(($esteriFiles | ForEach-Object { Split-Path -Leaf $_ }) -join ', ')")
+$lines.Add("// Generato il: $(Get-Date -Format 'yyyy-MM-dd')")
+$lines.Add("//")
+$lines.Add("// Righe ordinate per codice (A-M, Z; poi numero).")
+$lines.Add("// ============================================================================")
+$lines.Add("")
+$lines.Add("#define BELFIORE_TABLE_COMPLETE 1")
+$lines.Add("")
+$lines.Add("static constexpr Place PLACES[] = {")
+foreach ($p in $sorted) {
+    $province = if ($p.Province.Length -eq 2) { $p.Province.ToUpperInvariant() } else { "" }
+    $lines.Add("    { `"$($p.Code)`", $(ConvertTo-WideLiteral $p.Name), `"$province`", $($p.From), $($p.To) },")
+}
+$lines.Add("};")
+
+$utf8NoBom = New-Object System.Text.UTF8Encoding($false)
+[System.IO.File]::WriteAllLines($OutputPath, $lines, $utf8NoBom)
+
+Write-Host "`nScritti $($places.Count) codici in $OutputPath`n" -ForegroundColor Green
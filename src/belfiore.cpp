@@ -0,0 +1,178 @@
+#include "belfiore.h"
+#include "cf_matcher.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace cfparser {
+namespace belfiore {
+
+#include "belfiore_data.inc"
+
+using matcher::symbolOf;
+
+// ============================================================================
+// Indice: una posizione per ogni codice possibile
+// ============================================================================
+
+// Lettere ammesse in prima posizione, in ordine
+static constexpr char CODE_LETTERS[] = "ABCDEFGHIJKLMZ";
+static constexpr size_t CODE_LETTER_COUNT = sizeof(CODE_LETTERS) - 1;
+static constexpr size_t KEY_SPACE = CODE_LETTER_COUNT * 1000;
+static constexpr size_t INDEX_WORDS = (KEY_SPACE + 63) / 64;
+static constexpr size_t PLACE_COUNT = sizeof(PLACES) / sizeof(PLACES[0]);
+static constexpr int NO_KEY = -1;
+
+/**
+ * @brief Tabelle per simbolo: indice della lettera iniziale e valore della cifra
+ *        (anche omocodica), -1 se non ammesso.
+ */
+struct SymbolTables {
+    int8_t letterIndex[matcher::SYMBOL_COUNT];
+    int8_t digit[matcher::SYMBOL_COUNT];
+};
+
+static constexpr SymbolTables buildSymbolTables() {
+    SymbolTables t{};
+    for (size_t s = 0; s < matcher::SYMBOL_COUNT; s++) {
+        t.letterIndex[s] = NO_KEY;
+        t.digit[s] = static_cast<int8_t>(matcher::digitValue(static_cast<uint8_t>(s)));
+    }
+    for (size_t i = 0; i < CODE_LETTER_COUNT; i++) {
+        t.letterIndex[symbolOf(CODE_LETTERS[i])] = static_cast<int8_t>(i);
+    }
+    return t;
+}
+
+static constexpr SymbolTables SYMBOLS = buildSymbolTables();
+
+/**
+ * @brief Chiave 0..13999 di un codice (lettera * 1000 + numero), -1 se non valido.
+ */
+template <typename CharT>
+static constexpr int keyOf(const CharT* code) {
+    const int letter = SYMBOLS.letterIndex[symbolOf(code[0])];
+    const int hundreds = SYMBOLS.digit[symbolOf(code[1])];
+    const int tens = SYMBOLS.digit[symbolOf(code[2])];
+    const int units = SYMBOLS.digit[symbolOf(code[3])];
+    if ((letter | hundreds | tens | units) < 0) {
+        return NO_KEY;
+    }
+    return letter * 1000 + hundreds * 100 + tens * 10 + units;
+}
+
+/**
+ * @brief Bitmap dei codici presenti con il rank cumulato di ogni parola.
+ *
+ * L'indice di un codice nella tabella e' il numero di bit a 1 che lo
+ * precedono: rank[parola] + popcount dei bit inferiori nella parola.
+ */
+struct RankIndex {
+    uint64_t bits[INDEX_WORDS];
+    uint16_t rank[INDEX_WORDS];
+};
+
+static constexpr RankIndex buildIndex() {
+    RankIndex index{};
+    for (size_t i = 0; i < PLACE_COUNT; i++) {
+        const int key = keyOf(PLACES[i].code);
+        index.bits[key / 64] |= uint64_t(1) << (key % 64);
+    }
+    uint16_t total = 0;
+    for (size_t w = 0; w < INDEX_WORDS; w++) {
+        index.rank[w] = total;
+        for (uint64_t bits = index.bits[w]; bits != 0; bits &= bits - 1) {
+            total++;
+        }
+    }
+    return index;
+}
+
+static constexpr bool isSortedAndValid() {
+    int previous = NO_KEY;
+    for (size_t i = 0; i < PLACE_COUNT; i++) {
+        const int key = keyOf(PLACES[i].code);
+        if (key <= previous) {
+            return false;
+        }
+        previous = key;
+    }
+    return true;
+}
+
+static_assert(isSortedAndValid(), "PLACES deve essere ordinata per codice, senza duplicati");
+static_assert(PLACE_COUNT <= UINT16_MAX, "Il rank e' memorizzato in 16 bit");
+
+static constexpr RankIndex INDEX = buildIndex();
+
+static inline int popcount64(uint64_t value) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    return static_cast<int>(__popcnt64(value));
+#elif defined(_MSC_VER)
+    return static_cast<int>(__popcnt(static_cast<unsigned>(value)) +
+                            __popcnt(static_cast<unsigned>(value >> 32)));
+#else
+    return __builtin_popcountll(value);
+#endif
+}
+
+template <typename CharT>
+static const Place* lookupImpl(const CharT* code) {
+    const int key = keyOf(code);
+    if (key == NO_KEY) {
+        return nullptr;
+    }
+
+    const uint64_t word = INDEX.bits[key / 64];
+    const uint64_t bit = uint64_t(1) << (key % 64);
+    if ((word & bit) == 0) {
+        return nullptr;
+    }
+    return &PLACES[INDEX.rank[key / 64] + popcount64(word & (bit - 1))];
+}
+
+template <typename CharT>
+static bool isUnassignedNumberImpl(const CharT* code) {
+    const int key = keyOf(code);
+    return key != NO_KEY && key % 1000 == 0;
+}
+
+// ============================================================================
+// API pubblica
+// ============================================================================
+
+bool isTableComplete() {
+    return BELFIORE_TABLE_COMPLETE != 0;
+}
+
+size_t placeCount() {
+    return PLACE_COUNT;
+}
+
+const Place* lookup(const wchar_t* code) {
+    return lookupImpl(code);
+}
+
+const Place* lookup(const char16_t* code) {
+    return lookupImpl(code);
+}
+
+const Place* lookup(const char* code) {
+    return lookupImpl(code);
+}
+
+bool isUnassignedNumber(const wchar_t* code) {
+    return isUnassignedNumberImpl(code);
+}
+
+bool isUnassignedNumber(const char16_t* code) {
+    return isUnassignedNumberImpl(code);
+}
+
+bool isUnassignedNumber(const char* code) {
+    return isUnassignedNumberImpl(code);
+}
+
+} // namespace belfiore
+} // namespace cfparser
@@ -0,0 +1,113 @@
+#ifndef BELFIORE_H
+#define BELFIORE_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cfparser {
+namespace belfiore {
+
+/**
+ * @brief Comune italiano o stato estero identificato da un codice catastale.
+ *
+ * Le date sono nel formato AAAAMMGG; 0 indica una data non nota (validFrom)
+ * o un codice ancora in uso (validTo).
+ */
+struct Place {
+    char code[5];           ///< Codice catastale, es. "H501"
+    const wchar_t* name;    ///< Denominazione
+    char province[3];       ///< Sigla della provincia, "EE" per gli stati esteri
+    uint32_t validFrom;     ///< Prima data di validita'
+    uint32_t validTo;       ///< Data di soppressione
+
+    /**
+     * @brief Indica se il codice identifica uno stato estero (Z...).
+     */
+    bool isForeign() const { return code[0] == 'Z'; }
+
+    /**
+     * @brief Verifica che il codice fosse in uso alla data indicata.
+     *
+     * @param date Data nel formato AAAAMMGG
+     */
+    bool isValidOn(uint32_t date) const {
+        return (validFrom == 0 || date >= validFrom) && (validTo == 0 || date <= validTo);
+    }
+};
+
+/**
+ * @brief Indica se la tabella incorporata contiene tutti i codici ufficiali.
+ *
+ * Solo in questo caso un codice assente puo' essere considerato inesistente;
+ * con una tabella parziale l'assenza significa soltanto "non noto".
+ */
+bool isTableComplete();
+
+/**
+ * @brief Numero di codici nella tabella incorporata.
+ */
+size_t placeCount();
+
+/**
+ * @brief Cerca un codice catastale.
+ *
+ * La tabella e' indicizzata da una bitmap con rank (una posizione per ogni
+ * codice possibile, A-M o Z seguito da 3 cifre): la ricerca e' una funzione
+ * hash perfetta minimale, senza confronti di stringhe ne' allocazioni.
+ * Le cifre possono essere lettere omocodiche; maiuscole e minuscole sono
+ * equivalenti.
+ *
+ * @param code Puntatore a 4 caratteri
+ * @return Il luogo, o nullptr se il codice non e' nella tabella
+ */
+const Place* lookup(const wchar_t* code);
+const Place* lookup(const char16_t* code);
+const Place* lookup(const char* code);
+
+/**
+ * @brief Cerca il luogo di nascita di un codice fiscale (posizioni 12-15).
+ *
+ * @param cf Puntatore a 16 caratteri
+ * @return Il luogo, o nullptr se il codice non e' nella tabella
+ */
+inline const Place* lookupCodiceFiscale(const wchar_t* cf) {
+    return lookup(cf + 11);
+}
+
+/**
+ * @brief Indica se il numero di un codice catastale e' 000.
+ *
+ * La numerazione parte da 001 per ogni lettera: un codice con numero 000
+ * non esiste, qualunque sia la tabella incorporata.
+ *
+ * @param code Puntatore a 4 caratteri (cifre anche omocodiche)
+ */
+bool isUnassignedNumber(const wchar_t* code);
+bool isUnassignedNumber(const char16_t* code);
+bool isUnassignedNumber(const char* code);
+
+/**
+ * @brief Verifica che il luogo di nascita non sia sicuramente errato.
+ *
+ * Restituisce false se il numero del codice e' 000 (mai assegnato), se la
+ * tabella e' completa e il codice non c'e', oppure se il codice non era in
+ * uso alla data di nascita (solo per i codici con date di validita' note,
+ * anche con la tabella parziale).
+ *
+ * @param cf Puntatore a 16 caratteri (senza omocodia nelle posizioni 13-15
+ *           o con lettere omocodiche: lookup() le accetta entrambe)
+ * @param birthDate Data di nascita nel formato AAAAMMGG, 0 se non nota
+ */
+template <typename CharT>
+inline bool isPlausibleBirthplace(const CharT* cf, uint32_t birthDate = 0) {
+    const Place* place = lookup(cf + 11);
+    if (place == nullptr) {
+        return !isTableComplete() && !isUnassignedNumber(cf + 11);
+    }
+    return birthDate == 0 || place->isValidOn(birthDate);
+}
+
+} // namespace belfiore
+} // namespace cfparser
+
+#endif // BELFIORE_H
@@ -0,0 +1,39 @@
+#ifndef BIT_UTIL_H
+#define BIT_UTIL_H
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace cfparser {
+
+/**
+ * @brief Indice del bit a 1 meno significativo.
+ *
+ * _BitScanForward64 esiste solo su MSVC x64; su MSVC x86 e ARM si usa il
+ * ciclo portabile.
+ *
+ * @param mask Maschera diversa da 0
+ */
+inline int lowestBit(uint64_t mask) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return static_cast<int>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(mask);
+#else
+    int index = 0;
+    while ((mask & 1) == 0) {
+        mask >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+} // namespace cfparser
+
+#endif // BIT_UTIL_H
@@ -0,0 +1,262 @@
+#include "cf_correct.h"
+#include "cf_matcher.h"
+#include "omocodia.h"
+#include <algorithm>
+#include <iterator>
+
+namespace cfparser {
+
+using matcher::CharSet;
+using matcher::symbolOf;
+
+// ============================================================================
+// Tabelle
+// ============================================================================
+
+static constexpr size_t CIN_POSITIONS = matcher::CF_LENGTH - 1;
+static constexpr size_t ALNUM_COUNT = matcher::SYMBOL_COUNT - 1;
+
+/**
+ * @brief Per ogni parita' di posizione e resto modulo 26, i simboli che
+ *        hanno quel peso nel CIN.
+ */
+struct ResidueTable {
+    CharSet symbols[2][26];
+};
+
+static constexpr ResidueTable buildResidueTable() {
+    ResidueTable t{};
+    for (size_t parity = 0; parity < 2; parity++) {
+        for (uint8_t s = 0; s < ALNUM_COUNT; s++) {
+            t.symbols[parity][matcher::cinValue(parity, s) % 26] |= CharSet(1) << s;
+        }
+    }
+    return t;
+}
+
+static constexpr ResidueTable RESIDUES = buildResidueTable();
+
+/**
+ * @brief Coppie di simboli simili (per forma o posizione sulla tastiera).
+ */
+struct SimilarityTable {
+    CharSet similar[ALNUM_COUNT];
+};
+
+static constexpr SimilarityTable buildSimilarity(const char* const* groups, size_t count,
+                                                 bool adjacentOnly) {
+    SimilarityTable t{};
+    for (size_t g = 0; g < count; g++) {
+        const char* group = groups[g];
+        for (size_t i = 0; group[i]; i++) {
+            for (size_t j = 0; group[j]; j++) {
+                const bool related = adjacentOnly ? (i + 1 == j || j + 1 == i) : (i != j);
+                if (related) {
+                    t.similar[symbolOf(group[i])] |= CharSet(1) << symbolOf(group[j]);
+                }
+            }
+        }
+    }
+    return t;
+}
+
+// Caratteri confusi a vista (coppie)
+static constexpr const char* CONFUSABLE_GROUPS[] = {
+    "0O", "0D", "0Q", "1I", "1L", "2Z", "5S", "6G", "8B", "UV", "MN"
+};
+
+// Righe della tastiera: i vicini orizzontali
+static constexpr const char* KEYBOARD_ROWS[] = {
+    "1234567890", "QWERTYUIOP", "ASDFGHJKL", "ZXCVBNM"
+};
+
+static constexpr SimilarityTable CONFUSABLE =
+    buildSimilarity(CONFUSABLE_GROUPS, std::size(CONFUSABLE_GROUPS), false);
+static constexpr SimilarityTable ADJACENT =
+    buildSimilarity(KEYBOARD_ROWS, std::size(KEYBOARD_ROWS), true);
+
+// Costi delle modifiche (piu' basso = piu' probabile)
+static constexpr uint8_t COST_CONFUSABLE = 1;
+static constexpr uint8_t COST_ADJACENT = 2;
+static constexpr uint8_t COST_TRANSPOSITION = 2;
+static constexpr uint8_t COST_CIN = 3;
+static constexpr uint8_t COST_OTHER = 4;
+static constexpr uint8_t PENALTY_OMOCODIA = 2;
+static constexpr uint8_t PENALTY_ILLEGAL_OMOCODIA = 4;
+
+// Al piu' 3 simboli per resto: 15 posizioni * 3 + CIN + 15 scambi
+static constexpr size_t MAX_CANDIDATES = CIN_POSITIONS * 3 + 1 + CIN_POSITIONS;
+
+static constexpr bool residueSetsAreSmall() {
+    for (size_t parity = 0; parity < 2; parity++) {
+        for (size_t r = 0; r < 26; r++) {
+            int count = 0;
+            for (CharSet s = RESIDUES.symbols[parity][r]; s != 0; s &= s - 1) {
+                count++;
+            }
+            if (count > 3) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static_assert(residueSetsAreSmall(), "MAX_CANDIDATES presuppone al piu' 3 simboli per resto");
+
+// ============================================================================
+// Ricerca
+// ============================================================================
+
+static wchar_t charOf(uint8_t symbol) {
+    return static_cast<wchar_t>(symbol < 10 ? L'0' + symbol : L'A' + symbol - 10);
+}
+
+static int lowestSymbol(CharSet set) {
+    int s = 0;
+    while ((set & 1) == 0) {
+        set >>= 1;
+        s++;
+    }
+    return s;
+}
+
+static int mod26(int value) {
+    const int r = value % 26;
+    return r < 0 ? r + 26 : r;
+}
+
+/**
+ * @brief Costo di sostituire il simbolo from con to in una posizione.
+ */
+static uint8_t substitutionCost(size_t position, uint8_t from, uint8_t to) {
+    uint8_t cost = COST_OTHER;
+    if (from < ALNUM_COUNT && (CONFUSABLE.similar[from] >> to) & 1) {
+        cost = COST_CONFUSABLE;
+    } else if (from < ALNUM_COUNT && (ADJACENT.similar[from] >> to) & 1) {
+        cost = COST_ADJACENT;
+    }
+
+    // Una lettera omocodica al posto di una cifra e' un'ipotesi meno probabile
+    const bool numericPosition = std::find(std::begin(matcher::OMOCODIA_ORDER),
+                                           std::end(matcher::OMOCODIA_ORDER),
+                                           position) != std::end(matcher::OMOCODIA_ORDER);
+    if (numericPosition && from < 10 && to >= 10) {
+        cost += PENALTY_OMOCODIA;
+    }
+    return cost;
+}
+
+size_t suggestCorrections(const wchar_t* candidate, Correction* out, size_t maxResults) {
+    wchar_t code[matcher::CF_LENGTH];
+    uint8_t symbols[matcher::CF_LENGTH];
+    for (size_t i = 0; i < matcher::CF_LENGTH; i++) {
+        symbols[i] = symbolOf(candidate[i]);
+        code[i] = symbols[i] == matcher::SYMBOL_OTHER ? candidate[i] : charOf(symbols[i]);
+    }
+
+    // Prima posizione in cui la struttura non e' piu' valida
+    size_t deadAt = matcher::CF_LENGTH;
+    uint8_t state = matcher::S_SURNAME;
+    for (size_t i = 0; i < matcher::CF_LENGTH; i++) {
+        state = matcher::CF_DFA.next[state][symbols[i]];
+        if (state == matcher::S_DEAD) {
+            deadAt = i;
+            break;
+        }
+    }
+
+    int weights[CIN_POSITIONS];
+    int sum = 0;
+    for (size_t i = 0; i < CIN_POSITIONS; i++) {
+        weights[i] = matcher::cinValue(i, symbols[i]);
+        sum += weights[i];
+    }
+    const bool cinIsLetter = symbols[15] >= 10 && symbols[15] < ALNUM_COUNT;
+    const int target = symbols[15] - 10;
+
+    if (deadAt == matcher::CF_LENGTH && cinIsLetter && mod26(sum) == target) {
+        return 0;
+    }
+
+    Correction found[MAX_CANDIDATES];
+    size_t count = 0;
+
+    auto add = [&](const wchar_t* fixed, size_t position, EditKind kind, uint8_t cost) {
+        if (!matcher::matchesAt(fixed)) {
+            return;
+        }
+        Correction& c = found[count++];
+        std::copy(fixed, fixed + matcher::CF_LENGTH, c.code);
+        c.code[matcher::CF_LENGTH] = L'\0';
+        c.position = static_cast<uint8_t>(position);
+        c.kind = kind;
+        c.cost = static_cast<uint8_t>(cost + (isLegalOmocodia(fixed) ? 0 : PENALTY_ILLEGAL_OMOCODIA));
+    };
+
+    const size_t lastEditable = std::min(deadAt, CIN_POSITIONS - 1);
+    wchar_t fixed[matcher::CF_LENGTH];
+
+    // Sostituzioni: il nuovo simbolo deve avere il peso che riporta il CIN
+    if (cinIsLetter) {
+        for (size_t p = 0; p <= lastEditable; p++) {
+            const int residue = mod26(target - sum + weights[p]);
+            CharSet options = RESIDUES.symbols[p & 1][residue] & matcher::POSITION_CLASSES[p] &
+                              ~(CharSet(1) << symbols[p]);
+            for (; options != 0; options &= options - 1) {
+                const uint8_t s = static_cast<uint8_t>(lowestSymbol(options));
+                std::copy(code, code + matcher::CF_LENGTH, fixed);
+                fixed[p] = charOf(s);
+                add(fixed, p, EditKind::Substitution, substitutionCost(p, symbols[p], s));
+            }
+        }
+    }
+
+    // CIN errato con struttura valida
+    if (deadAt >= CIN_POSITIONS) {
+        std::copy(code, code + matcher::CF_LENGTH, fixed);
+        fixed[15] = charOf(static_cast<uint8_t>(mod26(sum) + 10));
+        add(fixed, 15, EditKind::Substitution, COST_CIN);
+    }
+
+    // Scambi di caratteri adiacenti: pesi aggiornati solo per le due posizioni
+    for (size_t p = 0; p <= lastEditable; p++) {
+        const size_t q = p + 1;
+        if (symbols[p] == symbols[q]) {
+            continue;
+        }
+        int newSum = sum - weights[p] + matcher::cinValue(p, symbols[q]);
+        int newTarget = target;
+        if (q < CIN_POSITIONS) {
+            newSum += matcher::cinValue(q, symbols[p]) - weights[q];
+        } else {
+            newTarget = symbols[p] - 10;
+        }
+        if (newTarget < 0 || mod26(newSum) != newTarget) {
+            continue;
+        }
+        std::copy(code, code + matcher::CF_LENGTH, fixed);
+        std::swap(fixed[p], fixed[q]);
+        add(fixed, p, EditKind::Transposition, COST_TRANSPOSITION);
+    }
+
+    std::stable_sort(found, found + count, [](const Correction& a, const Correction& b) {
+        return a.cost < b.cost;
+    });
+
+    const size_t n = std::min(count, maxResults);
+    std::copy(found, found + n, out);
+    return n;
+}
+
+std::vector<Correction> suggestCorrections(const std::wstring& candidate, size_t maxResults) {
+    std::vector<Correction> result;
+    if (candidate.length() != matcher::CF_LENGTH) {
+        return result;
+    }
+    result.resize(maxResults);
+    result.resize(suggestCorrections(candidate.c_str(), result.data(), maxResults));
+    return result;
+}
+
+} // namespace cfparser
@@ -0,0 +1,59 @@
+#ifndef CF_CORRECT_H
+#define CF_CORRECT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cfparser {
+
+/**
+ * @brief Tipo di errore di battitura corretto.
+ */
+enum class EditKind : uint8_t {
+    Substitution,   ///< Un carattere sostituito
+    Transposition   ///< Due caratteri adiacenti scambiati
+};
+
+/**
+ * @brief Correzione proposta per un codice fiscale errato.
+ */
+struct Correction {
+    wchar_t code[17];   ///< Codice corretto (maiuscolo, terminato da zero)
+    uint8_t position;   ///< Posizione modificata (la prima per gli scambi)
+    EditKind kind;      ///< Tipo di modifica
+    uint8_t cost;       ///< Costo stimato: piu' basso = piu' probabile
+};
+
+/**
+ * @brief Propone le correzioni di un codice fiscale con un solo errore.
+ *
+ * Considera le sostituzioni di un carattere e gli scambi di due caratteri
+ * adiacenti che producono un codice valido. Il CIN guida la ricerca: per
+ * ogni posizione la somma di controllo del codice errato determina il
+ * resto modulo 26 che il nuovo carattere deve avere, quindi i candidati
+ * sono letti da una tabella (resto -> caratteri) intersecata con
+ * l'alfabeto della posizione, senza ricalcolare il checksum. Le posizioni
+ * successive al primo errore di struttura sono escluse.
+ *
+ * Le correzioni sono ordinate per costo: caratteri facili da confondere
+ * (0/O, 1/I, 5/S, ...) e tasti vicini prima delle altre sostituzioni;
+ * le lettere omocodiche introdotte al posto di cifre sono penalizzate.
+ *
+ * @param candidate Puntatore a 16 caratteri
+ * @param out Array di almeno maxResults elementi
+ * @param maxResults Numero massimo di correzioni da restituire
+ * @return Il numero di correzioni scritte (0 se il codice e' gia' valido o
+ *         se nessuna modifica singola lo rende valido)
+ */
+size_t suggestCorrections(const wchar_t* candidate, Correction* out, size_t maxResults);
+
+/**
+ * @brief Come sopra, a partire da una stringa di 16 caratteri.
+ */
+std::vector<Correction> suggestCorrections(const std::wstring& candidate, size_t maxResults = 5);
+
+} // namespace cfparser
+
+#endif // CF_CORRECT_H
@@ -0,0 +1,130 @@
+#include "cf_decode.h"
+#include "cf_matcher.h"
+#include <ctime>
+
+namespace cfparser {
+
+using matcher::symbolOf;
+
+// ============================================================================
+// Tabelle per simbolo
+// ============================================================================
+
+static constexpr char MONTH_LETTERS[] = "ABCDEHLMPRST";
+
+/**
+ * @brief Valore di cifre e lettere mese per ognuno dei 37 simboli, -1 se
+ *        non ammesso.
+ */
+struct DecodeTables {
+    int8_t digit[matcher::SYMBOL_COUNT];    ///< 0-9, anche da lettera omocodica
+    int8_t month[matcher::SYMBOL_COUNT];    ///< 1-12
+};
+
+static constexpr DecodeTables buildDecodeTables() {
+    DecodeTables t{};
+    for (size_t s = 0; s < matcher::SYMBOL_COUNT; s++) {
+        t.digit[s] = static_cast<int8_t>(matcher::digitValue(static_cast<uint8_t>(s)));
+        t.month[s] = -1;
+    }
+    for (size_t m = 0; m < 12; m++) {
+        t.month[symbolOf(MONTH_LETTERS[m])] = static_cast<int8_t>(m + 1);
+    }
+    return t;
+}
+
+static constexpr DecodeTables TABLES = buildDecodeTables();
+
+// Giorni per mese (indice 1-12); 0 per gli indici non validi
+static constexpr uint8_t DAYS_IN_MONTH[16] = {
+    0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31, 0, 0, 0
+};
+
+static constexpr int FEMALE_DAY_OFFSET = 40;
+
+static_assert(TABLES.month[symbolOf('T')] == 12, "T = dicembre");
+static_assert(TABLES.digit[symbolOf('V')] == 9, "V = 9 (omocodia)");
+
+// ============================================================================
+// Decodifica
+// ============================================================================
+
+/**
+ * @brief Decodifica senza salti dipendenti dai dati: la validita' e'
+ *        accumulata in un flag invece di interrompere il calcolo.
+ */
+template <typename CharT>
+static DecodedCF decodeImpl(const CharT* cf, uint32_t referenceDate) {
+    const int yearTens = TABLES.digit[symbolOf(cf[6])];
+    const int yearUnits = TABLES.digit[symbolOf(cf[7])];
+    const int month = TABLES.month[symbolOf(cf[8])];
+    const int dayTens = TABLES.digit[symbolOf(cf[9])];
+    const int dayUnits = TABLES.digit[symbolOf(cf[10])];
+    const bool symbolsOk = (yearTens | yearUnits | month | dayTens | dayUnits) >= 0;
+
+    const int rawDay = dayTens * 10 + dayUnits;
+    const int female = rawDay > FEMALE_DAY_OFFSET;
+    const int day = rawDay - FEMALE_DAY_OFFSET * female;
+    const int monthDay = month * 100 + day;
+
+    // Secolo: 2000 se la data non supera quella di riferimento, altrimenti 1900
+    const int yy = yearTens * 10 + yearUnits;
+    const int reference = static_cast<int>(referenceDate);
+    const int in2000 = (2000 + yy) * 10000 + monthDay <= reference;
+    const int year = 1900 + yy + 100 * in2000;
+
+    const int leap = ((year & 3) == 0) & ((year % 100 != 0) | (year % 400 == 0));
+    const int daysInMonth = DAYS_IN_MONTH[month & 15] + (leap & (month == 2));
+    const bool dayOk = (day >= 1) & (day <= daysInMonth);
+
+    const int age = reference / 10000 - year - (reference % 10000 < monthDay);
+
+    DecodedCF result;
+    result.year = static_cast<uint16_t>(year);
+    result.month = static_cast<uint8_t>(month);
+    result.day = static_cast<uint8_t>(day);
+    result.sex = female ? Sex::Female : Sex::Male;
+    result.age = static_cast<uint8_t>(age < 0 ? 0 : age);
+    result.valid = symbolsOk & dayOk;
+    return result;
+}
+
+uint32_t today() {
+    const std::time_t now = std::time(nullptr);
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    return static_cast<uint32_t>((local.tm_year + 1900) * 10000 + (local.tm_mon + 1) * 100 +
+                                 local.tm_mday);
+}
+
+std::optional<DecodedCF> decode(const wchar_t* cf, uint32_t referenceDate) {
+    const DecodedCF result = decodeImpl(cf, referenceDate);
+    if (!result.valid) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+std::optional<DecodedCF> decode(const std::wstring& cf, uint32_t referenceDate) {
+    if (cf.length() != matcher::CF_LENGTH) {
+        return std::nullopt;
+    }
+    return decode(cf.c_str(), referenceDate);
+}
+
+std::optional<DecodedCF> decode(const std::wstring& cf) {
+    return decode(cf, today());
+}
+
+void decodeBatch(const char16_t (*records)[16], size_t count, uint32_t referenceDate,
+                 DecodedCF* results) {
+    for (size_t i = 0; i < count; i++) {
+        results[i] = decodeImpl(records[i], referenceDate);
+    }
+}
+
+} // namespace cfparser
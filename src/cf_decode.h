@@ -0,0 +1,84 @@
+#ifndef CF_DECODE_H
+#define CF_DECODE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace cfparser {
+
+/**
+ * @brief Sesso codificato nel giorno di nascita (femmine: giorno + 40).
+ */
+enum class Sex : uint8_t {
+    Male,
+    Female
+};
+
+/**
+ * @brief Dati anagrafici ricavati da un codice fiscale.
+ */
+struct DecodedCF {
+    uint16_t year;      ///< Anno di nascita (secolo dedotto dalla data di riferimento)
+    uint8_t month;      ///< Mese (1-12)
+    uint8_t day;        ///< Giorno (1-31)
+    Sex sex;            ///< Sesso
+    uint8_t age;        ///< Anni compiuti alla data di riferimento
+    bool valid;         ///< false se data o sesso non sono decodificabili
+
+    /**
+     * @brief Data di nascita nel formato AAAAMMGG.
+     */
+    uint32_t getBirthDate() const {
+        return static_cast<uint32_t>(year) * 10000 + month * 100 + day;
+    }
+};
+
+/**
+ * @brief Data odierna (ora locale) nel formato AAAAMMGG.
+ */
+uint32_t today();
+
+/**
+ * @brief Decodifica data di nascita, sesso ed eta' da un codice fiscale.
+ *
+ * Anno (posizioni 7-8), mese (lettera in posizione 9) e giorno (posizioni
+ * 10-11, +40 per le femmine) sono letti con tabelle constexpr indicizzate
+ * per simbolo, che gestiscono direttamente le lettere omocodiche. Il secolo
+ * e' il piu' recente che non colloca la nascita dopo la data di
+ * riferimento: un codice non distingue chi ha piu' di 100 anni.
+ *
+ * Non verifica il resto del codice ne' il CIN: usare prima
+ * isValidCodiceFiscale() se necessario.
+ *
+ * @param cf Puntatore a 16 caratteri
+ * @param referenceDate Data di riferimento per secolo ed eta' (AAAAMMGG)
+ * @return I dati decodificati, o std::nullopt se mese o giorno non sono
+ *         validi (es. 30 febbraio)
+ */
+std::optional<DecodedCF> decode(const wchar_t* cf, uint32_t referenceDate);
+std::optional<DecodedCF> decode(const std::wstring& cf, uint32_t referenceDate);
+
+/**
+ * @brief Come decode(), con la data odierna come riferimento.
+ */
+std::optional<DecodedCF> decode(const std::wstring& cf);
+
+/**
+ * @brief Decodifica un insieme di codici fiscali.
+ *
+ * Stesso esito di decode() per ogni record; i record non decodificabili
+ * hanno valid == false.
+ *
+ * @param records Record da 16 code unit ciascuno
+ * @param count Numero di record
+ * @param referenceDate Data di riferimento per secolo ed eta' (AAAAMMGG)
+ * @param results Array di almeno count elementi
+ */
+void decodeBatch(const char16_t (*records)[16], size_t count, uint32_t referenceDate,
+                 DecodedCF* results);
+
+} // namespace cfparser
+
+#endif // CF_DECODE_H
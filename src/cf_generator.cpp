@@ -0,0 +1,218 @@
+#include "cf_generator.h"
+#include "cf_matcher.h"
+#include <iterator>
+
+namespace cfparser {
+
+using matcher::symbolOf;
+
+// ============================================================================
+// Normalizzazione delle lettere
+// ============================================================================
+
+// Lettera base per U+00C0-U+00FF e U+0100-U+017F; '.' = da ignorare.
+// Le legature (AE, OE, IJ) sono ricondotte alla prima lettera.
+static constexpr char FOLD_LATIN1[] =
+    "AAAAAAACEEEEIIIIDNOOOOO.OUUUUY.S"
+    "AAAAAAACEEEEIIIIDNOOOOO.OUUUUY.Y";
+static constexpr char FOLD_LATIN_EXT_A[] =
+    "AAAAAACCCCCCCCDD" "DDEEEEEEEEEEGGGG" "GGGGHHHHIIIIIIII" "IIIIJJKKKLLLLLLL"
+    "LLLNNNNNNNNNOOOO" "OOOORRRRRRSSSSSS" "SSTTTTTTUUUUUUUU" "UUUUWWYYYZZZZZZS";
+
+static_assert(sizeof(FOLD_LATIN1) - 1 == 0x40, "Tabella Latin-1 incompleta");
+static_assert(sizeof(FOLD_LATIN_EXT_A) - 1 == 0x80, "Tabella Latin Extended-A incompleta");
+
+char foldLetter(char32_t c) {
+    const uint32_t u = static_cast<uint32_t>(c);
+    if (u >= 'A' && u <= 'Z') {
+        return static_cast<char>(u);
+    }
+    if (u >= 'a' && u <= 'z') {
+        return static_cast<char>(u - 'a' + 'A');
+    }
+    char folded = '.';
+    if (u >= 0xC0 && u <= 0xFF) {
+        folded = FOLD_LATIN1[u - 0xC0];
+    } else if (u >= 0x100 && u <= 0x17F) {
+        folded = FOLD_LATIN_EXT_A[u - 0x100];
+    }
+    return folded == '.' ? 0 : folded;
+}
+
+static constexpr matcher::CharSet VOWELS = matcher::charSet("AEIOU");
+
+char32_t decodeUtf8(std::string_view text, size_t& offset) {
+    const unsigned char lead = static_cast<unsigned char>(text[offset++]);
+    const size_t extra = lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : lead >= 0xC2 ? 1 : 0;
+    if (lead < 0x80 || lead > 0xF4 || extra == 0 || offset + extra > text.size()) {
+        return lead;
+    }
+    char32_t value = lead & (0x3F >> extra);
+    for (size_t k = 0; k < extra; k++) {
+        const unsigned char c = static_cast<unsigned char>(text[offset + k]);
+        if ((c & 0xC0) != 0x80) {
+            return lead;
+        }
+        value = (value << 6) | (c & 0x3F);
+    }
+    offset += extra;
+    return value;
+}
+
+/**
+ * @brief Calcola le tre lettere di cognome o nome.
+ *
+ * @param next Funzione che restituisce il prossimo carattere, 0 alla fine
+ * @param isName true per la regola del nome (1a, 3a e 4a consonante)
+ * @param out Tre caratteri di uscita
+ * @return false se il testo non contiene lettere
+ */
+template <typename Next, typename CharT>
+static bool encodeTriplet(Next next, bool isName, CharT* out) {
+    char consonants[4];
+    char vowels[3];
+    size_t consonantCount = 0;
+    size_t vowelCount = 0;
+
+    for (char32_t c = next(); c != 0; c = next()) {
+        const char letter = foldLetter(c);
+        if (letter == 0) {
+            continue;
+        }
+        if (matcher::contains(VOWELS, symbolOf(letter))) {
+            if (vowelCount < 3) {
+                vowels[vowelCount++] = letter;
+            }
+        } else if (consonantCount < 4) {
+            consonants[consonantCount++] = letter;
+        }
+    }
+
+    if (consonantCount + vowelCount == 0) {
+        return false;
+    }
+
+    if (isName && consonantCount >= 4) {
+        out[0] = consonants[0];
+        out[1] = consonants[2];
+        out[2] = consonants[3];
+        return true;
+    }
+
+    size_t n = 0;
+    for (size_t i = 0; i < consonantCount && n < 3; i++) {
+        out[n++] = consonants[i];
+    }
+    for (size_t i = 0; i < vowelCount && n < 3; i++) {
+        out[n++] = vowels[i];
+    }
+    while (n < 3) {
+        out[n++] = 'X';
+    }
+    return true;
+}
+
+static bool encodeTriplet(const wchar_t* text, bool isName, wchar_t* out) {
+    return encodeTriplet([&text]() -> char32_t { return *text != L'\0' ? *text++ : 0; }, isName, out);
+}
+
+static bool encodeTriplet(std::string_view text, bool isName, char* out) {
+    size_t offset = 0;
+    return encodeTriplet([&]() -> char32_t {
+        // Un byte nullo nel testo termina il nome, come per wchar_t
+        return offset < text.size() ? decodeUtf8(text, offset) : 0;
+    }, isName, out);
+}
+
+// ============================================================================
+// Data e codice catastale
+// ============================================================================
+
+static constexpr char MONTH_LETTERS[] = "ABCDEHLMPRST";
+static constexpr uint8_t DAYS_IN_MONTH[13] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+static constexpr int FEMALE_DAY_OFFSET = 40;
+
+static bool isValidDate(uint32_t year, uint32_t month, uint32_t day) {
+    if (month < 1 || month > 12 || day < 1) {
+        return false;
+    }
+    const bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return day <= DAYS_IN_MONTH[month] + ((leap && month == 2) ? 1u : 0u);
+}
+
+static void writeTwoDigits(wchar_t* out, uint32_t value) {
+    out[0] = static_cast<wchar_t>(L'0' + value / 10);
+    out[1] = static_cast<wchar_t>(L'0' + value % 10);
+}
+
+// ============================================================================
+// API pubblica
+// ============================================================================
+
+bool generateCodiceFiscale(const PersonData& person, wchar_t* out, int omocodiaLevel) {
+    if (person.surname == nullptr || person.name == nullptr || person.belfiore == nullptr) {
+        return false;
+    }
+    if (omocodiaLevel < 0 || omocodiaLevel > static_cast<int>(std::size(matcher::OMOCODIA_ORDER))) {
+        return false;
+    }
+
+    if (!encodeTriplet(person.surname, false, out) || !encodeTriplet(person.name, true, out + 3)) {
+        return false;
+    }
+
+    const uint32_t year = person.birthDate / 10000;
+    const uint32_t month = person.birthDate / 100 % 100;
+    const uint32_t day = person.birthDate % 100;
+    if (!isValidDate(year, month, day)) {
+        return false;
+    }
+    writeTwoDigits(out + 6, year % 100);
+    out[8] = static_cast<wchar_t>(MONTH_LETTERS[month - 1]);
+    writeTwoDigits(out + 9, day + (person.sex == Sex::Female ? FEMALE_DAY_OFFSET : 0));
+
+    // Codice catastale in forma normalizzata (cifre, non lettere omocodiche)
+    const wchar_t* belfiore = person.belfiore;
+    const uint8_t letter = symbolOf(belfiore[0]);
+    if (!matcher::contains(matcher::BELFIORE_AM | matcher::BELFIORE_Z, letter)) {
+        return false;
+    }
+    out[11] = static_cast<wchar_t>(L'A' + letter - 10);
+    int number = 0;
+    for (size_t i = 1; i < 4; i++) {
+        const int digit = matcher::digitValue(symbolOf(belfiore[i]));
+        if (digit < 0) {
+            return false;
+        }
+        out[11 + i] = static_cast<wchar_t>(L'0' + digit);
+        number = number * 10 + digit;
+    }
+    // Stessi vincoli della grammatica: A-M seguito da 001-999, Z da 100-999
+    if (number == 0 || (matcher::contains(matcher::BELFIORE_Z, letter) && number < 100)) {
+        return false;
+    }
+
+    for (int k = 0; k < omocodiaLevel; k++) {
+        const size_t pos = matcher::OMOCODIA_ORDER[k];
+        out[pos] = static_cast<wchar_t>(matcher::OMOCODIA_LETTERS[out[pos] - L'0']);
+    }
+
+    out[15] = static_cast<wchar_t>(matcher::calculateCIN(out));
+    return true;
+}
+
+bool encodeSurname(std::string_view surname, char* out) {
+    return encodeTriplet(surname, false, out);
+}
+
+bool encodeName(std::string_view name, char* out) {
+    return encodeTriplet(name, true, out);
+}
+
+void generateBatch(const PersonData* people, size_t count, wchar_t (*out)[16], uint8_t* results) {
+    for (size_t i = 0; i < count; i++) {
+        results[i] = generateCodiceFiscale(people[i], out[i]) ? 1 : 0;
+    }
+}
+
+} // namespace cfparser
@@ -0,0 +1,100 @@
+#ifndef CF_GENERATOR_H
+#define CF_GENERATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include "cf_decode.h"
+
+namespace cfparser {
+
+/**
+ * @brief Dati anagrafici da cui calcolare un codice fiscale.
+ */
+struct PersonData {
+    const wchar_t* surname;     ///< Cognome (terminato da zero)
+    const wchar_t* name;        ///< Nome (terminato da zero)
+    uint32_t birthDate;         ///< Data di nascita (AAAAMMGG)
+    Sex sex;                    ///< Sesso
+    const wchar_t* belfiore;    ///< Codice catastale del luogo di nascita (4 caratteri)
+};
+
+/**
+ * @brief Calcola il codice fiscale a partire dai dati anagrafici.
+ *
+ * Cognome e nome vengono ridotti alle lettere A-Z: le lettere accentate e
+ * con diacritici (Latin-1 e Latin Extended-A) sono ricondotte alla lettera
+ * base, mentre apostrofi, spazi, trattini e altri simboli sono ignorati.
+ * Per il cognome si usano le prime tre consonanti, poi le vocali, poi X;
+ * per il nome la prima, terza e quarta consonante se sono almeno quattro,
+ * altrimenti la stessa regola del cognome. Il CIN e' calcolato con le
+ * tabelle di matcher::calculateCIN(). Nessuna allocazione.
+ *
+ * Il codice segue le regole ufficiali anche nel caso raro che la grammatica
+ * di isValidCodiceFiscale() non accetta: cognome o nome di una sola vocale
+ * (es. "OXX").
+ *
+ * @param person Dati anagrafici
+ * @param out Buffer di 16 caratteri (senza terminatore)
+ * @param omocodiaLevel Numero di cifre da sostituire con lettere omocodiche
+ *        (0-7, da destra, come assegnato dall'Agenzia delle Entrate)
+ * @return true se il codice e' stato calcolato; false se i dati non sono
+ *         validi (cognome o nome senza lettere, data inesistente, codice
+ *         catastale non valido, livello fuori intervallo)
+ */
+bool generateCodiceFiscale(const PersonData& person, wchar_t* out, int omocodiaLevel = 0);
+
+/**
+ * @brief Lettera maiuscola A-Z corrispondente a un carattere, 0 se da ignorare.
+ *
+ * Stessa normalizzazione usata per cognome e nome: le lettere accentate e
+ * con diacritici (Latin-1 e Latin Extended-A) diventano la lettera base.
+ *
+ * @param c Code point Unicode
+ */
+char foldLetter(char32_t c);
+
+/**
+ * @brief Legge il prossimo code point di un testo UTF-8.
+ *
+ * I byte che non formano una sequenza UTF-8 valida sono letti come
+ * Latin-1 (molti export sono ancora in codifica ANSI).
+ *
+ * @param text Testo
+ * @param offset Posizione del code point (minore di text.size()),
+ *        aggiornata al successivo
+ */
+char32_t decodeUtf8(std::string_view text, size_t& offset);
+
+/**
+ * @brief Calcola le tre lettere del cognome, come generateCodiceFiscale().
+ *
+ * @param surname Cognome in UTF-8
+ * @param out Tre caratteri di uscita
+ * @return false se il cognome non contiene lettere
+ */
+bool encodeSurname(std::string_view surname, char* out);
+
+/**
+ * @brief Calcola le tre lettere del nome, come generateCodiceFiscale().
+ *
+ * @param name Nome in UTF-8
+ * @param out Tre caratteri di uscita
+ * @return false se il nome non contiene lettere
+ */
+bool encodeName(std::string_view name, char* out);
+
+/**
+ * @brief Calcola i codici fiscali di un insieme di persone.
+ *
+ * @param people Dati anagrafici
+ * @param count Numero di persone
+ * @param out Array di almeno count record da 16 caratteri
+ * @param results Array di almeno count elementi: 1 se il codice e' stato
+ *        calcolato, 0 altrimenti
+ */
+void generateBatch(const PersonData* people, size_t count, wchar_t (*out)[16], uint8_t* results);
+
+} // namespace cfparser
+
+#endif // CF_GENERATOR_H
@@ -0,0 +1,275 @@
+#include "cf_join.h"
+#include "cf_parser.h"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+namespace cfparser {
+
+/// Sotto queste dimensioni un solo thread e' piu' rapido
+static constexpr size_t MIN_PARALLEL_BYTES = 1 << 20;
+static constexpr size_t MIN_PARALLEL_CODES = 1 << 16;
+
+/// Cifre fino a 11 bit: l'istogramma di un thread (16 KB) sta in L1
+static constexpr int MAX_RADIX_BITS = 11;
+
+// ============================================================================
+// Thread
+// ============================================================================
+
+static unsigned resolveThreads(unsigned threads) {
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    return threads == 0 ? 1 : threads;
+}
+
+/**
+ * @brief Esegue fn(0) ... fn(threads - 1) in parallelo e attende la fine.
+ */
+template <typename Fn>
+static void runParallel(unsigned threads, const Fn& fn) {
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (unsigned t = 1; t < threads; t++) {
+        workers.emplace_back(fn, t);
+    }
+    fn(0u);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Inizio della porzione t di n elementi divisi tra threads thread.
+ */
+static size_t chunkBegin(size_t n, unsigned threads, unsigned t) {
+    return n / threads * t + std::min<size_t>(t, n % threads);
+}
+
+// ============================================================================
+// Lettura
+// ============================================================================
+
+static bool isBlank(std::string_view line) {
+    for (char c : line) {
+        if (c != ' ' && c != '\t' && c != '\r') {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Legge i codici delle righe contenute in text (righe intere).
+ */
+static void parseLines(std::string_view text, std::vector<PackedCF>& out, size_t& rejected) {
+    size_t start = 0;
+    while (start < text.size()) {
+        const char* newline = static_cast<const char*>(
+            std::memchr(text.data() + start, '\n', text.size() - start));
+        const size_t end = newline != nullptr ? static_cast<size_t>(newline - text.data()) : text.size();
+        const std::string_view line = text.substr(start, end - start);
+        start = end + 1;
+
+        if (isBlank(line)) {
+            continue;
+        }
+        const size_t pos = findCodiceFiscale(line, 0);
+        auto packed = pos != std::string_view::npos ? PackedCF::pack(line.data() + pos) : std::nullopt;
+        if (packed.has_value()) {
+            out.push_back(*packed);
+        } else {
+            rejected++;
+        }
+    }
+}
+
+std::vector<PackedCF> parseCodeList(std::string_view text, unsigned threads, size_t* rejected) {
+    threads = text.size() < MIN_PARALLEL_BYTES ? 1 : resolveThreads(threads);
+
+    // Confini dei blocchi: ciascuno inizia dopo un fine riga
+    std::vector<size_t> bounds(threads + 1, text.size());
+    bounds[0] = 0;
+    for (unsigned t = 1; t < threads; t++) {
+        const size_t approx = std::max(chunkBegin(text.size(), threads, t), bounds[t - 1]);
+        const size_t newline = text.find('\n', approx);
+        bounds[t] = newline == std::string_view::npos ? text.size() : newline + 1;
+    }
+
+    std::vector<std::vector<PackedCF>> parts(threads);
+    std::vector<size_t> rejectedParts(threads, 0);
+    runParallel(threads, [&](unsigned t) {
+        const std::string_view part = text.substr(bounds[t], bounds[t + 1] - bounds[t]);
+        parts[t].reserve(part.size() / 17);
+        parseLines(part, parts[t], rejectedParts[t]);
+    });
+
+    size_t total = 0;
+    size_t totalRejected = 0;
+    for (unsigned t = 0; t < threads; t++) {
+        total += parts[t].size();
+        totalRejected += rejectedParts[t];
+    }
+    if (rejected != nullptr) {
+        *rejected = totalRejected;
+    }
+
+    std::vector<PackedCF> codes = std::move(parts[0]);
+    codes.reserve(total);
+    for (unsigned t = 1; t < threads; t++) {
+        codes.insert(codes.end(), parts[t].begin(), parts[t].end());
+    }
+    return codes;
+}
+
+// ============================================================================
+// Ordinamento
+// ============================================================================
+
+void sortCodes(std::vector<PackedCF>& codes, unsigned threads) {
+    const size_t n = codes.size();
+    if (n < 2) {
+        return;
+    }
+    threads = n < MIN_PARALLEL_CODES ? 1 : resolveThreads(threads);
+
+    // Bit che variano tra i codici: solo quelli vanno ordinati (per i codici
+    // canonici i 3 bit bassi sono nulli e i 5 alti inutilizzati: 56 bit)
+    std::vector<uint64_t> orParts(threads, 0);
+    std::vector<uint64_t> andParts(threads, ~uint64_t(0));
+    runParallel(threads, [&](unsigned t) {
+        uint64_t orBits = 0;
+        uint64_t andBits = ~uint64_t(0);
+        const size_t end = chunkBegin(n, threads, t + 1);
+        for (size_t i = chunkBegin(n, threads, t); i < end; i++) {
+            orBits |= codes[i].getValue();
+            andBits &= codes[i].getValue();
+        }
+        orParts[t] = orBits;
+        andParts[t] = andBits;
+    });
+    uint64_t varying = 0;
+    for (unsigned t = 0; t < threads; t++) {
+        varying |= orParts[t] ^ andParts[t];
+    }
+    if (varying == 0) {
+        return;
+    }
+
+    int low = 0;
+    while (((varying >> low) & 1) == 0) {
+        low++;
+    }
+    int high = 64;
+    while (((varying >> (high - 1)) & 1) == 0) {
+        high--;
+    }
+    const int span = high - low;
+    const int passes = (span + MAX_RADIX_BITS - 1) / MAX_RADIX_BITS;
+    const int bits = (span + passes - 1) / passes;
+    const size_t buckets = size_t(1) << bits;
+    const uint64_t mask = buckets - 1;
+
+    std::vector<PackedCF> buffer(n);
+    std::vector<size_t> offsets(size_t(threads) * buckets);
+    PackedCF* source = codes.data();
+    PackedCF* target = buffer.data();
+
+    for (int pass = 0; pass < passes; pass++) {
+        const int shift = low + pass * bits;
+
+        // Conteggio della porzione di ogni thread
+        runParallel(threads, [&](unsigned t) {
+            size_t* counts = &offsets[size_t(t) * buckets];
+            std::fill(counts, counts + buckets, 0);
+            const size_t end = chunkBegin(n, threads, t + 1);
+            for (size_t i = chunkBegin(n, threads, t); i < end; i++) {
+                counts[(source[i].getValue() >> shift) & mask]++;
+            }
+        });
+
+        // Posizione di partenza di ogni (cifra, thread): stabile perche' le
+        // porzioni dei thread sono in ordine
+        size_t position = 0;
+        for (size_t digit = 0; digit < buckets; digit++) {
+            for (unsigned t = 0; t < threads; t++) {
+                size_t& offset = offsets[size_t(t) * buckets + digit];
+                const size_t count = offset;
+                offset = position;
+                position += count;
+            }
+        }
+
+        runParallel(threads, [&](unsigned t) {
+            size_t* next = &offsets[size_t(t) * buckets];
+            const size_t end = chunkBegin(n, threads, t + 1);
+            for (size_t i = chunkBegin(n, threads, t); i < end; i++) {
+                target[next[(source[i].getValue() >> shift) & mask]++] = source[i];
+            }
+        });
+
+        std::swap(source, target);
+    }
+
+    if (source != codes.data()) {
+        codes.swap(buffer);
+    }
+}
+
+// ============================================================================
+// Confronto
+// ============================================================================
+
+/**
+ * @brief Toglie le ripetizioni da un elenco ordinato, annotando i duplicati.
+ */
+static void splitDuplicates(std::vector<PackedCF>& sorted, std::vector<PackedCF>& duplicates) {
+    size_t unique = 0;
+    for (size_t i = 0; i < sorted.size();) {
+        size_t j = i + 1;
+        while (j < sorted.size() && sorted[j] == sorted[i]) {
+            j++;
+        }
+        if (j - i > 1) {
+            duplicates.push_back(sorted[i]);
+        }
+        sorted[unique++] = sorted[i];
+        i = j;
+    }
+    sorted.resize(unique);
+}
+
+JoinResult joinCodeLists(std::vector<PackedCF> left, std::vector<PackedCF> right, unsigned threads) {
+    for (PackedCF& cf : left) {
+        cf = cf.getCanonical();
+    }
+    for (PackedCF& cf : right) {
+        cf = cf.getCanonical();
+    }
+    sortCodes(left, threads);
+    sortCodes(right, threads);
+
+    JoinResult result;
+    splitDuplicates(left, result.leftDuplicates);
+    splitDuplicates(right, result.rightDuplicates);
+
+    size_t i = 0;
+    size_t j = 0;
+    while (i < left.size() && j < right.size()) {
+        if (left[i] < right[j]) {
+            result.leftOnly.push_back(left[i++]);
+        } else if (right[j] < left[i]) {
+            result.rightOnly.push_back(right[j++]);
+        } else {
+            result.both.push_back(left[i]);
+            i++;
+            j++;
+        }
+    }
+    result.leftOnly.insert(result.leftOnly.end(), left.begin() + i, left.end());
+    result.rightOnly.insert(result.rightOnly.end(), right.begin() + j, right.end());
+    return result;
+}
+
+} // namespace cfparser
@@ -0,0 +1,72 @@
+#ifndef CF_JOIN_H
+#define CF_JOIN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "packed_cf.h"
+
+namespace cfparser {
+
+/**
+ * @brief Esito del confronto tra due elenchi di codici fiscali.
+ *
+ * Tutti i codici sono canonici (senza omocodia) e ogni insieme e' ordinato
+ * e senza ripetizioni.
+ */
+struct JoinResult {
+    std::vector<PackedCF> both;             ///< Presenti in entrambi gli elenchi
+    std::vector<PackedCF> leftOnly;         ///< Solo nell'elenco di sinistra
+    std::vector<PackedCF> rightOnly;        ///< Solo nell'elenco di destra
+    std::vector<PackedCF> leftDuplicates;   ///< Ripetuti nell'elenco di sinistra
+    std::vector<PackedCF> rightDuplicates;  ///< Ripetuti nell'elenco di destra
+};
+
+/**
+ * @brief Legge un elenco di codici fiscali, uno per riga.
+ *
+ * Di ogni riga viene preso il primo codice (puo' essere circondato da altro
+ * testo, es. una riga CSV) se valido, CIN compreso. Il testo viene diviso
+ * in blocchi di righe elaborati in parallelo; l'ordine delle righe e'
+ * mantenuto.
+ *
+ * @param text Testo UTF-8 (es. un file mappato in memoria)
+ * @param threads Numero di thread (0 = tutti i core)
+ * @param rejected Output opzionale: righe non vuote senza un codice valido
+ * @return I codici, nell'ordine del testo
+ */
+std::vector<PackedCF> parseCodeList(std::string_view text, unsigned threads = 0,
+                                    size_t* rejected = nullptr);
+
+/**
+ * @brief Ordina un elenco di codici (radix sort LSD parallelo).
+ *
+ * Ordina solo i bit che variano tra i codici, in cifre fino a 11 bit: per
+ * i codici canonici sono 56 bit, cioe' 6 passate da 10 bit. Ogni thread
+ * conta e distribuisce la propria porzione; l'ordine e' stabile. Usa un
+ * buffer temporaneo grande quanto l'elenco.
+ *
+ * @param codes Codici da ordinare
+ * @param threads Numero di thread (0 = tutti i core)
+ */
+void sortCodes(std::vector<PackedCF>& codes, unsigned threads = 0);
+
+/**
+ * @brief Confronta due elenchi: intersezione, differenze e duplicati.
+ *
+ * I codici vengono ridotti alla forma canonica, quindi le varianti
+ * omocodiche di una stessa persona coincidono (e nello stesso elenco
+ * contano come duplicati). Dopo l'ordinamento il confronto e' un'unica
+ * fusione lineare.
+ *
+ * @param left Elenco di sinistra
+ * @param right Elenco di destra
+ * @param threads Numero di thread per l'ordinamento (0 = tutti i core)
+ */
+JoinResult joinCodeLists(std::vector<PackedCF> left, std::vector<PackedCF> right,
+                         unsigned threads = 0);
+
+} // namespace cfparser
+
+#endif // CF_JOIN_H
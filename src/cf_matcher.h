@@ -0,0 +1,449 @@
+#ifndef CF_MATCHER_H
+#define CF_MATCHER_H
+
+/**
+ * @file cf_matcher.h
+ * @brief Riconoscitore del codice fiscale valutabile a tempo di compilazione.
+ *
+ * La grammatica del codice fiscale e' espressa con insiemi di caratteri
+ * (bitset constexpr) e con un automa a stati finiti la cui tabella delle
+ * transizioni e' calcolata dal compilatore. Tutte le funzioni sono constexpr
+ * e header-only: il compilatore le espande nel chiamante e non c'e' alcuna
+ * inizializzazione da eseguire all'avvio del processo.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace cfparser {
+namespace matcher {
+
+// ============================================================================
+// Simboli e insiemi di caratteri
+// ============================================================================
+
+/// Numero di simboli: 0-9 cifre, 10-35 lettere A-Z, 36 qualsiasi altro carattere
+constexpr int SYMBOL_COUNT = 37;
+constexpr uint8_t SYMBOL_OTHER = 36;
+
+/// Lunghezza del codice fiscale
+constexpr size_t CF_LENGTH = 16;
+
+/**
+ * @brief Converte un carattere nel simbolo dell'automa (case-insensitive).
+ */
+template <typename CharT>
+constexpr uint8_t symbolOf(CharT c) {
+    const uint32_t u = static_cast<uint32_t>(static_cast<std::make_unsigned_t<CharT>>(c));
+    if (u >= '0' && u <= '9') {
+        return static_cast<uint8_t>(u - '0');
+    }
+    if (u >= 'A' && u <= 'Z') {
+        return static_cast<uint8_t>(u - 'A' + 10);
+    }
+    if (u >= 'a' && u <= 'z') {
+        return static_cast<uint8_t>(u - 'a' + 10);
+    }
+    return SYMBOL_OTHER;
+}
+
+/// Insieme di simboli: il bit i vale 1 se il simbolo i appartiene all'insieme
+using CharSet = uint64_t;
+
+constexpr CharSet charSet(const char* chars) {
+    CharSet set = 0;
+    for (; *chars; ++chars) {
+        set |= CharSet(1) << symbolOf(*chars);
+    }
+    return set;
+}
+
+constexpr bool contains(CharSet set, uint8_t symbol) {
+    return ((set >> symbol) & 1) != 0;
+}
+
+// Classi di caratteri usate dalla grammatica
+constexpr CharSet VOWELS       = charSet("AEIOU");
+constexpr CharSet VOWELS_X     = charSet("AEIOUX");
+constexpr CharSet CONSONANTS   = charSet("BCDFGHJKLMNPQRSTVWXYZ");
+constexpr CharSet LETTERS      = VOWELS | CONSONANTS;
+constexpr CharSet DIGIT        = charSet("0123456789LMNPQRSTUV");  // cifra o omocodia
+constexpr CharSet DIGIT_NZ     = charSet("123456789MNPQRSTUV");    // cifra diversa da 0
+constexpr CharSet DIGIT_0      = charSet("0L");
+constexpr CharSet MONTHS       = charSet("ABCDEHLMPRST");
+constexpr CharSet MONTHS_30    = charSet("DHPS");
+constexpr CharSet MONTHS_31    = charSet("ACELMRT");
+constexpr CharSet DAY_TENS_NZ  = charSet("04LQ");       // 0x, 4x: unita' diversa da 0
+constexpr CharSet DAY_TENS_ANY = charSet("1256MNRS");   // 1x, 2x, 5x, 6x
+constexpr CharSet DAY_TENS_3   = charSet("37PT");       // 30, 31, 70, 71
+constexpr CharSet DAY_UNITS_01 = charSet("01LM");
+constexpr CharSet BELFIORE_AM  = charSet("ABCDEFGHIJKLM");
+constexpr CharSet BELFIORE_Z   = charSet("Z");
+
+/**
+ * @brief Caratteri ammessi in ciascuna posizione, indipendentemente dalle altre.
+ *
+ * Condizione necessaria ma non sufficiente: i vincoli tra posizioni (terne,
+ * giorno/mese, codice catastale) sono verificati dall'automa.
+ */
+constexpr CharSet POSITION_CLASSES[CF_LENGTH] = {
+    LETTERS, LETTERS, LETTERS,              // cognome
+    LETTERS, LETTERS, LETTERS,              // nome
+    DIGIT, DIGIT,                           // anno
+    MONTHS,                                 // mese
+    DAY_TENS_NZ | DAY_TENS_ANY | DAY_TENS_3, DIGIT,  // giorno
+    BELFIORE_AM | BELFIORE_Z, DIGIT, DIGIT, DIGIT,   // codice catastale
+    LETTERS                                 // carattere di controllo
+};
+
+// ============================================================================
+// Omocodia
+// ============================================================================
+
+/// Posizioni che possono contenere lettere omocodiche, nell'ordine di
+/// sostituzione previsto (dalla cifra piu' a destra verso sinistra)
+inline constexpr size_t OMOCODIA_ORDER[7] = {14, 13, 12, 10, 9, 7, 6};
+
+/// OMOCODIA_LETTERS[d] sostituisce la cifra d
+inline constexpr char OMOCODIA_LETTERS[] = "LMNPQRSTUV";
+
+/**
+ * @brief Valore di un simbolo in una posizione numerica (0-9), -1 se non ammesso.
+ *
+ * Le lettere omocodiche valgono la cifra che sostituiscono.
+ */
+constexpr int digitValue(uint8_t symbol) {
+    if (symbol < 10) {
+        return symbol;
+    }
+    for (int d = 0; d < 10; d++) {
+        if (symbol == symbolOf(OMOCODIA_LETTERS[d])) {
+            return d;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Livello di omocodia: numero di posizioni numeriche sostituite da lettere.
+ *
+ * Le sostituzioni seguono OMOCODIA_ORDER: una lettera a sinistra di una
+ * cifra rimasta non e' un omocodice legale.
+ *
+ * @param cf Puntatore a 16 caratteri (posizioni numeriche gia' verificate)
+ * @return Il livello (0-7), -1 se le sostituzioni non seguono l'ordine previsto
+ */
+template <typename CharT>
+constexpr int omocodiaLevel(const CharT* cf) {
+    int level = 0;
+    bool digitSeen = false;
+    for (size_t pos : OMOCODIA_ORDER) {
+        if (symbolOf(cf[pos]) >= 10) {
+            if (digitSeen) {
+                return -1;
+            }
+            level++;
+        } else {
+            digitSeen = true;
+        }
+    }
+    return level;
+}
+
+// ============================================================================
+// Automa a stati finiti
+// ============================================================================
+//
+// L'automa riconosce la grammatica (case-insensitive, supporta omocodia):
+//
+//   (?:(?:[B-DF-HJ-NP-TV-Z]|[AEIOU])[AEIOU][AEIOUX]|[B-DF-HJ-NP-TV-Z]{2}[A-Z]){2}
+//   [\dLMNP-V]{2}
+//   (?:[A-EHLMPR-T](?:[04LQ][1-9MNP-V]|[1256MNRS][\dLMNP-V])|[DHPS][37PT][0L]|[ACELMRT][37PT][01LM])
+//   (?:[A-MZ][1-9MNP-V][\dLMNP-V]{2}|[A-M][0L](?:[1-9MNP-V][\dLMNP-V]|[0L][1-9MNP-V]))
+//   [A-Z]
+//
+// Tutte le alternative hanno lunghezza 16, quindi ogni stato corrisponde a
+// una sola posizione nel codice.
+
+/**
+ * @brief Stati dell'automa (uno per posizione e alternativa della grammatica).
+ */
+enum DfaState : uint8_t {
+    S_DEAD = 0,
+    // Cognome (0-2) e nome (3-5): terne consonanti/vocali
+    S_SURNAME, S_SURNAME_V, S_SURNAME_C, S_SURNAME_VX, S_SURNAME_ANY,
+    S_NAME, S_NAME_V, S_NAME_C, S_NAME_VX, S_NAME_ANY,
+    // Anno (6-7) e mese (8)
+    S_YEAR_1, S_YEAR_2, S_MONTH,
+    // Giorno (9-10): dipende dalla lunghezza del mese
+    S_DAY_FEB, S_DAY_30, S_DAY_31,
+    S_DAY_NZ, S_DAY_ANY, S_DAY_0, S_DAY_01,
+    // Codice catastale (11-14)
+    S_BEL, S_BEL_AM, S_BEL_Z, S_BEL_ANY2, S_BEL_ANY1, S_BEL_ZERO, S_BEL_NZ,
+    // Carattere di controllo (15)
+    S_CIN, S_ACCEPT,
+    DFA_STATE_COUNT
+};
+
+struct DfaTable {
+    uint8_t next[DFA_STATE_COUNT][SYMBOL_COUNT];
+};
+
+namespace detail {
+
+constexpr void addEdges(DfaTable& t, DfaState from, CharSet set, DfaState to) {
+    for (uint8_t s = 0; s < SYMBOL_COUNT; s++) {
+        if (contains(set, s)) {
+            t.next[from][s] = to;
+        }
+    }
+}
+
+/**
+ * @brief Aggiunge le transizioni di una terna cognome/nome.
+ *
+ * (?:[cons]|[voc])[voc][voc X] | [cons]{2}[A-Z]
+ */
+constexpr void addTriplet(DfaTable& t, DfaState first, DfaState afterV,
+                          DfaState afterC, DfaState needVX, DfaState needAny,
+                          DfaState done) {
+    addEdges(t, first, VOWELS, afterV);
+    addEdges(t, first, CONSONANTS, afterC);
+    addEdges(t, afterV, VOWELS, needVX);
+    addEdges(t, afterC, VOWELS, needVX);
+    addEdges(t, afterC, CONSONANTS, needAny);
+    addEdges(t, needVX, VOWELS_X, done);
+    addEdges(t, needAny, LETTERS, done);
+}
+
+constexpr DfaTable buildDfa() {
+    DfaTable t{};
+
+    addTriplet(t, S_SURNAME, S_SURNAME_V, S_SURNAME_C, S_SURNAME_VX, S_SURNAME_ANY, S_NAME);
+    addTriplet(t, S_NAME, S_NAME_V, S_NAME_C, S_NAME_VX, S_NAME_ANY, S_YEAR_1);
+
+    addEdges(t, S_YEAR_1, DIGIT, S_YEAR_2);
+    addEdges(t, S_YEAR_2, DIGIT, S_MONTH);
+
+    // Mesi: B (28/29 giorni), DHPS (30 giorni), ACELMRT (31 giorni)
+    addEdges(t, S_MONTH, charSet("B"), S_DAY_FEB);
+    addEdges(t, S_MONTH, MONTHS_30, S_DAY_30);
+    addEdges(t, S_MONTH, MONTHS_31, S_DAY_31);
+
+    // Giorni 01-29 / 41-69: [04LQ][1-9MNP-V] | [1256MNRS][\dLMNP-V]
+    const DfaState dayStates[] = { S_DAY_FEB, S_DAY_30, S_DAY_31 };
+    for (DfaState s : dayStates) {
+        addEdges(t, s, DAY_TENS_NZ, S_DAY_NZ);
+        addEdges(t, s, DAY_TENS_ANY, S_DAY_ANY);
+    }
+    // Giorni 30 / 70 e 30, 31 / 70, 71
+    addEdges(t, S_DAY_30, DAY_TENS_3, S_DAY_0);
+    addEdges(t, S_DAY_31, DAY_TENS_3, S_DAY_01);
+
+    addEdges(t, S_DAY_NZ, DIGIT_NZ, S_BEL);
+    addEdges(t, S_DAY_ANY, DIGIT, S_BEL);
+    addEdges(t, S_DAY_0, DIGIT_0, S_BEL);
+    addEdges(t, S_DAY_01, DAY_UNITS_01, S_BEL);
+
+    // Codice catastale:
+    // [A-MZ][1-9MNP-V][\dLMNP-V]{2} | [A-M][0L](?:[1-9MNP-V][\dLMNP-V]|[0L][1-9MNP-V])
+    addEdges(t, S_BEL, BELFIORE_AM, S_BEL_AM);
+    addEdges(t, S_BEL, BELFIORE_Z, S_BEL_Z);
+    addEdges(t, S_BEL_AM, DIGIT_NZ, S_BEL_ANY2);
+    addEdges(t, S_BEL_AM, DIGIT_0, S_BEL_ZERO);
+    addEdges(t, S_BEL_Z, DIGIT_NZ, S_BEL_ANY2);
+    addEdges(t, S_BEL_ANY2, DIGIT, S_BEL_ANY1);
+    addEdges(t, S_BEL_ANY1, DIGIT, S_CIN);
+    addEdges(t, S_BEL_ZERO, DIGIT_NZ, S_BEL_ANY1);
+    addEdges(t, S_BEL_ZERO, DIGIT_0, S_BEL_NZ);
+    addEdges(t, S_BEL_NZ, DIGIT_NZ, S_CIN);
+
+    addEdges(t, S_CIN, LETTERS, S_ACCEPT);
+
+    return t;
+}
+
+} // namespace detail
+
+/// Tabella delle transizioni, calcolata dal compilatore
+inline constexpr DfaTable CF_DFA = detail::buildDfa();
+
+// ============================================================================
+// Carattere di controllo (CIN)
+// ============================================================================
+
+/// Valori per le posizioni dispari (1, 3, 5, ... in base 1), indicizzati per simbolo
+inline constexpr uint8_t CIN_ODD_VALUES[SYMBOL_COUNT] = {
+    1,  0,  5, 7, 9, 13, 15, 17, 19, 21,   // 0-9
+    1,  0,  5, 7, 9, 13, 15, 17, 19, 21,   // A-J
+    2,  4, 18, 20, 11,  3,  6,  8, 12, 14, // K-T
+    16, 10, 22, 25, 24, 23,                // U-Z
+    1                                      // altro (come '0')
+};
+
+/// Valori per le posizioni pari (2, 4, 6, ... in base 1), indicizzati per simbolo
+inline constexpr uint8_t CIN_EVEN_VALUES[SYMBOL_COUNT] = {
+    0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  // 0-9
+    0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  // A-J
+    10, 11, 12, 13, 14, 15, 16, 17, 18, 19, // K-T
+    20, 21, 22, 23, 24, 25,                 // U-Z
+    0                                       // altro (come '0')
+};
+
+/**
+ * @brief Valore CIN di un simbolo nella posizione indicata (0-based).
+ */
+constexpr int cinValue(size_t position, uint8_t symbol) {
+    return (position % 2 == 0) ? CIN_ODD_VALUES[symbol] : CIN_EVEN_VALUES[symbol];
+}
+
+/**
+ * @brief Calcola il carattere di controllo dai primi 15 caratteri.
+ *
+ * @param cf Puntatore ad almeno 15 caratteri
+ * @return Il carattere di controllo ('A'-'Z')
+ */
+template <typename CharT>
+constexpr char calculateCIN(const CharT* cf) {
+    int sum = 0;
+    for (size_t i = 0; i < CF_LENGTH - 1; i++) {
+        sum += cinValue(i, symbolOf(cf[i]));
+    }
+    return static_cast<char>('A' + sum % 26);
+}
+
+/**
+ * @brief Verifica il carattere di controllo di un codice di 16 caratteri.
+ */
+template <typename CharT>
+constexpr bool verifyCIN(const CharT* cf) {
+    return symbolOf(cf[CF_LENGTH - 1]) == symbolOf(calculateCIN(cf));
+}
+
+// ============================================================================
+// Verifica della struttura
+// ============================================================================
+
+namespace detail {
+
+template <typename CharT, size_t... I>
+constexpr bool positionsMatch(const CharT* p, std::index_sequence<I...>) {
+    return (contains(POSITION_CLASSES[I], symbolOf(p[I])) && ...);
+}
+
+template <typename CharT, size_t... I>
+constexpr uint8_t runDfa(const CharT* p, std::index_sequence<I...>) {
+    uint8_t state = S_SURNAME;
+    ((state = CF_DFA.next[state][symbolOf(p[I])]), ...);
+    return state;
+}
+
+} // namespace detail
+
+/**
+ * @brief Verifica se i 16 caratteri a partire da p rispettano la grammatica.
+ *
+ * Il controllo per posizione (srotolato dal template) scarta rapidamente i
+ * candidati non validi; l'automa verifica poi i vincoli tra posizioni.
+ */
+template <typename CharT>
+constexpr bool matchesAt(const CharT* p) {
+    using Positions = std::make_index_sequence<CF_LENGTH>;
+    return detail::positionsMatch(p, Positions{}) &&
+           detail::runDfa(p, Positions{}) == S_ACCEPT;
+}
+
+/**
+ * @brief Verifica se una stringa e' un codice fiscale valido (struttura e CIN).
+ *
+ * @param cf Puntatore ai caratteri
+ * @param length Numero di caratteri
+ */
+template <typename CharT>
+constexpr bool isValidCodiceFiscale(const CharT* cf, size_t length) {
+    return length == CF_LENGTH && matchesAt(cf) && verifyCIN(cf);
+}
+
+/**
+ * @brief Overload per letterali stringa (es. isValidCodiceFiscale(u"...")).
+ */
+template <typename CharT, size_t N>
+constexpr bool isValidCodiceFiscale(const CharT (&cf)[N]) {
+    return isValidCodiceFiscale(cf, N - 1);
+}
+
+// ============================================================================
+// Esito dettagliato
+// ============================================================================
+
+/**
+ * @brief Esito della verifica: Valid oppure il primo campo non valido.
+ */
+enum class Reason : uint8_t {
+    Valid = 0,
+    InvalidLength,      ///< Lunghezza diversa da 16
+    InvalidCharacter,   ///< Carattere non alfanumerico ASCII
+    InvalidSurname,     ///< Posizioni 0-2
+    InvalidName,        ///< Posizioni 3-5
+    InvalidYear,        ///< Posizioni 6-7
+    InvalidMonth,       ///< Posizione 8
+    InvalidDay,         ///< Posizioni 9-10
+    InvalidBelfiore,    ///< Posizioni 11-14
+    InvalidCIN          ///< Posizione 15 o carattere di controllo errato
+};
+
+/// Campo a cui appartiene ciascuna posizione
+inline constexpr Reason POSITION_REASON[CF_LENGTH] = {
+    Reason::InvalidSurname, Reason::InvalidSurname, Reason::InvalidSurname,
+    Reason::InvalidName, Reason::InvalidName, Reason::InvalidName,
+    Reason::InvalidYear, Reason::InvalidYear,
+    Reason::InvalidMonth,
+    Reason::InvalidDay, Reason::InvalidDay,
+    Reason::InvalidBelfiore, Reason::InvalidBelfiore,
+    Reason::InvalidBelfiore, Reason::InvalidBelfiore,
+    Reason::InvalidCIN
+};
+
+/**
+ * @brief Verifica 16 caratteri e restituisce il motivo dell'eventuale errore.
+ *
+ * Poiche' ogni campo dipende solo da se' stesso e dai campi precedenti, la
+ * posizione in cui l'automa si blocca identifica il primo campo non valido.
+ */
+template <typename CharT>
+constexpr Reason validate(const CharT* cf) {
+    for (size_t i = 0; i < CF_LENGTH; i++) {
+        if (symbolOf(cf[i]) == SYMBOL_OTHER) {
+            return Reason::InvalidCharacter;
+        }
+    }
+
+    uint8_t state = S_SURNAME;
+    for (size_t i = 0; i < CF_LENGTH; i++) {
+        state = CF_DFA.next[state][symbolOf(cf[i])];
+        if (state == S_DEAD) {
+            return POSITION_REASON[i];
+        }
+    }
+
+    return verifyCIN(cf) ? Reason::Valid : Reason::InvalidCIN;
+}
+
+// Codici noti, verificati dal compilatore
+static_assert(isValidCodiceFiscale("RSSMRA85T10A562S"), "CF di esempio");
+static_assert(isValidCodiceFiscale(u"rssmra85t10a562s"), "CF in minuscolo");
+static_assert(isValidCodiceFiscale(L"RSSMRA85T10A56NH"), "CF con omocodia");
+static_assert(isValidCodiceFiscale(U"VRDLRA80A41H501T"), "CF femminile");
+static_assert(isValidCodiceFiscale("RSSMRA85TN0A562E"), "omocodia sulle decine del giorno");
+static_assert(!isValidCodiceFiscale("RSSMRA85T10A562T"), "CIN errato");
+static_assert(!isValidCodiceFiscale("RSSMRA85B30A562S"), "30 febbraio");
+static_assert(!isValidCodiceFiscale("RSSMRA85T10A562"), "lunghezza errata");
+static_assert(validate("RSSMRA85B30A562S") == Reason::InvalidDay, "30 febbraio");
+static_assert(validate("RSSMRA85T10Z062S") == Reason::InvalidBelfiore, "Z0xx");
+
+} // namespace matcher
+} // namespace cfparser
+
+#endif // CF_MATCHER_H
@@ -1,162 +1,330 @@
 #include "cf_parser.h"
-#include <regex>
+#include "cf_matcher.h"
+#include "cf_simd.h"
 #include <algorithm>
-#include <cctype>
+#include <cstdint>
+#include <type_traits>
 
 namespace cfparser {
 
-// Regex completa per codice fiscale italiano (supporta omocodia)
-// Pattern fornito che gestisce tutte le varianti valide del CF
-static const std::wregex CF_REGEX(
-    L"(?:(?:[B-DF-HJ-NP-TV-Z]|[AEIOU])[AEIOU][AEIOUX]|[B-DF-HJ-NP-TV-Z]{2}[A-Z]){2}"
-    L"[\\dLMNP-V]{2}"
-    L"(?:[A-EHLMPR-T](?:[04LQ][1-9MNP-V]|[1256LMRS][\\dLMNP-V])|[DHPS][37PT][0L]|[ACELMRT][37PT][01LM])"
-    L"(?:[A-MZ][1-9MNP-V][\\dLMNP-V]{2}|[A-M][0L](?:[1-9MNP-V][\\dLMNP-V]|[0L][1-9MNP-V]))"
-    L"[A-Z]",
-    std::regex_constants::icase
-);
-
-// Tabella conversione caratteri omocodici -> cifre
-static const wchar_t OMOCODIA_CHARS[] = L"LMNPQRSTUV";
-static const wchar_t OMOCODIA_DIGITS[] = L"0123456789";
-
-// Tabella valori per calcolo CIN - caratteri dispari (posizioni 1,3,5,7,9,11,13,15)
-static const int CIN_ODD_VALUES[] = {
-    1,  0,  5, 7, 9, 13, 15, 17, 19, 21,  // 0-9
-    1,  0,  5, 7, 9, 13, 15, 17, 19, 21,  // A-J (A=0, B=1, ...)
-    2,  4, 18, 20, 11,  3,  6,  8, 12, 14, // K-T
-    16, 10, 22, 25, 24, 23                 // U-Z
-};
+using matcher::CF_DFA;
+using matcher::symbolOf;
 
-// Tabella valori per calcolo CIN - caratteri pari (posizioni 2,4,6,8,10,12,14)
-static const int CIN_EVEN_VALUES[] = {
-    0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  // 0-9
-    0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  // A-J
-    10, 11, 12, 13, 14, 15, 16, 17, 18, 19, // K-T
-    20, 21, 22, 23, 24, 25                  // U-Z
-};
+// Sotto questa lunghezza (es. titoli di finestra) il prefiltro non conviene
+static constexpr size_t PREFILTER_MIN_LENGTH = 128;
+
+static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
 
 /**
- * @brief Converte un carattere in indice per le tabelle CIN
+ * @brief Cerca il primo codice fiscale nel testo con una sola passata.
+ *
+ * Simula in parallelo tutti i tentativi di match ancora vivi: poiche' ogni
+ * stato corrisponde a una posizione diversa, i tentativi attivi sono al
+ * massimo 16. Il primo che raggiunge S_ACCEPT e' il match piu' a sinistra.
+ *
+ * @return L'offset di inizio del match, o NOT_FOUND se non trovato
  */
-static int charToIndex(wchar_t c) {
-    c = towupper(c);
-    if (c >= L'0' && c <= L'9') {
-        return c - L'0';
-    } else if (c >= L'A' && c <= L'Z') {
-        return c - L'A' + 10;
+template <typename CharT>
+static size_t scanCodiceFiscale(const CharT* text, size_t length) {
+    uint8_t active[16];
+    int count = 0;
+
+    for (size_t i = 0; i < length; i++) {
+        const uint8_t symbol = symbolOf(text[i]);
+
+        // Nuovo tentativo che inizia in questa posizione
+        active[count++] = matcher::S_SURNAME;
+
+        int alive = 0;
+        for (int k = 0; k < count; k++) {
+            const uint8_t next = CF_DFA.next[active[k]][symbol];
+            if (next == matcher::S_ACCEPT) {
+                return i + 1 - 16;
+            }
+            if (next != matcher::S_DEAD) {
+                active[alive++] = next;
+            }
+        }
+        count = alive;
     }
-    return 0;
+
+    return NOT_FOUND;
 }
 
 /**
- * @brief Converte un carattere omocodico in cifra
+ * @brief Cerca il primo codice fiscale nel testo.
+ *
+ * Sui testi UTF-8 e UTF-16 lunghi (anche wchar_t a 16 bit, come su
+ * Windows) il prefiltro vettoriale scarta a blocchi le posizioni che non
+ * possono iniziare un codice fiscale e solo le finestre rimaste vengono
+ * verificate con l'automa. Per UTF-32 (char32_t e wchar_t a 32 bit, come
+ * su Linux) il prefiltro sarebbe solo scalare e non e' piu' veloce:
+ * si usa direttamente l'automa.
+ *
+ * @return L'offset di inizio del match, o NOT_FOUND se non trovato
  */
-static wchar_t omocodiaToDigit(wchar_t c) {
-    c = towupper(c);
-    for (int i = 0; i < 10; i++) {
-        if (c == OMOCODIA_CHARS[i]) {
-            return OMOCODIA_DIGITS[i];
+template <typename CharT>
+static size_t findFirst(const CharT* text, size_t length) {
+    if constexpr (std::is_same_v<CharT, char> || std::is_same_v<CharT, char16_t> ||
+                  (std::is_same_v<CharT, wchar_t> && sizeof(wchar_t) == sizeof(char16_t))) {
+        if (length >= PREFILTER_MIN_LENGTH) {
+            size_t candidate = simd::findCandidate(text, length, 0);
+            while (candidate != SIZE_MAX) {
+                if (matcher::matchesAt(text + candidate)) {
+                    return candidate;
+                }
+                candidate = simd::findCandidate(text, length, candidate + 1);
+            }
+            return NOT_FOUND;
         }
     }
-    return c;
-}
 
-std::wstring normalizeOmocodia(const std::wstring& cf) {
-    if (cf.length() != 16) {
-        return cf;
-    }
+    return scanCodiceFiscale(text, length);
+}
 
-    std::wstring normalized = cf;
+/**
+ * @brief Maiuscolo dei soli caratteri ASCII (gli altri restano invariati).
+ */
+template <typename CharT>
+static CharT toUpperAscii(CharT c) {
+    return (c >= CharT('a') && c <= CharT('z')) ? static_cast<CharT>(c - 'a' + 'A') : c;
+}
 
-    // Converti in maiuscolo
-    std::transform(normalized.begin(), normalized.end(), normalized.begin(), towupper);
+// ============================================================================
+// API generica (UTF-8, UTF-16, UTF-32)
+// ============================================================================
 
-    // Posizioni che possono contenere caratteri omocodici (0-indexed): 6,7,9,10,12,13,14
-    const int omocodiaPositions[] = {6, 7, 9, 10, 12, 13, 14};
+template <typename CharT>
+size_t findCodiceFiscale(std::basic_string_view<CharT> text, size_t from) {
+    if (from >= text.length()) {
+        return NOT_FOUND;
+    }
+    const size_t start = findFirst(text.data() + from, text.length() - from);
+    return start == NOT_FOUND ? NOT_FOUND : from + start;
+}
 
-    for (int pos : omocodiaPositions) {
-        normalized[pos] = omocodiaToDigit(normalized[pos]);
+template <typename CharT>
+std::optional<std::basic_string<CharT>> extractCodiceFiscale(std::basic_string_view<CharT> text) {
+    const size_t start = findCodiceFiscale(text, 0);
+    if (start == NOT_FOUND) {
+        return std::nullopt;
     }
 
-    return normalized;
+    // Il CF viene restituito anche se il CIN non e' valido: potrebbe essere
+    // un errore di battitura nel CF originale (vedi suggestCorrections)
+    std::basic_string<CharT> cf(text.substr(start, 16));
+    std::transform(cf.begin(), cf.end(), cf.begin(), toUpperAscii<CharT>);
+    return cf;
 }
 
-wchar_t calculateCIN(const std::wstring& cf) {
-    if (cf.length() < 15) {
-        return L'?';
+template <typename CharT>
+bool isValidCodiceFiscale(std::basic_string_view<CharT> cf) {
+    // Grammatica e carattere di controllo (vedi cf_matcher.h)
+    return matcher::isValidCodiceFiscale(cf.data(), cf.length());
+}
+
+template <typename CharT>
+bool normalizeOmocodia(std::basic_string_view<CharT> cf, CharT* out) {
+    if (cf.length() != 16) {
+        return false;
     }
 
-    // Normalizza per gestire omocodia nel calcolo
-    std::wstring normalized = cf.substr(0, 15);
-    std::transform(normalized.begin(), normalized.end(), normalized.begin(), towupper);
+    std::transform(cf.begin(), cf.end(), out, toUpperAscii<CharT>);
 
-    int sum = 0;
+    // Posizioni che possono contenere caratteri omocodici (0-indexed): 6,7,9,10,12,13,14
+    for (size_t pos : matcher::OMOCODIA_ORDER) {
+        const int digit = matcher::digitValue(symbolOf(out[pos]));
+        if (digit >= 0) {
+            out[pos] = static_cast<CharT>('0' + digit);
+        }
+    }
+    return true;
+}
 
-    for (int i = 0; i < 15; i++) {
-        int idx = charToIndex(normalized[i]);
+template <typename CharT>
+std::basic_string<CharT> normalizeOmocodia(std::basic_string_view<CharT> cf) {
+    std::basic_string<CharT> normalized(cf);
+    normalizeOmocodia(cf, &normalized[0]);
+    return normalized;
+}
 
-        // Posizioni dispari (1,3,5...) in base 1, quindi indici pari (0,2,4...) in base 0
-        if (i % 2 == 0) {
-            // Posizione dispari (1-indexed) -> usa tabella dispari
-            sum += CIN_ODD_VALUES[idx];
-        } else {
-            // Posizione pari (1-indexed) -> usa tabella pari
-            sum += CIN_EVEN_VALUES[idx];
-        }
+template <typename CharT>
+CharT calculateCIN(std::basic_string_view<CharT> cf) {
+    if (cf.length() < 15) {
+        return CharT('?');
     }
 
-    return L'A' + (sum % 26);
+    return static_cast<CharT>(matcher::calculateCIN(cf.data()));
 }
 
-bool verifyCIN(const std::wstring& cf) {
+template <typename CharT>
+bool verifyCIN(std::basic_string_view<CharT> cf) {
     if (cf.length() != 16) {
         return false;
     }
 
-    wchar_t expectedCIN = calculateCIN(cf);
-    wchar_t actualCIN = towupper(cf[15]);
+    return calculateCIN(cf) == toUpperAscii(cf[15]);
+}
+
+// Istanze per i tipi di code unit supportati
+#define CFPARSER_INSTANTIATE(CharT)                                                              \
+    template size_t findCodiceFiscale<CharT>(std::basic_string_view<CharT>, size_t);             \
+    template std::optional<std::basic_string<CharT>> extractCodiceFiscale<CharT>(                \
+        std::basic_string_view<CharT>);                                                          \
+    template bool isValidCodiceFiscale<CharT>(std::basic_string_view<CharT>);                    \
+    template bool normalizeOmocodia<CharT>(std::basic_string_view<CharT>, CharT*);               \
+    template std::basic_string<CharT> normalizeOmocodia<CharT>(std::basic_string_view<CharT>);   \
+    template CharT calculateCIN<CharT>(std::basic_string_view<CharT>);                           \
+    template bool verifyCIN<CharT>(std::basic_string_view<CharT>);
 
-    return expectedCIN == actualCIN;
+CFPARSER_INSTANTIATE(char)
+CFPARSER_INSTANTIATE(wchar_t)
+CFPARSER_INSTANTIATE(char16_t)
+CFPARSER_INSTANTIATE(char32_t)
+
+#undef CFPARSER_INSTANTIATE
+
+// ============================================================================
+// API std::wstring
+// ============================================================================
+
+std::wstring normalizeOmocodia(const std::wstring& cf) {
+    return normalizeOmocodia(std::wstring_view(cf));
+}
+
+wchar_t calculateCIN(const std::wstring& cf) {
+    return calculateCIN(std::wstring_view(cf));
+}
+
+bool verifyCIN(const std::wstring& cf) {
+    return verifyCIN(std::wstring_view(cf));
 }
 
 bool isValidCodiceFiscale(const std::wstring& cf) {
-    if (cf.length() != 16) {
-        return false;
-    }
+    return isValidCodiceFiscale(std::wstring_view(cf));
+}
 
-    // Verifica che corrisponda al pattern regex
-    if (!std::regex_match(cf, CF_REGEX)) {
-        return false;
+std::optional<std::wstring> extractCodiceFiscale(const std::wstring& text) {
+    return extractCodiceFiscale(std::wstring_view(text));
+}
+
+std::vector<std::wstring> extractAllCodiciFiscali(const std::wstring& text) {
+    std::vector<std::wstring> result;
+
+    size_t from = 0;
+    while (from < text.length()) {
+        const size_t start = findCodiceFiscale(std::wstring_view(text), from);
+        if (start == NOT_FOUND) {
+            break;
+        }
+
+        std::wstring cf = text.substr(start, 16);
+        std::transform(cf.begin(), cf.end(), cf.begin(), toUpperAscii<wchar_t>);
+        result.push_back(cf);
+
+        from = start + 16;
     }
 
-    // Verifica il carattere di controllo
-    return verifyCIN(cf);
+    return result;
 }
 
-std::optional<std::wstring> extractCodiceFiscale(const std::wstring& text) {
-    std::wsmatch match;
+// ============================================================================
+// Scansione di piu' identificativi
+// ============================================================================
 
-    // Cerca il pattern del codice fiscale nel testo
-    if (std::regex_search(text, match, CF_REGEX)) {
-        std::wstring cf = match.str();
+static constexpr size_t NUMERIC_CODE_LENGTH = 11;
+static constexpr size_t TEAM_CARD_LENGTH = 20;
+static constexpr wchar_t TEAM_CARD_PREFIX[] = L"80380";
 
-        // Converti in maiuscolo
-        std::transform(cf.begin(), cf.end(), cf.begin(), towupper);
+// Cifra raddoppiata nel controllo di Luhn (2d, meno 9 se supera 9)
+static constexpr uint8_t LUHN_DOUBLE[10] = {0, 2, 4, 6, 8, 1, 3, 5, 7, 9};
 
-        // Verifica validità (opzionale - la regex è già molto precisa)
-        // Se vuoi essere più permissivo, puoi rimuovere questo controllo
-        if (verifyCIN(cf)) {
-            return cf;
+/**
+ * @brief Somme di controllo di una sequenza di cifre, aggiornate a ogni cifra.
+ *
+ * oddDoubled raddoppia le cifre in posizione dispari (0-based) a partire
+ * da sinistra: e' il controllo della partita IVA su 11 cifre. evenDoubled
+ * raddoppia quelle in posizione pari: su 20 cifre corrisponde al Luhn
+ * standard, che raddoppia a partire dalla penultima cifra da destra.
+ */
+struct DigitRun {
+    size_t length = 0;
+    unsigned oddDoubled = 0;
+    unsigned evenDoubled = 0;
+
+    void add(uint8_t digit) {
+        if (length & 1) {
+            oddDoubled += LUHN_DOUBLE[digit];
+            evenDoubled += digit;
+        } else {
+            oddDoubled += digit;
+            evenDoubled += LUHN_DOUBLE[digit];
         }
+        length++;
+    }
+};
+
+static void closeDigitRun(const std::wstring& text, size_t end, DigitRun& run,
+                          std::vector<IdentifierMatch>& result) {
+    const size_t start = end - run.length;
+    if (run.length == NUMERIC_CODE_LENGTH && run.oddDoubled % 10 == 0) {
+        result.push_back({IdentifierType::NumericCode, start, run.length, true,
+                          text.substr(start, run.length)});
+    } else if (run.length == TEAM_CARD_LENGTH && run.evenDoubled % 10 == 0 &&
+               text.compare(start, 5, TEAM_CARD_PREFIX) == 0) {
+        result.push_back({IdentifierType::TeamCard, start, run.length, true,
+                          text.substr(start, run.length)});
+    }
+    run = DigitRun();
+}
 
-        // Se il CIN non è valido ma il pattern corrisponde,
-        // potrebbe essere un errore di battitura nel CF originale.
-        // Restituiamo comunque il CF trovato.
-        return cf;
+std::vector<IdentifierMatch> scanIdentifiers(const std::wstring& text) {
+    std::vector<IdentifierMatch> result;
+
+    uint8_t active[16];
+    int count = 0;
+    DigitRun run;
+
+    for (size_t i = 0; i < text.length(); i++) {
+        const uint8_t symbol = symbolOf(text[i]);
+
+        // Codice fiscale: stessa simulazione di scanCodiceFiscale()
+        active[count++] = matcher::S_SURNAME;
+        int alive = 0;
+        for (int k = 0; k < count; k++) {
+            const uint8_t next = CF_DFA.next[active[k]][symbol];
+            if (next == matcher::S_ACCEPT) {
+                const size_t start = i + 1 - 16;
+                std::wstring cf = text.substr(start, 16);
+                std::transform(cf.begin(), cf.end(), cf.begin(), toUpperAscii<wchar_t>);
+                const bool cinOk = matcher::verifyCIN(cf.c_str());
+                result.push_back({IdentifierType::CodiceFiscale, start, 16, cinOk, cf});
+                alive = 0;
+                break;
+            }
+            if (next != matcher::S_DEAD) {
+                active[alive++] = next;
+            }
+        }
+        count = alive;
+
+        // Sequenze numeriche
+        if (symbol < 10) {
+            run.add(symbol);
+        } else if (run.length > 0) {
+            closeDigitRun(text, i, run, result);
+        }
+    }
+    if (run.length > 0) {
+        closeDigitRun(text, text.length(), run, result);
     }
 
-    return std::nullopt;
+    // Le sequenze numeriche sono chiuse dopo la loro fine: riordina per offset
+    std::stable_sort(result.begin(), result.end(),
+                     [](const IdentifierMatch& a, const IdentifierMatch& b) {
+                         return a.offset < b.offset;
+                     });
+    return result;
 }
 
 } // namespace cfparser
@@ -1,22 +1,39 @@
 #ifndef CF_PARSER_H
 #define CF_PARSER_H
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <optional>
+#include <vector>
 
 namespace cfparser {
 
 /**
  * @brief Estrae un codice fiscale italiano da una stringa di testo.
  *
- * Utilizza una regex completa che supporta anche i caratteri di omocodia
- * (dove le cifre possono essere sostituite da lettere).
+ * Utilizza un automa a stati finiti che riconosce la grammatica completa
+ * del codice fiscale, compresi i caratteri di omocodia (dove le cifre
+ * possono essere sostituite da lettere). Il testo viene letto una sola volta
+ * e viene restituito il primo codice trovato.
  *
  * @param text La stringa in cui cercare il codice fiscale
  * @return Il codice fiscale trovato (in maiuscolo), o std::nullopt se non trovato
  */
 std::optional<std::wstring> extractCodiceFiscale(const std::wstring& text);
 
+/**
+ * @brief Estrae tutti i codici fiscali presenti in un testo.
+ *
+ * I codici sono restituiti da sinistra a destra, senza sovrapposizioni.
+ * Per testi molto grandi o letti a blocchi usare StreamScanner (cf_stream.h).
+ *
+ * @param text La stringa in cui cercare
+ * @return I codici trovati (in maiuscolo), eventualmente nessuno
+ */
+std::vector<std::wstring> extractAllCodiciFiscali(const std::wstring& text);
+
 /**
  * @brief Verifica se una stringa è un codice fiscale italiano valido.
  *
@@ -52,6 +69,137 @@ wchar_t calculateCIN(const std::wstring& cf);
  */
 bool verifyCIN(const std::wstring& cf);
 
+// ============================================================================
+// API generica sul tipo di code unit
+// ============================================================================
+//
+// Le funzioni seguenti accettano testo UTF-8 (char), UTF-16 (char16_t,
+// wchar_t su Windows) o UTF-32 (char32_t, wchar_t su Linux) senza
+// conversioni: il testo puo' essere un buffer mappato in memoria o letto da
+// una pipe. I caratteri non ASCII (anche le sequenze UTF-8 multibyte) non
+// fanno mai parte di un codice fiscale. Sono istanziate per char, wchar_t,
+// char16_t e char32_t.
+//
+// Esempio:  std::string_view line = ...;  findCodiceFiscale(line, 0);
+
+/**
+ * @brief Cerca il primo codice fiscale a partire da un offset.
+ *
+ * Non alloca memoria. Per trovare tutti i codici ripetere la ricerca da
+ * offset + 16.
+ *
+ * @param text Il testo in cui cercare
+ * @param from Offset da cui iniziare la ricerca
+ * @return L'offset del codice, o std::basic_string_view<CharT>::npos
+ */
+template <typename CharT>
+size_t findCodiceFiscale(std::basic_string_view<CharT> text, size_t from);
+
+/**
+ * @brief Come extractCodiceFiscale(const std::wstring&).
+ */
+template <typename CharT>
+std::optional<std::basic_string<CharT>> extractCodiceFiscale(std::basic_string_view<CharT> text);
+
+/**
+ * @brief Come isValidCodiceFiscale(const std::wstring&).
+ */
+template <typename CharT>
+bool isValidCodiceFiscale(std::basic_string_view<CharT> cf);
+
+/**
+ * @brief Converte i caratteri omocodici in cifre senza allocare.
+ *
+ * @param cf Il codice fiscale (16 code unit)
+ * @param out Buffer di 16 code unit (puo' coincidere con cf)
+ * @return false se cf non ha 16 code unit (out non viene scritto)
+ */
+template <typename CharT>
+bool normalizeOmocodia(std::basic_string_view<CharT> cf, CharT* out);
+
+/**
+ * @brief Come normalizeOmocodia(const std::wstring&).
+ */
+template <typename CharT>
+std::basic_string<CharT> normalizeOmocodia(std::basic_string_view<CharT> cf);
+
+/**
+ * @brief Come calculateCIN(const std::wstring&).
+ */
+template <typename CharT>
+CharT calculateCIN(std::basic_string_view<CharT> cf);
+
+/**
+ * @brief Come verifyCIN(const std::wstring&).
+ */
+template <typename CharT>
+bool verifyCIN(std::basic_string_view<CharT> cf);
+
+/**
+ * @brief Verifica un lotto di codici fiscali di 16 caratteri.
+ *
+ * I record vengono elaborati a gruppi di 16: le classi dei caratteri, i
+ * vincoli tra posizioni e il CIN sono calcolati per 16 record alla volta
+ * con istruzioni vettoriali (SSSE3), con le tabelle sempre in cache L1.
+ * Senza SSSE3 ogni record viene verificato singolarmente.
+ *
+ * @param records Array di count record da 16 code unit UTF-16
+ * @param count Numero di record
+ * @param results Array di count byte: matcher::Reason di ciascun record
+ *                (0 = valido, vedi cf_matcher.h)
+ */
+void validateBatch(const char16_t (*records)[16], size_t count, uint8_t* results);
+
+/**
+ * @brief Converte i caratteri omocodici in cifre per un lotto di record.
+ *
+ * Come normalizeOmocodia(), ma il maiuscolo e' applicato solo ai caratteri
+ * ASCII; gli altri code unit restano invariati.
+ *
+ * @param records Array di count record da 16 code unit UTF-16
+ * @param normalized Array di destinazione (puo' coincidere con records)
+ * @param count Numero di record
+ */
+void normalizeOmocodiaBatch(const char16_t (*records)[16], char16_t (*normalized)[16], size_t count);
+
+/**
+ * @brief Tipo di identificativo riconosciuto da scanIdentifiers().
+ */
+enum class IdentifierType : uint8_t {
+    CodiceFiscale,  ///< Codice fiscale alfanumerico (16 caratteri)
+    NumericCode,    ///< Partita IVA o codice fiscale provvisorio (11 cifre)
+    TeamCard        ///< Numero identificativo della tessera sanitaria TEAM (20 cifre)
+};
+
+/**
+ * @brief Identificativo trovato in un testo.
+ */
+struct IdentifierMatch {
+    IdentifierType type;    ///< Tipo di identificativo
+    size_t offset;          ///< Offset nel testo
+    size_t length;          ///< Lunghezza (16, 11 o 20)
+    bool checkValid;        ///< true se il carattere di controllo e' corretto
+    std::wstring value;     ///< Identificativo (in maiuscolo)
+};
+
+/**
+ * @brief Cerca in una sola passata codici fiscali, partite IVA / codici
+ *        fiscali provvisori e numeri di tessera sanitaria.
+ *
+ * Ogni carattere viene dato all'automa del codice fiscale e, se e' una
+ * cifra, a un contatore di sequenze numeriche che aggiorna le somme di
+ * controllo durante la lettura. Una sequenza di esattamente 11 cifre e' un
+ * codice numerico se la cifra di controllo (algoritmo di Luhn sulle
+ * posizioni pari) e' corretta; una di esattamente 20 cifre che inizia con
+ * 80380 e' un numero di tessera TEAM se supera il controllo di Luhn.
+ * I codici fiscali sono restituiti anche con CIN errato (checkValid = false),
+ * come da extractCodiceFiscale().
+ *
+ * @param text Il testo in cui cercare
+ * @return Gli identificativi trovati, ordinati per offset
+ */
+std::vector<IdentifierMatch> scanIdentifiers(const std::wstring& text);
+
 } // namespace cfparser
 
 #endif // CF_PARSER_H
@@ -0,0 +1,548 @@
+#include "cf_pseudonym.h"
+#include "cf_matcher.h"
+#include "cf_parser.h"
+#include "mapped_file.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define CF_AES_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// Le funzioni AES-NI vengono compilate senza flag globali e chiamate solo se
+// la CPU le supporta (GCC/Clang richiedono l'attributo target).
+#if defined(__GNUC__) || defined(__clang__)
+#define CF_TARGET_AES __attribute__((target("aes")))
+#else
+#define CF_TARGET_AES
+#endif
+
+namespace cfparser {
+
+using matcher::symbolOf;
+using matcher::digitValue;
+
+/// Record cifrati insieme (un round AES per tutti prima del successivo)
+static constexpr size_t PSEUDONYM_GROUP = 64;
+
+/// Round della rete di Feistel (come FF1)
+static constexpr unsigned FEISTEL_ROUNDS = 10;
+
+// ============================================================================
+// Numerazione dei codici validi
+// ============================================================================
+
+static constexpr char CONSONANT_LETTERS[] = "BCDFGHJKLMNPQRSTVWXYZ";
+static constexpr char VOWEL_LETTERS[] = "AEIOUX";
+static constexpr char MONTH_LETTERS[] = "ABCDEHLMPRST";
+
+/// Terne [consonante][consonante][lettera] e [lettera][vocale][vocale o X]
+static constexpr uint64_t CONSONANT_TRIPLETS = 21 * 21 * 26;
+static constexpr uint64_t TRIPLETS = CONSONANT_TRIPLETS + 26 * 5 * 6;
+
+/// Giorni dell'anno (29 febbraio compreso) per i due sessi
+static constexpr uint64_t DATES = 366 * 2;
+
+/// Codici catastali A001-M999 e Z100-Z999
+static constexpr uint64_t BELFIORE_ITALY = 13 * 999;
+static constexpr uint64_t BELFIORE_CODES = BELFIORE_ITALY + 900;
+
+static constexpr uint64_t CODE_COUNT = TRIPLETS * TRIPLETS * 100 * DATES * BELFIORE_CODES;
+
+/// Moduli delle due meta' (CODE_COUNT = MODULUS_LEFT * MODULUS_RIGHT)
+static constexpr uint64_t MODULUS_RIGHT = 389946960;
+static constexpr uint64_t MODULUS_LEFT = CODE_COUNT / MODULUS_RIGHT;
+static_assert(CODE_COUNT % MODULUS_RIGHT == 0, "le due meta' devono coprire esattamente i codici");
+
+static constexpr uint8_t MONTH_DAYS[12] = {31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+struct RankTables {
+    int8_t consonant[26] = {};     ///< Indice in CONSONANT_LETTERS o -1
+    int8_t vowel[26] = {};         ///< Indice in VOWEL_LETTERS o -1
+    int8_t month[26] = {};         ///< Indice in MONTH_LETTERS o -1
+    uint16_t monthStart[12] = {};  ///< Primo giorno dell'anno di ogni mese
+    uint8_t dayMonth[366] = {};    ///< Mese di ogni giorno dell'anno
+};
+
+static constexpr RankTables buildRankTables() {
+    RankTables t;
+    for (int i = 0; i < 26; i++) {
+        t.consonant[i] = t.vowel[i] = t.month[i] = -1;
+    }
+    for (int i = 0; CONSONANT_LETTERS[i] != '\0'; i++) {
+        t.consonant[CONSONANT_LETTERS[i] - 'A'] = static_cast<int8_t>(i);
+    }
+    for (int i = 0; VOWEL_LETTERS[i] != '\0'; i++) {
+        t.vowel[VOWEL_LETTERS[i] - 'A'] = static_cast<int8_t>(i);
+    }
+    for (int i = 0; MONTH_LETTERS[i] != '\0'; i++) {
+        t.month[MONTH_LETTERS[i] - 'A'] = static_cast<int8_t>(i);
+    }
+    uint16_t day = 0;
+    for (uint8_t m = 0; m < 12; m++) {
+        t.monthStart[m] = day;
+        for (uint8_t d = 0; d < MONTH_DAYS[m]; d++) {
+            t.dayMonth[day++] = m;
+        }
+    }
+    return t;
+}
+
+static constexpr RankTables RANK = buildRankTables();
+
+/**
+ * @brief Numero di una terna valida, in [0, TRIPLETS).
+ */
+static uint64_t rankTriplet(const uint8_t* letters) {
+    if (RANK.consonant[letters[1]] >= 0) {
+        return (static_cast<uint64_t>(RANK.consonant[letters[0]]) * 21 + RANK.consonant[letters[1]]) * 26 +
+               letters[2];
+    }
+    return CONSONANT_TRIPLETS + (static_cast<uint64_t>(letters[0]) * 5 + RANK.vowel[letters[1]]) * 6 +
+           RANK.vowel[letters[2]];
+}
+
+static void unrankTriplet(uint64_t rank, char16_t* out) {
+    if (rank < CONSONANT_TRIPLETS) {
+        out[2] = static_cast<char16_t>('A' + rank % 26);
+        rank /= 26;
+        out[1] = static_cast<char16_t>(CONSONANT_LETTERS[rank % 21]);
+        out[0] = static_cast<char16_t>(CONSONANT_LETTERS[rank / 21]);
+    } else {
+        rank -= CONSONANT_TRIPLETS;
+        out[2] = static_cast<char16_t>(VOWEL_LETTERS[rank % 6]);
+        rank /= 6;
+        out[1] = static_cast<char16_t>(VOWEL_LETTERS[rank % 5]);
+        out[0] = static_cast<char16_t>('A' + rank / 5);
+    }
+}
+
+/**
+ * @brief Numero di un codice valido, in [0, CODE_COUNT); le omocodie contano come cifre.
+ */
+static uint64_t rankCode(const char16_t* cf) {
+    uint8_t symbols[matcher::CF_LENGTH];
+    for (size_t i = 0; i < matcher::CF_LENGTH; i++) {
+        symbols[i] = symbolOf(cf[i]);
+    }
+    uint8_t letters[6];
+    for (size_t i = 0; i < 6; i++) {
+        letters[i] = static_cast<uint8_t>(symbols[i] - 10);
+    }
+    const uint64_t year = digitValue(symbols[6]) * 10 + digitValue(symbols[7]);
+
+    int day = digitValue(symbols[9]) * 10 + digitValue(symbols[10]);
+    const bool female = day > 40;
+    day -= female ? 40 : 0;
+    const uint64_t date = (female ? 366 : 0) + RANK.monthStart[RANK.month[symbols[8] - 10]] + day - 1;
+
+    const uint64_t number = digitValue(symbols[12]) * 100 + digitValue(symbols[13]) * 10 +
+                            digitValue(symbols[14]);
+    const uint64_t area = symbols[11] - 10;
+    const uint64_t belfiore = area == 25 ? BELFIORE_ITALY + number - 100 : area * 999 + number - 1;
+
+    return (((rankTriplet(letters) * TRIPLETS + rankTriplet(letters + 3)) * 100 + year) * DATES + date) *
+               BELFIORE_CODES + belfiore;
+}
+
+static void unrankCode(uint64_t rank, char16_t* out) {
+    const uint64_t belfiore = rank % BELFIORE_CODES;
+    rank /= BELFIORE_CODES;
+    uint64_t date = rank % DATES;
+    rank /= DATES;
+    const uint64_t year = rank % 100;
+    rank /= 100;
+    unrankTriplet(rank % TRIPLETS, out + 3);
+    unrankTriplet(rank / TRIPLETS, out);
+
+    out[6] = static_cast<char16_t>('0' + year / 10);
+    out[7] = static_cast<char16_t>('0' + year % 10);
+
+    const bool female = date >= 366;
+    date -= female ? 366 : 0;
+    const uint8_t month = RANK.dayMonth[date];
+    const uint64_t day = date - RANK.monthStart[month] + 1 + (female ? 40 : 0);
+    out[8] = static_cast<char16_t>(MONTH_LETTERS[month]);
+    out[9] = static_cast<char16_t>('0' + day / 10);
+    out[10] = static_cast<char16_t>('0' + day % 10);
+
+    uint64_t number;
+    if (belfiore < BELFIORE_ITALY) {
+        out[11] = static_cast<char16_t>('A' + belfiore / 999);
+        number = belfiore % 999 + 1;
+    } else {
+        out[11] = u'Z';
+        number = belfiore - BELFIORE_ITALY + 100;
+    }
+    out[12] = static_cast<char16_t>('0' + number / 100);
+    out[13] = static_cast<char16_t>('0' + number / 10 % 10);
+    out[14] = static_cast<char16_t>('0' + number % 10);
+    out[15] = static_cast<char16_t>(matcher::calculateCIN(out));
+}
+
+// ============================================================================
+// AES-128
+// ============================================================================
+
+/**
+ * @brief S-box e tabella T di AES, calcolate dal compilatore.
+ *
+ * te[x] e' la colonna di MixColumns per il byte sbox[x] in riga 0, con le
+ * righe nei byte dal meno significativo; le righe 1-3 sono rotazioni.
+ */
+struct AesTables {
+    uint8_t sbox[256] = {};
+    uint32_t te[256] = {};
+};
+
+static constexpr uint8_t rotl8(uint8_t x, int n) {
+    return static_cast<uint8_t>((x << n) | (x >> (8 - n)));
+}
+
+static constexpr uint8_t xtime(uint8_t x) {
+    return static_cast<uint8_t>((x << 1) ^ ((x & 0x80) != 0 ? 0x1B : 0));
+}
+
+static constexpr AesTables buildAesTables() {
+    AesTables t;
+    // p percorre il gruppo moltiplicativo (generatore 3), q e' il suo inverso
+    uint8_t p = 1;
+    uint8_t q = 1;
+    do {
+        p = static_cast<uint8_t>(p ^ xtime(p));
+        q = static_cast<uint8_t>(q ^ (q << 1));
+        q = static_cast<uint8_t>(q ^ (q << 2));
+        q = static_cast<uint8_t>(q ^ (q << 4));
+        if ((q & 0x80) != 0) {
+            q ^= 0x09;
+        }
+        t.sbox[p] = static_cast<uint8_t>(q ^ rotl8(q, 1) ^ rotl8(q, 2) ^ rotl8(q, 3) ^ rotl8(q, 4) ^ 0x63);
+    } while (p != 1);
+    t.sbox[0] = 0x63;
+
+    for (int x = 0; x < 256; x++) {
+        const uint32_t s = t.sbox[x];
+        const uint32_t s2 = xtime(t.sbox[x]);
+        t.te[x] = s2 | (s << 8) | (s << 16) | ((s2 ^ s) << 24);
+    }
+    return t;
+}
+
+static constexpr AesTables AES = buildAesTables();
+static_assert(AES.sbox[0x53] == 0xED, "S-box AES (FIPS-197, 5.1.1)");
+
+static inline uint32_t load32(const uint8_t* p) {
+    return p[0] | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+static inline void store32(uint8_t* p, uint32_t v) {
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+    p[2] = static_cast<uint8_t>(v >> 16);
+    p[3] = static_cast<uint8_t>(v >> 24);
+}
+
+static inline uint32_t rotl32(uint32_t x, int n) {
+    return (x << n) | (x >> (32 - n));
+}
+
+static void expandKey(const uint8_t* key, uint8_t (*roundKeys)[16]) {
+    std::memcpy(roundKeys[0], key, 16);
+    uint8_t rcon = 1;
+    for (int round = 1; round <= 10; round++) {
+        const uint8_t* prev = roundKeys[round - 1];
+        uint8_t* next = roundKeys[round];
+        // RotWord + SubWord + Rcon sull'ultima parola della chiave precedente
+        const uint8_t temp[4] = {
+            static_cast<uint8_t>(AES.sbox[prev[13]] ^ rcon), AES.sbox[prev[14]], AES.sbox[prev[15]], AES.sbox[prev[12]]};
+        for (int i = 0; i < 4; i++) {
+            next[i] = prev[i] ^ temp[i];
+        }
+        for (int i = 4; i < 16; i++) {
+            next[i] = prev[i] ^ next[i - 4];
+        }
+        rcon = xtime(rcon);
+    }
+}
+
+/**
+ * @brief Cifra un blocco con le tabelle T (nessuna istruzione speciale).
+ */
+static void encryptBlockSoftware(const uint8_t (*roundKeys)[16], uint8_t* block) {
+    uint32_t s[4];
+    for (int c = 0; c < 4; c++) {
+        s[c] = load32(block + 4 * c) ^ load32(roundKeys[0] + 4 * c);
+    }
+    for (int round = 1; round < 10; round++) {
+        uint32_t t[4];
+        for (int c = 0; c < 4; c++) {
+            t[c] = AES.te[s[c] & 0xFF] ^ rotl32(AES.te[(s[(c + 1) & 3] >> 8) & 0xFF], 8) ^
+                   rotl32(AES.te[(s[(c + 2) & 3] >> 16) & 0xFF], 16) ^
+                   rotl32(AES.te[s[(c + 3) & 3] >> 24], 24) ^ load32(roundKeys[round] + 4 * c);
+        }
+        std::memcpy(s, t, sizeof(s));
+    }
+    for (int c = 0; c < 4; c++) {
+        const uint32_t t = AES.sbox[s[c] & 0xFF] | (uint32_t(AES.sbox[(s[(c + 1) & 3] >> 8) & 0xFF]) << 8) |
+                           (uint32_t(AES.sbox[(s[(c + 2) & 3] >> 16) & 0xFF]) << 16) |
+                           (uint32_t(AES.sbox[s[(c + 3) & 3] >> 24]) << 24);
+        store32(block + 4 * c, t ^ load32(roundKeys[10] + 4 * c));
+    }
+}
+
+#if defined(CF_AES_X86)
+
+/**
+ * @brief Funzione di round con AES-NI: cifra i blocchi (valore | high), 8 alla volta.
+ *
+ * I blocchi sono composti direttamente nei registri. AESENC ha una latenza
+ * di diversi cicli ma ne accetta uno nuovo per ciclo: 8 blocchi
+ * indipendenti tengono piena la pipeline.
+ *
+ * @param high Byte 8-15 del blocco (little-endian)
+ * @param out Primi 8 byte di ogni blocco cifrato
+ */
+CF_TARGET_AES static void roundFunctionAesNi(const uint8_t (*roundKeys)[16], const uint64_t* values, size_t count,
+                                             uint64_t high, uint64_t* out) {
+    __m128i keys[11];
+    for (int r = 0; r < 11; r++) {
+        keys[r] = _mm_load_si128(reinterpret_cast<const __m128i*>(roundKeys[r]));
+    }
+    const auto block = [&](uint64_t value) {
+        return _mm_xor_si128(_mm_set_epi64x(static_cast<long long>(high), static_cast<long long>(value)), keys[0]);
+    };
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i s[8];
+        for (int j = 0; j < 8; j++) {
+            s[j] = block(values[i + j]);
+        }
+        for (int r = 1; r < 10; r++) {
+            for (int j = 0; j < 8; j++) {
+                s[j] = _mm_aesenc_si128(s[j], keys[r]);
+            }
+        }
+        for (int j = 0; j < 8; j++) {
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i + j), _mm_aesenclast_si128(s[j], keys[10]));
+        }
+    }
+    for (; i < count; i++) {
+        __m128i s = block(values[i]);
+        for (int r = 1; r < 10; r++) {
+            s = _mm_aesenc_si128(s, keys[r]);
+        }
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_aesenclast_si128(s, keys[10]));
+    }
+}
+
+#endif
+
+bool Pseudonymizer::hasHardwareAes() {
+#if defined(CF_AES_X86)
+#if defined(_MSC_VER)
+    int info[4] = {0};
+    __cpuid(info, 1);
+    return (info[2] & (1 << 25)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("aes");
+#endif
+#else
+    return false;
+#endif
+}
+
+// ============================================================================
+// Rete di Feistel
+// ============================================================================
+
+Pseudonymizer::Pseudonymizer(const uint8_t (&key)[PSEUDONYM_KEY_BYTES], std::string_view tweak,
+                             bool allowHardwareAes)
+    : m_hardware(allowHardwareAes && hasHardwareAes()) {
+    expandKey(key, m_roundKeys);
+
+    // Impronta del tweak: CBC-MAC con un primo blocco (lunghezza e 0xFF
+    // nell'ultimo byte) distinto da quelli della funzione di round
+    uint8_t state[16] = {};
+    const uint64_t length = tweak.size();
+    for (int i = 0; i < 8; i++) {
+        state[i] = static_cast<uint8_t>(length >> (8 * i));
+    }
+    state[15] = 0xFF;
+    encryptBlockSoftware(m_roundKeys, state);
+    for (size_t offset = 0; offset < tweak.size(); offset += 16) {
+        for (size_t i = 0; i < 16 && offset + i < tweak.size(); i++) {
+            state[i] ^= static_cast<uint8_t>(tweak[offset + i]);
+        }
+        encryptBlockSoftware(m_roundKeys, state);
+    }
+    std::memcpy(m_tweak, state, sizeof(m_tweak));
+}
+
+/**
+ * @brief Funzione di round: AES_K(valore | tweak | round), primi 64 bit.
+ */
+void Pseudonymizer::roundFunction(const uint64_t* values, size_t count, unsigned round, uint64_t* out) const {
+    uint8_t high[8];
+    std::memcpy(high, m_tweak, sizeof(m_tweak));
+    high[7] = static_cast<uint8_t>(round);
+
+#if defined(CF_AES_X86)
+    if (m_hardware) {
+        roundFunctionAesNi(m_roundKeys, values, count, load32(high) | (uint64_t(load32(high + 4)) << 32), out);
+        return;
+    }
+#endif
+
+    for (size_t i = 0; i < count; i++) {
+        uint8_t block[16];
+        store32(block, static_cast<uint32_t>(values[i]));
+        store32(block + 4, static_cast<uint32_t>(values[i] >> 32));
+        std::memcpy(block + 8, high, sizeof(high));
+        encryptBlockSoftware(m_roundKeys, block);
+        out[i] = load32(block) | (uint64_t(load32(block + 4)) << 32);
+    }
+}
+
+/**
+ * @brief Un round in avanti: (a, b) -> (b, (a + F(b)) mod M).
+ */
+template <uint64_t Modulus>
+static void forwardRound(uint64_t* left, uint64_t* right, const uint64_t* f, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        const uint64_t c = (left[i] + f[i] % Modulus) % Modulus;
+        left[i] = right[i];
+        right[i] = c;
+    }
+}
+
+/**
+ * @brief Un round all'indietro: (b, c) -> ((c - F(b)) mod M, b).
+ */
+template <uint64_t Modulus>
+static void inverseRound(uint64_t* left, uint64_t* right, const uint64_t* f, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        const uint64_t a = (right[i] + Modulus - f[i] % Modulus) % Modulus;
+        right[i] = left[i];
+        left[i] = a;
+    }
+}
+
+size_t Pseudonymizer::transformBatch(const char16_t (*records)[16], size_t count, char16_t (*out)[16],
+                                     uint8_t* ok, bool inverse) const {
+    uint8_t reasons[PSEUDONYM_GROUP];
+    uint64_t left[PSEUDONYM_GROUP];
+    uint64_t right[PSEUDONYM_GROUP];
+    uint64_t f[PSEUDONYM_GROUP];
+    uint8_t index[PSEUDONYM_GROUP];
+    size_t converted = 0;
+
+    for (size_t base = 0; base < count; base += PSEUDONYM_GROUP) {
+        const size_t n = std::min(PSEUDONYM_GROUP, count - base);
+        validateBatch(records + base, n, reasons);
+
+        // Tutti i record del gruppo vengono letti prima di scrivere (out puo' coincidere)
+        size_t valid = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (reasons[i] == static_cast<uint8_t>(matcher::Reason::Valid)) {
+                const uint64_t rank = rankCode(records[base + i]);
+                left[valid] = rank / MODULUS_RIGHT;
+                right[valid] = rank % MODULUS_RIGHT;
+                index[valid++] = static_cast<uint8_t>(i);
+            }
+        }
+
+        // Nei round pari la meta' sinistra e' modulo MODULUS_LEFT
+        for (unsigned step = 0; step < FEISTEL_ROUNDS; step++) {
+            const unsigned round = inverse ? FEISTEL_ROUNDS - 1 - step : step;
+            roundFunction(inverse ? left : right, valid, round, f);
+            if (round % 2 == 0) {
+                inverse ? inverseRound<MODULUS_LEFT>(left, right, f, valid)
+                        : forwardRound<MODULUS_LEFT>(left, right, f, valid);
+            } else {
+                inverse ? inverseRound<MODULUS_RIGHT>(left, right, f, valid)
+                        : forwardRound<MODULUS_RIGHT>(left, right, f, valid);
+            }
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            const bool isValid = reasons[i] == static_cast<uint8_t>(matcher::Reason::Valid);
+            if (!isValid) {
+                std::fill(out[base + i], out[base + i] + matcher::CF_LENGTH, u'\0');
+            }
+            if (ok != nullptr) {
+                ok[base + i] = isValid ? 1 : 0;
+            }
+        }
+        for (size_t k = 0; k < valid; k++) {
+            unrankCode(left[k] * MODULUS_RIGHT + right[k], out[base + index[k]]);
+        }
+        converted += valid;
+    }
+    return converted;
+}
+
+size_t Pseudonymizer::encryptBatch(const char16_t (*records)[16], size_t count, char16_t (*out)[16],
+                                   uint8_t* ok) const {
+    return transformBatch(records, count, out, ok, false);
+}
+
+size_t Pseudonymizer::decryptBatch(const char16_t (*records)[16], size_t count, char16_t (*out)[16],
+                                   uint8_t* ok) const {
+    return transformBatch(records, count, out, ok, true);
+}
+
+bool Pseudonymizer::encrypt(const char16_t* cf, char16_t* out) const {
+    return transformBatch(reinterpret_cast<const char16_t (*)[16]>(cf), 1,
+                          reinterpret_cast<char16_t (*)[16]>(out), nullptr, false) == 1;
+}
+
+bool Pseudonymizer::decrypt(const char16_t* pseudonym, char16_t* out) const {
+    return transformBatch(reinterpret_cast<const char16_t (*)[16]>(pseudonym), 1,
+                          reinterpret_cast<char16_t (*)[16]>(out), nullptr, true) == 1;
+}
+
+void encryptAesBlock(const uint8_t (&key)[PSEUDONYM_KEY_BYTES], uint8_t (&block)[16]) {
+    uint8_t roundKeys[11][16];
+    expandKey(key, roundKeys);
+    encryptBlockSoftware(roundKeys, block);
+}
+
+bool parseKeyHex(std::string_view text, uint8_t (&key)[PSEUDONYM_KEY_BYTES]) {
+    size_t digits = 0;
+    for (char c : text) {
+        int value;
+        if (c >= '0' && c <= '9') {
+            value = c - '0';
+        } else if ((c | 0x20) >= 'a' && (c | 0x20) <= 'f') {
+            value = (c | 0x20) - 'a' + 10;
+        } else if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+            continue;
+        } else {
+            return false;
+        }
+        if (digits == 2 * PSEUDONYM_KEY_BYTES) {
+            return false;
+        }
+        key[digits / 2] = static_cast<uint8_t>(digits % 2 == 0 ? value << 4 : key[digits / 2] | value);
+        digits++;
+    }
+    return digits == 2 * PSEUDONYM_KEY_BYTES;
+}
+
+bool readKeyFile(const std::string& path, uint8_t (&key)[PSEUDONYM_KEY_BYTES]) {
+    std::FILE* f = openFile(path, "rb");
+    if (f == nullptr) {
+        return false;
+    }
+    char text[256];
+    const size_t length = std::fread(text, 1, sizeof(text), f);
+    std::fclose(f);
+    return length < sizeof(text) && parseKeyHex(std::string_view(text, length), key);
+}
+
+} // namespace cfparser
@@ -0,0 +1,129 @@
+#ifndef CF_PSEUDONYM_H
+#define CF_PSEUDONYM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace cfparser {
+
+/// Lunghezza della chiave di pseudonimizzazione (AES-128)
+constexpr size_t PSEUDONYM_KEY_BYTES = 16;
+
+/**
+ * @brief Pseudonimizzazione reversibile di codici fiscali (cifratura che preserva il formato).
+ *
+ * Ogni codice valido viene sostituito da un altro codice valido (passa
+ * isValidCodiceFiscale(), CIN ricalcolato), sempre lo stesso per la stessa
+ * chiave e lo stesso tweak; chi possiede la chiave puo' risalire al codice
+ * originale con decrypt().
+ *
+ * I codici validi senza omocodia sono numerati in modo esatto (terne di
+ * cognome e nome secondo la grammatica, anno, giorno e mese con il sesso,
+ * codice catastale): circa 1,5 * 10^17 codici, il prodotto di due moduli
+ * quasi uguali (circa 3,9 * 10^8). Il numero viene cifrato con una rete di
+ * Feistel a 10 round nello stile di FF1 (NIST SP 800-38G), con somma
+ * modulare e moduli alternati, e la funzione di round e' AES-128 (AES-NI
+ * se la CPU lo supporta, altrimenti un'implementazione software). Non
+ * servono ripetizioni (cycle walking): ogni numero e' un codice valido.
+ *
+ * Le varianti omocodiche di uno stesso codice hanno lo stesso pseudonimo;
+ * decrypt() restituisce il codice base.
+ */
+class Pseudonymizer {
+public:
+    /**
+     * @param key Chiave segreta
+     * @param tweak Dato pubblico che separa gli pseudonimi (es. il nome
+     *              dello studio): con tweak diversi la stessa chiave da'
+     *              pseudonimi scorrelati
+     * @param allowHardwareAes false per usare sempre l'implementazione
+     *                         software (per confrontarla con AES-NI)
+     */
+    explicit Pseudonymizer(const uint8_t (&key)[PSEUDONYM_KEY_BYTES], std::string_view tweak = {},
+                           bool allowHardwareAes = true);
+
+    /**
+     * @brief Calcola lo pseudonimo di un codice fiscale.
+     *
+     * @param cf 16 code unit (maiuscole o minuscole, anche omocodico)
+     * @param out 16 code unit in uscita (maiuscole)
+     * @return false se cf non e' un codice valido (out viene azzerato)
+     */
+    bool encrypt(const char16_t* cf, char16_t* out) const;
+
+    /**
+     * @brief Risale al codice originale (senza omocodia) da uno pseudonimo.
+     */
+    bool decrypt(const char16_t* pseudonym, char16_t* out) const;
+
+    /**
+     * @brief Versione a lotti di encrypt().
+     *
+     * I record sono verificati con validateBatch() e cifrati a gruppi: le
+     * chiamate AES dello stesso round sono indipendenti e, con AES-NI,
+     * vengono eseguite 8 alla volta. Nessuna allocazione.
+     *
+     * @param records count record da 16 code unit
+     * @param count Numero di record
+     * @param out count record in uscita (puo' coincidere con records)
+     * @param ok Opzionale: ok[i] = 1 se records[i] era valido; i record non
+     *           validi vengono azzerati in out
+     * @return Il numero di record convertiti
+     */
+    size_t encryptBatch(const char16_t (*records)[16], size_t count, char16_t (*out)[16],
+                        uint8_t* ok = nullptr) const;
+
+    /**
+     * @brief Versione a lotti di decrypt().
+     */
+    size_t decryptBatch(const char16_t (*records)[16], size_t count, char16_t (*out)[16],
+                        uint8_t* ok = nullptr) const;
+
+    /**
+     * @brief Indica se la CPU supporta le istruzioni AES-NI.
+     */
+    static bool hasHardwareAes();
+
+    /**
+     * @brief Indica se questa istanza usa AES-NI.
+     */
+    bool usesHardwareAes() const { return m_hardware; }
+
+private:
+    size_t transformBatch(const char16_t (*records)[16], size_t count, char16_t (*out)[16],
+                          uint8_t* ok, bool inverse) const;
+    void roundFunction(const uint64_t* values, size_t count, unsigned round, uint64_t* out) const;
+
+    alignas(16) uint8_t m_roundKeys[11][16];    ///< Chiavi di round AES-128
+    uint8_t m_tweak[7];                         ///< Impronta del tweak (CBC-MAC)
+    bool m_hardware;                            ///< AES-NI disponibile
+};
+
+/**
+ * @brief Cifra un blocco con AES-128, implementazione software.
+ *
+ * E' la stessa usata da Pseudonymizer senza AES-NI; serve a verificarla
+ * con i vettori di FIPS-197.
+ */
+void encryptAesBlock(const uint8_t (&key)[PSEUDONYM_KEY_BYTES], uint8_t (&block)[16]);
+
+/**
+ * @brief Legge una chiave scritta in esadecimale (32 cifre, spazi e a capo ignorati).
+ *
+ * @return false se il testo non contiene esattamente 32 cifre esadecimali
+ */
+bool parseKeyHex(std::string_view text, uint8_t (&key)[PSEUDONYM_KEY_BYTES]);
+
+/**
+ * @brief Legge la chiave da un file scritto come per parseKeyHex().
+ *
+ * @param path Percorso UTF-8 del file
+ * @return false se il file non si apre o non contiene una chiave valida
+ */
+bool readKeyFile(const std::string& path, uint8_t (&key)[PSEUDONYM_KEY_BYTES]);
+
+} // namespace cfparser
+
+#endif // CF_PSEUDONYM_H
@@ -0,0 +1,102 @@
+#include "cf_redact.h"
+#include "cf_matcher.h"
+#include "cf_pseudonym.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace cfparser {
+
+StreamRedactor::StreamRedactor(RedactOptions options) : m_options(std::move(options)), m_scanner(true) {
+    reset();
+}
+
+void StreamRedactor::reset() {
+    m_scanner.reset();
+    m_matches.clear();
+    m_emitted = 0;
+    m_redacted = 0;
+    m_skipped = 0;
+}
+
+/**
+ * @brief Aggiunge a out i byte [from, to) del flusso.
+ *
+ * I byte prima di chunkStart sono quelli trattenuti in m_tail (che inizia
+ * da m_emitted), gli altri sono nel blocco corrente.
+ */
+void StreamRedactor::appendRange(uint64_t from, uint64_t to, const char* chunk, uint64_t chunkStart,
+                                 std::string& out) const {
+    if (from < chunkStart) {
+        const uint64_t end = std::min(to, chunkStart);
+        out.append(m_tail + (from - m_emitted), static_cast<size_t>(end - from));
+        from = end;
+    }
+    if (from < to) {
+        out.append(chunk + (from - chunkStart), static_cast<size_t>(to - from));
+    }
+}
+
+void StreamRedactor::appendReplacement(const CFMatch& match, std::string& out) {
+    if (m_options.pseudonymizer != nullptr && match.cinValid) {
+        char16_t code[matcher::CF_LENGTH];
+        char16_t pseudonym[matcher::CF_LENGTH];
+        std::copy(match.code, match.code + matcher::CF_LENGTH, code);
+        if (m_options.pseudonymizer->encrypt(code, pseudonym)) {
+            for (char16_t c : pseudonym) {
+                out.push_back(static_cast<char>(c));
+            }
+            return;
+        }
+    }
+    out.append(m_options.mask);
+}
+
+void StreamRedactor::feed(const char* chunk, size_t length, std::string& out) {
+    const uint64_t chunkStart = m_scanner.getPosition();
+    m_matches.clear();
+    m_scanner.feed(chunk, length, m_matches);
+
+    // Lo scanner restituisce anche i codici sovrapposti, cosi' un codice con
+    // CIN errato non nasconde un codice valido che inizia al suo interno. Un
+    // codice che si sovrappone a quello appena sostituito viene sostituito a
+    // sua volta, senza riemettere i byte in comune.
+    uint64_t emitted = m_emitted;
+    for (const CFMatch& match : m_matches) {
+        if (!match.cinValid && !m_options.includeInvalidCIN) {
+            m_skipped++;
+            continue;
+        }
+        if (match.offset >= emitted) {
+            appendRange(emitted, match.offset, chunk, chunkStart, out);
+        }
+        appendReplacement(match, out);
+        emitted = match.offset + matcher::CF_LENGTH;
+        m_redacted++;
+    }
+
+    // Gli ultimi 15 byte possono essere l'inizio di un codice non ancora completo
+    const uint64_t end = chunkStart + length;
+    const uint64_t safe = end - std::min<uint64_t>(end, matcher::CF_LENGTH - 1);
+    if (emitted < safe) {
+        appendRange(emitted, safe, chunk, chunkStart, out);
+        emitted = safe;
+    }
+
+    // Nuova coda: [emitted, end), al piu' 15 byte
+    char tail[16];
+    size_t tailLength = 0;
+    for (uint64_t p = emitted; p < end; p++) {
+        tail[tailLength++] = p < chunkStart ? m_tail[p - m_emitted] : chunk[p - chunkStart];
+    }
+    std::memcpy(m_tail, tail, tailLength);
+    m_emitted = emitted;
+}
+
+void StreamRedactor::finish(std::string& out) {
+    const uint64_t end = m_scanner.getPosition();
+    out.append(m_tail, static_cast<size_t>(end - m_emitted));
+    m_emitted = end;
+}
+
+} // namespace cfparser
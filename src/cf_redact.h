@@ -0,0 +1,78 @@
+#ifndef CF_REDACT_H
+#define CF_REDACT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "cf_stream.h"
+
+namespace cfparser {
+
+class Pseudonymizer;
+
+/**
+ * @brief Come vengono sostituiti i codici fiscali.
+ */
+struct RedactOptions {
+    std::string mask = "****************";      ///< Testo al posto di ogni codice
+    const Pseudonymizer* pseudonymizer = nullptr; ///< Se presente: pseudonimo al posto della maschera
+    bool includeInvalidCIN = false;               ///< Maschera anche i codici con CIN errato
+};
+
+/**
+ * @brief Filtro che maschera i codici fiscali in un flusso di testo a 8 bit.
+ *
+ * Il testo (UTF-8, Latin-1 o ASCII) viene fornito a blocchi di dimensione
+ * arbitraria e cercato con StreamScanner; ogni codice valido (anche
+ * omocodico, in maiuscolo o minuscolo) viene sostituito dalla maschera o,
+ * con un Pseudonymizer, dal suo pseudonimo (stessa persona, stesso
+ * pseudonimo, reversibile con la chiave). Tutti gli altri byte passano
+ * invariati. Le sequenze con la forma di un codice ma con CIN errato non
+ * nascondono un codice valido sovrapposto.
+ *
+ * Vengono trattenuti al piu' gli ultimi 15 byte di ogni blocco (potrebbero
+ * essere l'inizio di un codice): la memoria usata non dipende dalla
+ * lunghezza del flusso.
+ */
+class StreamRedactor {
+public:
+    explicit StreamRedactor(RedactOptions options = {});
+
+    /**
+     * @brief Elabora un blocco e aggiunge a out il testo che puo' gia' essere emesso.
+     */
+    void feed(const char* chunk, size_t length, std::string& out);
+
+    /**
+     * @brief Fine del flusso: aggiunge a out i byte trattenuti.
+     */
+    void finish(std::string& out);
+
+    /**
+     * @brief Riporta il filtro all'inizio di un nuovo flusso.
+     */
+    void reset();
+
+    /// Codici sostituiti
+    uint64_t getRedactedCount() const { return m_redacted; }
+
+    /// Codici con CIN errato lasciati invariati
+    uint64_t getSkippedCount() const { return m_skipped; }
+
+private:
+    void appendRange(uint64_t from, uint64_t to, const char* chunk, uint64_t chunkStart, std::string& out) const;
+    void appendReplacement(const CFMatch& match, std::string& out);
+
+    RedactOptions m_options;
+    StreamScanner m_scanner;
+    std::vector<CFMatch> m_matches;   ///< Codici dell'ultimo blocco (riusato)
+    char m_tail[16];                  ///< Byte trattenuti, da m_emitted alla fine del blocco
+    uint64_t m_emitted;               ///< Offset del primo byte non ancora emesso
+    uint64_t m_redacted;
+    uint64_t m_skipped;
+};
+
+} // namespace cfparser
+
+#endif // CF_REDACT_H
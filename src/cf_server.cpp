@@ -0,0 +1,411 @@
+#include "cf_server.h"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX            // std::min/std::max, non le macro di windows.h
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <windows.h>
+#elif defined(__linux__)
+#include <arpa/inet.h>
+#include <cerrno>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace cfparser {
+
+/// Byte letti da un socket per volta
+static constexpr size_t READ_BYTES = 64 * 1024;
+
+static unsigned resolveThreads(unsigned threads) {
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    return std::max(threads, 1u);
+}
+
+void ServiceServer::run() {
+    std::vector<std::thread> threads;
+#ifdef _WIN32
+    // Su Windows tutti i thread servono la porta di completamento e questo accetta le connessioni
+    for (unsigned i = 0; i < m_threads; i++) {
+        threads.emplace_back(&ServiceServer::runWorker, this, i);
+    }
+    const SOCKET listener = static_cast<SOCKET>(m_listeners[0]);
+    for (;;) {
+        const SOCKET client = accept(listener, nullptr, nullptr);
+        if (client != INVALID_SOCKET) {
+            acceptConnection(client);
+        }
+    }
+#else
+    for (unsigned i = 1; i < m_threads; i++) {
+        threads.emplace_back(&ServiceServer::runWorker, this, i);
+    }
+    runWorker(0);
+#endif
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+#if defined(__linux__)
+
+// ============================================================================
+// Linux: un epoll per thread
+// ============================================================================
+
+/// Eventi letti da epoll_wait() per volta
+static constexpr int MAX_EVENTS = 256;
+
+struct Connection {
+    Connection(int client, const ServiceStats& stats) : socket(client), protocol(stats) {}
+
+    int socket;
+    ServiceConnection protocol;
+    std::string output;         ///< Risposte da inviare
+    size_t sent = 0;            ///< Byte di output gia' inviati
+    bool writing = false;       ///< In attesa di EPOLLOUT (lettura sospesa)
+    bool closing = false;       ///< Chiudere dopo l'invio di output
+};
+
+ServiceServer::~ServiceServer() {
+    for (intptr_t listener : m_listeners) {
+        close(static_cast<int>(listener));
+    }
+}
+
+bool ServiceServer::start(const ServerOptions& options, std::string& error) {
+    m_threads = resolveThreads(options.threads);
+    m_stats = std::make_unique<ServiceStats>(m_threads);
+    uint16_t port = options.port;
+
+    // Con SO_REUSEPORT un'altra istanza potrebbe condividere la porta senza errori:
+    // la si prova prima con un socket senza opzioni
+    if (port != 0) {
+        const int probe = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        const bool available = probe >= 0 && bind(probe, reinterpret_cast<const sockaddr*>(&address),
+                                                  sizeof(address)) == 0;
+        if (!available) {
+            error = "127.0.0.1:" + std::to_string(port) + ": " + std::strerror(errno);
+        }
+        if (probe >= 0) {
+            close(probe);
+        }
+        if (!available) {
+            return false;
+        }
+    }
+
+    for (unsigned i = 0; i < m_threads; i++) {
+        const int listener = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listener < 0) {
+            error = std::string("socket: ") + std::strerror(errno);
+            return false;
+        }
+        m_listeners.push_back(listener);
+
+        const int one = 1;
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        setsockopt(listener, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one));
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+            listen(listener, SOMAXCONN) != 0) {
+            error = "127.0.0.1:" + std::to_string(port) + ": " + std::strerror(errno);
+            return false;
+        }
+        if (port == 0) {
+            // Gli altri thread si mettono in ascolto sulla porta scelta dal sistema
+            socklen_t length = sizeof(address);
+            getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length);
+            port = ntohs(address.sin_port);
+        }
+    }
+    m_port = port;
+    return true;
+}
+
+/**
+ * @brief Invia output finche' il socket lo accetta.
+ *
+ * @return false se la connessione va chiusa
+ */
+static bool flushOutput(Connection& connection, int poll) {
+    while (connection.sent < connection.output.size()) {
+        const ssize_t written = send(connection.socket, connection.output.data() + connection.sent,
+                                     connection.output.size() - connection.sent, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                return false;
+            }
+            if (!connection.writing) {
+                epoll_event event{};
+                event.events = EPOLLOUT;
+                event.data.ptr = &connection;
+                epoll_ctl(poll, EPOLL_CTL_MOD, connection.socket, &event);
+                connection.writing = true;
+            }
+            return true;
+        }
+        connection.sent += static_cast<size_t>(written);
+    }
+    connection.output.clear();
+    connection.sent = 0;
+    if (connection.writing) {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.ptr = &connection;
+        epoll_ctl(poll, EPOLL_CTL_MOD, connection.socket, &event);
+        connection.writing = false;
+    }
+    return !connection.closing;
+}
+
+static void closeConnection(Connection* connection) {
+    // Chiusura ordinata: il client riceve tutta l'ultima risposta
+    shutdown(connection->socket, SHUT_WR);
+    close(connection->socket);
+    delete connection;
+}
+
+void ServiceServer::runWorker(unsigned worker) {
+    ServiceCounters& counters = m_stats->getShard(worker);
+    const int listener = static_cast<int>(m_listeners[worker]);
+    const int poll = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.ptr = nullptr;
+    epoll_ctl(poll, EPOLL_CTL_ADD, listener, &event);
+
+    std::unique_ptr<char[]> buffer(new char[READ_BYTES]);
+    epoll_event events[MAX_EVENTS];
+    for (;;) {
+        const int count = epoll_wait(poll, events, MAX_EVENTS, -1);
+        for (int i = 0; i < count; i++) {
+            Connection* connection = static_cast<Connection*>(events[i].data.ptr);
+            if (connection == nullptr) {
+                // Nuove connessioni sul socket in ascolto di questo thread
+                int client;
+                while ((client = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+                    const int one = 1;
+                    setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+                    epoll_event added{};
+                    added.events = EPOLLIN;
+                    added.data.ptr = new Connection(client, *m_stats);
+                    epoll_ctl(poll, EPOLL_CTL_ADD, client, &added);
+                    ServiceCounters::add(counters.connections, 1);
+                }
+                continue;
+            }
+
+            bool open = true;
+            if (connection->writing) {
+                open = (events[i].events & EPOLLERR) == 0 && flushOutput(*connection, poll);
+            } else {
+                const ssize_t length = recv(connection->socket, buffer.get(), READ_BYTES, 0);
+                if (length > 0) {
+                    connection->closing = !connection->protocol.feed(buffer.get(), static_cast<size_t>(length),
+                                                                     counters, connection->output);
+                    open = flushOutput(*connection, poll);
+                } else {
+                    open = length < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR);
+                }
+            }
+            if (!open) {
+                closeConnection(connection);
+            }
+        }
+    }
+}
+
+#elif defined(_WIN32)
+
+// ============================================================================
+// Windows: porta di completamento condivisa
+// ============================================================================
+
+/// Chiave di completamento delle connessioni appena accettate
+static constexpr ULONG_PTR ACCEPTED_KEY = 1;
+
+struct Connection {
+    Connection(SOCKET client, const ServiceStats& stats) : socket(client), protocol(stats) {}
+
+    OVERLAPPED overlapped{};    ///< Operazione in corso (una sola per volta)
+    SOCKET socket;
+    ServiceConnection protocol;
+    std::string output;         ///< Risposte da inviare
+    size_t sent = 0;            ///< Byte di output gia' inviati
+    bool sending = false;       ///< L'operazione in corso e' un invio
+    bool closing = false;       ///< Chiudere dopo l'invio di output
+    char buffer[READ_BYTES];    ///< Destinazione di WSARecv()
+};
+
+ServiceServer::~ServiceServer() {
+    for (intptr_t listener : m_listeners) {
+        closesocket(static_cast<SOCKET>(listener));
+    }
+    if (m_completionPort != nullptr) {
+        CloseHandle(m_completionPort);
+    }
+}
+
+bool ServiceServer::start(const ServerOptions& options, std::string& error) {
+    WSADATA data;
+    if (WSAStartup(MAKEWORD(2, 2), &data) != 0) {
+        error = "WSAStartup non riuscito";
+        return false;
+    }
+    m_threads = resolveThreads(options.threads);
+    m_stats = std::make_unique<ServiceStats>(m_threads);
+
+    const SOCKET listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (listener == INVALID_SOCKET) {
+        error = "socket: errore " + std::to_string(WSAGetLastError());
+        return false;
+    }
+    m_listeners.push_back(static_cast<intptr_t>(listener));
+
+    // Porta occupata = errore (senza SO_EXCLUSIVEADDRUSE un altro processo potrebbe condividerla)
+    const BOOL exclusive = TRUE;
+    setsockopt(listener, SOL_SOCKET, SO_EXCLUSIVEADDRUSE, reinterpret_cast<const char*>(&exclusive),
+               sizeof(exclusive));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(options.port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listener, SOMAXCONN) != 0) {
+        error = "127.0.0.1:" + std::to_string(options.port) + ": errore " + std::to_string(WSAGetLastError());
+        return false;
+    }
+    int length = sizeof(address);
+    getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length);
+    m_port = ntohs(address.sin_port);
+
+    m_completionPort = CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, m_threads);
+    if (m_completionPort == nullptr) {
+        error = "CreateIoCompletionPort: errore " + std::to_string(GetLastError());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Associa una connessione accettata alla porta di completamento.
+ *
+ * La connessione viene consegnata a uno dei thread con un pacchetto di
+ * completamento: i contatori restano scritti solo dai thread di I/O.
+ */
+void ServiceServer::acceptConnection(uintptr_t client) {
+    const BOOL noDelay = TRUE;
+    setsockopt(static_cast<SOCKET>(client), IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay),
+               sizeof(noDelay));
+    Connection* connection = new Connection(static_cast<SOCKET>(client), *m_stats);
+    HANDLE port = static_cast<HANDLE>(m_completionPort);
+    if (CreateIoCompletionPort(reinterpret_cast<HANDLE>(connection->socket), port, 0, 0) == nullptr ||
+        !PostQueuedCompletionStatus(port, 0, ACCEPTED_KEY, &connection->overlapped)) {
+        closesocket(connection->socket);
+        delete connection;
+    }
+}
+
+static bool postReceive(Connection& connection) {
+    connection.overlapped = OVERLAPPED{};
+    connection.sending = false;
+    WSABUF buffer;
+    buffer.buf = connection.buffer;
+    buffer.len = static_cast<ULONG>(READ_BYTES);
+    DWORD flags = 0;
+    return WSARecv(connection.socket, &buffer, 1, nullptr, &flags, &connection.overlapped, nullptr) == 0 ||
+           WSAGetLastError() == WSA_IO_PENDING;
+}
+
+/**
+ * @brief Invia il resto di output o, se e' stato inviato tutto, torna a leggere.
+ *
+ * @return false se la connessione va chiusa
+ */
+static bool continueConnection(Connection& connection) {
+    if (connection.sent < connection.output.size()) {
+        connection.overlapped = OVERLAPPED{};
+        connection.sending = true;
+        WSABUF buffer;
+        buffer.buf = connection.output.data() + connection.sent;
+        buffer.len = static_cast<ULONG>(std::min<size_t>(connection.output.size() - connection.sent, 1u << 30));
+        return WSASend(connection.socket, &buffer, 1, nullptr, 0, &connection.overlapped, nullptr) == 0 ||
+               WSAGetLastError() == WSA_IO_PENDING;
+    }
+    connection.output.clear();
+    connection.sent = 0;
+    return !connection.closing && postReceive(connection);
+}
+
+static void closeConnection(Connection* connection) {
+    shutdown(connection->socket, SD_SEND);
+    closesocket(connection->socket);
+    delete connection;
+}
+
+void ServiceServer::runWorker(unsigned worker) {
+    ServiceCounters& counters = m_stats->getShard(worker);
+    HANDLE port = static_cast<HANDLE>(m_completionPort);
+    for (;;) {
+        DWORD bytes = 0;
+        ULONG_PTR key = 0;
+        OVERLAPPED* overlapped = nullptr;
+        const BOOL ok = GetQueuedCompletionStatus(port, &bytes, &key, &overlapped, INFINITE);
+        if (overlapped == nullptr) {
+            continue;
+        }
+        Connection* connection = CONTAINING_RECORD(overlapped, Connection, overlapped);
+        bool open;
+        if (key == ACCEPTED_KEY) {
+            ServiceCounters::add(counters.connections, 1);
+            open = postReceive(*connection);
+        } else if (!ok || bytes == 0) {
+            open = false;   // Errore o connessione chiusa dal client
+        } else if (connection->sending) {
+            connection->sent += bytes;
+            open = continueConnection(*connection);
+        } else {
+            connection->closing = !connection->protocol.feed(connection->buffer, bytes, counters,
+                                                             connection->output);
+            open = continueConnection(*connection);
+        }
+        if (!open) {
+            closeConnection(connection);
+        }
+    }
+}
+
+#else
+
+ServiceServer::~ServiceServer() = default;
+
+bool ServiceServer::start(const ServerOptions&, std::string& error) {
+    error = "servizio disponibile solo su Linux e Windows";
+    return false;
+}
+
+void ServiceServer::runWorker(unsigned) {}
+
+#endif
+
+} // namespace cfparser
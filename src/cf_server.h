@@ -0,0 +1,79 @@
+#ifndef CF_SERVER_H
+#define CF_SERVER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "cf_service.h"
+
+namespace cfparser {
+
+/**
+ * @brief Opzioni di ServiceServer.
+ */
+struct ServerOptions {
+    uint16_t port = 8765;       ///< Porta su 127.0.0.1 (0 = scelta dal sistema)
+    unsigned threads = 1;       ///< Thread di I/O (0 = tutti i core)
+};
+
+/**
+ * @brief Servizio HTTP di verifica dei codici fiscali, solo su loopback.
+ *
+ * Ciclo di I/O a eventi con socket non bloccanti: su Linux ogni thread ha
+ * il proprio epoll e il proprio socket in ascolto sulla stessa porta
+ * (SO_REUSEPORT, il kernel distribuisce le connessioni), su Windows i
+ * thread condividono una porta di completamento (IOCP) e le connessioni
+ * vengono accettate dal thread che chiama run(). Il protocollo e' in
+ * ServiceConnection; ogni thread aggiorna solo i propri contatori in
+ * ServiceStats.
+ *
+ * Una connessione ha al piu' un'operazione in corso: mentre una risposta
+ * non e' stata inviata del tutto non si leggono altre richieste, cosi' un
+ * client che non legge le risposte non fa crescere la memoria del servizio.
+ */
+class ServiceServer {
+public:
+    ServiceServer() = default;
+    ~ServiceServer();
+
+    ServiceServer(const ServiceServer&) = delete;
+    ServiceServer& operator=(const ServiceServer&) = delete;
+
+    /**
+     * @brief Apre i socket in ascolto su 127.0.0.1.
+     *
+     * @param error Descrizione dell'errore se la porta non e' disponibile
+     * @return false in caso di errore
+     */
+    bool start(const ServerOptions& options, std::string& error);
+
+    /**
+     * @brief Serve le richieste; non ritorna finche' il processo e' attivo.
+     */
+    void run();
+
+    /// Porta effettiva (utile con ServerOptions::port = 0)
+    uint16_t getPort() const { return m_port; }
+
+    unsigned getThreadCount() const { return m_threads; }
+
+private:
+    void runWorker(unsigned worker);
+#ifdef _WIN32
+    void acceptConnection(uintptr_t client);
+#endif
+
+    std::unique_ptr<ServiceStats> m_stats;
+    std::vector<intptr_t> m_listeners;  ///< Socket in ascolto (Linux: uno per thread)
+    unsigned m_threads = 0;
+    uint16_t m_port = 0;
+#ifdef _WIN32
+    void* m_completionPort = nullptr;
+#endif
+};
+
+} // namespace cfparser
+
+#endif // CF_SERVER_H
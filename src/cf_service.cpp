@@ -0,0 +1,724 @@
+#include "cf_service.h"
+#include "belfiore.h"
+#include "cf_decode.h"
+#include "cf_matcher.h"
+#include "cf_parser.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <iterator>
+
+namespace cfparser {
+
+using matcher::CF_LENGTH;
+using matcher::Reason;
+
+/// Codici verificati insieme (buffer sullo stack)
+static constexpr size_t CODE_GROUP = 64;
+
+/// Oltre questa capacita' i buffer di una connessione inattiva vengono liberati
+static constexpr size_t IDLE_BUFFER_BYTES = 64 * 1024;
+
+/// Esiti della verifica come scritti nelle risposte (indicizzati per matcher::Reason)
+static constexpr const char* REASON_NAMES[] = {
+    "valido",
+    "lunghezza",
+    "carattere",
+    "cognome",
+    "nome",
+    "anno",
+    "mese",
+    "giorno",
+    "luogo",
+    "cin"
+};
+
+static_assert(std::size(REASON_NAMES) == static_cast<size_t>(Reason::InvalidCIN) + 1,
+              "un nome per ogni matcher::Reason");
+
+// ============================================================================
+// Contatori
+// ============================================================================
+
+ServiceStats::ServiceStats(unsigned shards)
+    : m_shards(std::make_unique<ServiceCounters[]>(shards)), m_count(shards) {}
+
+ServiceTotals ServiceStats::getTotals() const {
+    ServiceTotals totals;
+    for (unsigned i = 0; i < m_count; i++) {
+        const ServiceCounters& shard = m_shards[i];
+        totals.connections += shard.connections.load(std::memory_order_relaxed);
+        totals.requests += shard.requests.load(std::memory_order_relaxed);
+        totals.errors += shard.errors.load(std::memory_order_relaxed);
+        totals.codes += shard.codes.load(std::memory_order_relaxed);
+        totals.validCodes += shard.validCodes.load(std::memory_order_relaxed);
+        totals.extracted += shard.extracted.load(std::memory_order_relaxed);
+    }
+    return totals;
+}
+
+// ============================================================================
+// JSON
+// ============================================================================
+
+static bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static size_t skipSpace(std::string_view text, size_t pos) {
+    while (pos < text.size() && isSpace(text[pos])) {
+        pos++;
+    }
+    return pos;
+}
+
+static void appendNumber(std::string& out, uint64_t value) {
+    char buffer[24];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+static void appendJsonString(std::string& out, std::string_view text) {
+    out += '"';
+    for (char c : text) {
+        const unsigned char u = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (u < 0x20) {
+            char escape[8];
+            std::snprintf(escape, sizeof(escape), "\\u%04x", u);
+            out += escape;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+/**
+ * @brief Aggiunge a out una denominazione della tabella dei luoghi come stringa JSON (UTF-8).
+ */
+static void appendJsonName(std::string& out, const wchar_t* name) {
+    out += '"';
+    for (; *name != L'\0'; name++) {
+        char32_t c = static_cast<char32_t>(*name);
+        if (sizeof(wchar_t) == 2 && c >= 0xD800 && c < 0xDC00 && name[1] >= 0xDC00 && name[1] < 0xE000) {
+            c = 0x10000 + ((c - 0xD800) << 10) + (static_cast<char32_t>(*++name) - 0xDC00);
+        }
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += static_cast<char>(c);
+        } else if (c < 0x20) {
+            continue;
+        } else if (c < 0x80) {
+            out += static_cast<char>(c);
+        } else if (c < 0x800) {
+            out += static_cast<char>(0xC0 | (c >> 6));
+            out += static_cast<char>(0x80 | (c & 0x3F));
+        } else if (c < 0x10000) {
+            out += static_cast<char>(0xE0 | (c >> 12));
+            out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (c & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (c >> 18));
+            out += static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (c & 0x3F));
+        }
+    }
+    out += '"';
+}
+
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+/**
+ * @brief Legge la stringa JSON che inizia in text[pos] (le virgolette).
+ *
+ * I primi 16 caratteri vanno in record (i byte non ASCII restano come
+ * sono: non fanno mai parte di un codice valido); length riceve il numero
+ * di caratteri, raw il testo tra le virgolette cosi' com'e' (JSON valido,
+ * riusato nella risposta). pos avanza oltre le virgolette di chiusura.
+ *
+ * @return false se la stringa non e' JSON valido
+ */
+static bool readJsonString(std::string_view text, size_t& pos, char16_t (&record)[16], size_t& length,
+                           std::string_view& raw) {
+    const size_t start = ++pos;
+    length = 0;
+    while (pos < text.size()) {
+        const unsigned char c = static_cast<unsigned char>(text[pos++]);
+        char32_t value = c;
+        if (c == '"') {
+            raw = text.substr(start, pos - 1 - start);
+            std::fill(record + std::min(length, CF_LENGTH), record + CF_LENGTH, u'\0');
+            return true;
+        }
+        if (c < 0x20) {
+            return false;
+        }
+        if ((c & 0xC0) == 0x80) {
+            continue;   // Continuazione UTF-8: conta solo il primo byte del carattere
+        }
+        if (c == '\\') {
+            if (pos >= text.size()) {
+                return false;
+            }
+            switch (text[pos++]) {
+                case '"':  value = '"'; break;
+                case '\\': value = '\\'; break;
+                case '/':  value = '/'; break;
+                case 'b':  value = '\b'; break;
+                case 'f':  value = '\f'; break;
+                case 'n':  value = '\n'; break;
+                case 'r':  value = '\r'; break;
+                case 't':  value = '\t'; break;
+                case 'u':
+                    if (pos + 4 > text.size()) {
+                        return false;
+                    }
+                    value = 0;
+                    for (int k = 0; k < 4; k++) {
+                        const int digit = hexValue(text[pos++]);
+                        if (digit < 0) {
+                            return false;
+                        }
+                        value = value * 16 + static_cast<char32_t>(digit);
+                    }
+                    break;
+                default:
+                    return false;
+            }
+        }
+        if (length < CF_LENGTH) {
+            record[length] = static_cast<char16_t>(value);
+        }
+        length++;
+    }
+    return false;
+}
+
+/**
+ * @brief Decodifica il parametro name di una query string (%XX e '+').
+ *
+ * @return false se il parametro non c'e'
+ */
+static bool queryParameter(std::string_view query, std::string_view name, std::string& out) {
+    while (!query.empty()) {
+        const size_t end = std::min(query.find('&'), query.size());
+        const std::string_view pair = query.substr(0, end);
+        query.remove_prefix(std::min(end + 1, query.size()));
+
+        const size_t equals = pair.find('=');
+        if (pair.substr(0, equals) != name) {
+            continue;
+        }
+        out.clear();
+        const std::string_view value = equals == pair.npos ? std::string_view() : pair.substr(equals + 1);
+        for (size_t i = 0; i < value.size(); i++) {
+            if (value[i] == '+') {
+                out += ' ';
+            } else if (value[i] == '%' && i + 2 < value.size() && hexValue(value[i + 1]) >= 0 &&
+                       hexValue(value[i + 2]) >= 0) {
+                out += static_cast<char>(hexValue(value[i + 1]) * 16 + hexValue(value[i + 2]));
+                i += 2;
+            } else {
+                out += value[i];
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+// ============================================================================
+// Risposte
+// ============================================================================
+
+/**
+ * @brief Dati decodificati di un codice valido, gia' normalizzato.
+ */
+static void appendDecoded(const char16_t* normalized, const DecodedCF& decoded, std::string& out) {
+    char code[CF_LENGTH];
+    for (size_t k = 0; k < CF_LENGTH - 1; k++) {
+        code[k] = static_cast<char>(normalized[k]);
+    }
+    code[CF_LENGTH - 1] = matcher::calculateCIN(code);
+
+    char buffer[128];
+    std::snprintf(buffer, sizeof(buffer),
+                  ",\"normalized\":\"%.16s\",\"birth_date\":\"%04u-%02u-%02u\",\"sex\":\"%c\",\"age\":%u,"
+                  "\"belfiore\":\"%.4s\",\"place\":",
+                  code, static_cast<unsigned>(decoded.year), static_cast<unsigned>(decoded.month),
+                  static_cast<unsigned>(decoded.day), decoded.sex == Sex::Female ? 'F' : 'M',
+                  static_cast<unsigned>(decoded.age), code + 11);
+    out += buffer;
+    if (const belfiore::Place* place = belfiore::lookup(code + 11)) {
+        appendJsonName(out, place->name);
+        out += ",\"province\":\"";
+        out += place->province;
+        out += '"';
+    } else {
+        out += "null,\"province\":null";
+    }
+    // Codice inesistente o non in uso alla data di nascita (serve la tabella completa)
+    out += belfiore::isPlausibleBirthplace(code, decoded.getBirthDate()) ? ",\"place_plausible\":true"
+                                                                        : ",\"place_plausible\":false";
+}
+
+/**
+ * @brief Verifica (ed eventualmente decodifica) un gruppo di codici e ne aggiunge i risultati a out.
+ *
+ * @return Il numero di codici validi
+ */
+static size_t appendResults(char16_t (*records)[16], const size_t* lengths, const std::string_view* raws,
+                            size_t count, bool decode, uint32_t referenceDate, std::string& out) {
+    uint8_t reasons[CODE_GROUP];
+    DecodedCF decoded[CODE_GROUP];
+    validateBatch(records, count, reasons);
+    if (decode) {
+        decodeBatch(records, count, referenceDate, decoded);
+        normalizeOmocodiaBatch(records, records, count);
+    }
+
+    size_t valid = 0;
+    for (size_t i = 0; i < count; i++) {
+        Reason reason = lengths[i] != CF_LENGTH ? Reason::InvalidLength : static_cast<Reason>(reasons[i]);
+        if (decode && reason == Reason::Valid && !decoded[i].valid) {
+            reason = Reason::InvalidDay;    // Es. 30 febbraio
+        }
+        const bool ok = reason == Reason::Valid;
+        valid += ok ? 1 : 0;
+
+        // out e' vuoto (codice singolo) o inizia con '[' (array)
+        if (out.size() > 1) {
+            out += ',';
+        }
+        out += "{\"cf\":\"";
+        out += raws[i];
+        out += ok ? "\",\"valid\":true" : "\",\"valid\":false";
+        out += ",\"reason\":\"";
+        out += REASON_NAMES[static_cast<size_t>(reason)];
+        out += '"';
+        if (decode && ok) {
+            appendDecoded(records[i], decoded[i], out);
+        }
+        out += '}';
+    }
+    return valid;
+}
+
+static const char* statusText(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 413: return "Payload Too Large";
+        case 431: return "Request Header Fields Too Large";
+        case 501: return "Not Implemented";
+        case 505: return "HTTP Version Not Supported";
+        default:  return "Error";
+    }
+}
+
+static const char* errorMessage(int status) {
+    switch (status) {
+        case 404: return "endpoint inesistente";
+        case 405: return "metodo non supportato";
+        case 413: return "corpo della richiesta troppo grande";
+        case 431: return "intestazioni troppo lunghe";
+        case 501: return "Transfer-Encoding non supportato: usare Content-Length";
+        case 505: return "versione HTTP non supportata";
+        default:  return "richiesta non valida";
+    }
+}
+
+static bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        const char x = a[i] >= 'A' && a[i] <= 'Z' ? static_cast<char>(a[i] + 32) : a[i];
+        if (x != b[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Cerca un valore in un'intestazione con elenco separato da virgole (es. Connection).
+ */
+static bool hasToken(std::string_view value, std::string_view token) {
+    while (!value.empty()) {
+        const size_t end = std::min(value.find(','), value.size());
+        std::string_view item = value.substr(0, end);
+        value.remove_prefix(std::min(end + 1, value.size()));
+        while (!item.empty() && isSpace(item.front())) {
+            item.remove_prefix(1);
+        }
+        while (!item.empty() && isSpace(item.back())) {
+            item.remove_suffix(1);
+        }
+        if (equalsIgnoreCase(item, token)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ============================================================================
+// Connessione
+// ============================================================================
+
+ServiceConnection::ServiceConnection(const ServiceStats& stats) : m_stats(stats) {}
+
+bool ServiceConnection::feed(const char* data, size_t length, ServiceCounters& counters, std::string& out) {
+    // Senza byte in sospeso le richieste vengono lette direttamente dal blocco ricevuto
+    std::string_view input(data, length);
+    if (!m_input.empty()) {
+        m_input.append(data, length);
+        input = m_input;
+    }
+
+    size_t consumed = 0;
+    bool open = true;
+    while (open && consumed < input.size()) {
+        Request request;
+        const Parse result = parseRequest(input.substr(consumed), request);
+        if (result == Parse::Incomplete) {
+            if (request.expectContinue && !m_continueSent) {
+                out += "HTTP/1.1 100 Continue\r\n\r\n";
+                m_continueSent = true;
+            }
+            break;
+        }
+        if (result == Parse::Invalid) {
+            // La richiesta non si puo' delimitare: risposta di errore e chiusura
+            setError(request.error, errorMessage(request.error));
+            writeResponse(request.error, false, request.http10, out);
+            ServiceCounters::add(counters.requests, 1);
+            ServiceCounters::add(counters.errors, 1);
+            open = false;
+            break;
+        }
+        m_continueSent = false;
+        handleRequest(request, counters, out);
+        consumed += request.size;
+        open = request.keepAlive;
+    }
+
+    if (!open) {
+        m_input.clear();
+        return false;
+    }
+    if (input.data() == m_input.data()) {
+        m_input.erase(0, consumed);
+    } else {
+        m_input.assign(input.substr(consumed));
+    }
+    if (m_input.empty() && m_input.capacity() > IDLE_BUFFER_BYTES) {
+        m_input.shrink_to_fit();
+    }
+    if (m_body.capacity() > IDLE_BUFFER_BYTES) {
+        m_body.clear();
+        m_body.shrink_to_fit();
+    }
+    return true;
+}
+
+ServiceConnection::Parse ServiceConnection::parseRequest(std::string_view input, Request& request) const {
+    const size_t headerEnd = input.find("\r\n\r\n");
+    if (headerEnd == input.npos || headerEnd + 4 > SERVICE_MAX_HEADER_BYTES) {
+        if (headerEnd == input.npos && input.size() <= SERVICE_MAX_HEADER_BYTES) {
+            return Parse::Incomplete;
+        }
+        request.error = 431;
+        return Parse::Invalid;
+    }
+    const std::string_view head = input.substr(0, headerEnd);
+    request.error = 400;
+
+    // Riga di richiesta: METODO destinazione HTTP/1.x
+    const size_t lineEnd = std::min(head.find("\r\n"), head.size());
+    const std::string_view line = head.substr(0, lineEnd);
+    const size_t space1 = line.find(' ');
+    const size_t space2 = space1 == line.npos ? line.npos : line.find(' ', space1 + 1);
+    if (space2 == line.npos) {
+        return Parse::Invalid;
+    }
+    request.method = line.substr(0, space1);
+    const std::string_view target = line.substr(space1 + 1, space2 - space1 - 1);
+    const std::string_view version = line.substr(space2 + 1);
+    if (version == "HTTP/1.0") {
+        request.keepAlive = false;
+        request.http10 = true;
+    } else if (version != "HTTP/1.1") {
+        request.error = 505;
+        return Parse::Invalid;
+    }
+    const size_t question = target.find('?');
+    request.path = target.substr(0, question);
+    request.query = question == target.npos ? std::string_view() : target.substr(question + 1);
+
+    // Intestazioni
+    size_t contentLength = 0;
+    size_t pos = lineEnd + 2;
+    while (pos < head.size()) {
+        const size_t end = std::min(head.find("\r\n", pos), head.size());
+        const std::string_view header = head.substr(pos, end - pos);
+        pos = end + 2;
+        const size_t colon = header.find(':');
+        if (colon == header.npos) {
+            return Parse::Invalid;
+        }
+        const std::string_view name = header.substr(0, colon);
+        std::string_view value = header.substr(colon + 1);
+        while (!value.empty() && isSpace(value.front())) {
+            value.remove_prefix(1);
+        }
+        while (!value.empty() && isSpace(value.back())) {
+            value.remove_suffix(1);
+        }
+
+        if (equalsIgnoreCase(name, "content-length")) {
+            const auto result = std::from_chars(value.data(), value.data() + value.size(), contentLength);
+            if (result.ec != std::errc() || result.ptr != value.data() + value.size()) {
+                return Parse::Invalid;
+            }
+            if (contentLength > SERVICE_MAX_BODY_BYTES) {
+                request.error = 413;
+                return Parse::Invalid;
+            }
+        } else if (equalsIgnoreCase(name, "transfer-encoding")) {
+            request.error = 501;
+            return Parse::Invalid;
+        } else if (equalsIgnoreCase(name, "connection")) {
+            if (hasToken(value, "close")) {
+                request.keepAlive = false;
+            } else if (hasToken(value, "keep-alive")) {
+                request.keepAlive = true;
+            }
+        } else if (equalsIgnoreCase(name, "expect")) {
+            request.expectContinue = hasToken(value, "100-continue");
+        }
+    }
+    request.error = 0;
+
+    const size_t bodyStart = headerEnd + 4;
+    if (input.size() - bodyStart < contentLength) {
+        return Parse::Incomplete;
+    }
+    request.body = input.substr(bodyStart, contentLength);
+    request.size = bodyStart + contentLength;
+    return Parse::Complete;
+}
+
+void ServiceConnection::handleRequest(const Request& request, ServiceCounters& counters, std::string& out) {
+    const bool get = request.method == "GET";
+    const bool post = request.method == "POST";
+    int status = 200;
+
+    if (request.path == "/validate" || request.path == "/decode") {
+        const bool decode = request.path == "/decode";
+        if (get) {
+            // Un solo codice: lo si riporta alla forma JSON del corpo di una POST
+            std::string_view json;
+            if (queryParameter(request.query, "cf", m_query)) {
+                m_body.clear();
+                appendJsonString(m_body, m_query);
+                m_query.swap(m_body);
+                json = m_query;
+            }
+            if (json.empty() || !handleCodes(json, decode, counters)) {
+                status = 400;
+                setError(status, "parametro cf mancante");
+            }
+        } else if (post) {
+            if (!handleCodes(request.body, decode, counters)) {
+                status = 400;
+                setError(status, "JSON non valido: atteso un codice o un array di codici");
+            }
+        } else {
+            status = 405;
+        }
+    } else if (request.path == "/extract") {
+        if (get) {
+            if (queryParameter(request.query, "text", m_query)) {
+                handleExtract(m_query, counters);
+            } else {
+                status = 400;
+                setError(status, "parametro text mancante");
+            }
+        } else if (post) {
+            handleExtract(request.body, counters);
+        } else {
+            status = 405;
+        }
+    } else if (request.path == "/stats") {
+        if (get) {
+            handleStats();
+        } else {
+            status = 405;
+        }
+    } else {
+        status = 404;
+    }
+
+    if (status == 404 || status == 405) {
+        setError(status, errorMessage(status));
+    }
+    ServiceCounters::add(counters.requests, 1);
+    if (status >= 400) {
+        ServiceCounters::add(counters.errors, 1);
+    }
+    writeResponse(status, request.keepAlive, request.http10, out);
+}
+
+/**
+ * Il corpo e' una stringa JSON (un codice, risposta con un oggetto) o un
+ * array di stringhe (risposta con un array nello stesso ordine). I codici
+ * vengono letti a gruppi di 64 direttamente nei buffer UTF-16 sullo stack.
+ */
+bool ServiceConnection::handleCodes(std::string_view json, bool decode, ServiceCounters& counters) {
+    size_t pos = skipSpace(json, 0);
+    const bool array = pos < json.size() && json[pos] == '[';
+    if (array) {
+        pos = skipSpace(json, pos + 1);
+    }
+    const uint32_t referenceDate = decode ? today() : 0;
+
+    char16_t records[CODE_GROUP][16];
+    size_t lengths[CODE_GROUP];
+    std::string_view raws[CODE_GROUP];
+    size_t grouped = 0;
+    uint64_t total = 0;
+    uint64_t valid = 0;
+    m_body.assign(array ? "[" : "");
+
+    if (array && pos < json.size() && json[pos] == ']') {
+        pos++;
+    } else {
+        for (;;) {
+            if (pos >= json.size() || json[pos] != '"' ||
+                !readJsonString(json, pos, records[grouped], lengths[grouped], raws[grouped])) {
+                return false;
+            }
+            total++;
+            if (++grouped == CODE_GROUP) {
+                valid += appendResults(records, lengths, raws, grouped, decode, referenceDate, m_body);
+                grouped = 0;
+            }
+            if (!array) {
+                break;
+            }
+            pos = skipSpace(json, pos);
+            if (pos < json.size() && json[pos] == ',') {
+                pos = skipSpace(json, pos + 1);
+            } else if (pos < json.size() && json[pos] == ']') {
+                pos++;
+                break;
+            } else {
+                return false;
+            }
+        }
+    }
+    if (skipSpace(json, pos) != json.size()) {
+        return false;
+    }
+    if (grouped > 0) {
+        valid += appendResults(records, lengths, raws, grouped, decode, referenceDate, m_body);
+    }
+    if (array) {
+        m_body += ']';
+    }
+    ServiceCounters::add(counters.codes, total);
+    ServiceCounters::add(counters.validCodes, valid);
+    return true;
+}
+
+void ServiceConnection::handleExtract(std::string_view text, ServiceCounters& counters) {
+    m_body.assign("[");
+    uint64_t found = 0;
+    size_t pos = findCodiceFiscale(text, 0);
+    while (pos != text.npos) {
+        const std::string_view code = text.substr(pos, CF_LENGTH);
+        const bool valid = verifyCIN(code);
+        char normalized[CF_LENGTH];
+        normalizeOmocodia(code, normalized);
+        if (valid) {
+            normalized[CF_LENGTH - 1] = calculateCIN(std::string_view(normalized, CF_LENGTH));
+        }
+
+        if (found > 0) {
+            m_body += ',';
+        }
+        m_body += "{\"offset\":";
+        appendNumber(m_body, pos);
+        m_body += ",\"cf\":\"";
+        m_body += code;
+        m_body += valid ? "\",\"valid\":true" : "\",\"valid\":false";
+        m_body += ",\"normalized\":\"";
+        m_body.append(normalized, CF_LENGTH);
+        m_body += "\"}";
+        found++;
+        pos = findCodiceFiscale(text, pos + CF_LENGTH);
+    }
+    m_body += ']';
+    ServiceCounters::add(counters.extracted, found);
+}
+
+void ServiceConnection::handleStats() {
+    const ServiceTotals totals = m_stats.getTotals();
+    m_body.assign("{\"threads\":");
+    appendNumber(m_body, m_stats.getShardCount());
+    m_body += ",\"connections\":";
+    appendNumber(m_body, totals.connections);
+    m_body += ",\"requests\":";
+    appendNumber(m_body, totals.requests);
+    m_body += ",\"errors\":";
+    appendNumber(m_body, totals.errors);
+    m_body += ",\"codes\":";
+    appendNumber(m_body, totals.codes);
+    m_body += ",\"valid_codes\":";
+    appendNumber(m_body, totals.validCodes);
+    m_body += ",\"extracted\":";
+    appendNumber(m_body, totals.extracted);
+    m_body += '}';
+}
+
+void ServiceConnection::setError(int status, const char* message) {
+    m_body.assign("{\"error\":");
+    appendJsonString(m_body, message);
+    m_body += ",\"status\":";
+    appendNumber(m_body, static_cast<uint64_t>(status));
+    m_body += '}';
+}
+
+void ServiceConnection::writeResponse(int status, bool keepAlive, bool http10, std::string& out) const {
+    // In HTTP/1.1 la connessione resta aperta salvo "close"; un client
+    // HTTP/1.0 che chiede keep-alive attende invece la conferma esplicita,
+    // altrimenti aspetta la chiusura per considerare finita la risposta
+    const char* connection = !keepAlive ? "Connection: close\r\n" : (http10 ? "Connection: keep-alive\r\n" : "");
+    char header[192];
+    const int length = std::snprintf(header, sizeof(header),
+                                     "HTTP/1.1 %d %s\r\nContent-Type: application/json; charset=utf-8\r\n"
+                                     "Content-Length: %zu\r\n%s\r\n",
+                                     status, statusText(status), m_body.size(), connection);
+    out.append(header, static_cast<size_t>(length));
+    out += m_body;
+}
+
+} // namespace cfparser
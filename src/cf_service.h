@@ -0,0 +1,145 @@
+#ifndef CF_SERVICE_H
+#define CF_SERVICE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace cfparser {
+
+/// Dimensione massima della riga di richiesta e delle intestazioni
+constexpr size_t SERVICE_MAX_HEADER_BYTES = 8 * 1024;
+
+/// Dimensione massima del corpo di una richiesta
+constexpr size_t SERVICE_MAX_BODY_BYTES = 4 * 1024 * 1024;
+
+/**
+ * @brief Contatori di un thread del servizio (una linea di cache ciascuno).
+ *
+ * Ogni contatore e' scritto solo dal thread proprietario: gli incrementi
+ * non contendono la linea di cache con gli altri thread e /stats li somma
+ * leggendoli senza sincronizzazione.
+ */
+struct alignas(64) ServiceCounters {
+    std::atomic<uint64_t> connections{0};   ///< Connessioni accettate
+    std::atomic<uint64_t> requests{0};      ///< Richieste elaborate
+    std::atomic<uint64_t> errors{0};        ///< Risposte 4xx e 5xx
+    std::atomic<uint64_t> codes{0};         ///< Codici verificati o decodificati
+    std::atomic<uint64_t> validCodes{0};    ///< ...di cui validi
+    std::atomic<uint64_t> extracted{0};     ///< Codici trovati da /extract
+
+    /**
+     * @brief Incrementa un contatore di questo thread.
+     */
+    static void add(std::atomic<uint64_t>& counter, uint64_t value) {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief Somma dei contatori di tutti i thread.
+ */
+struct ServiceTotals {
+    uint64_t connections = 0;
+    uint64_t requests = 0;
+    uint64_t errors = 0;
+    uint64_t codes = 0;
+    uint64_t validCodes = 0;
+    uint64_t extracted = 0;
+};
+
+/**
+ * @brief Contatori del servizio divisi per thread.
+ */
+class ServiceStats {
+public:
+    /**
+     * @param shards Numero di thread del servizio
+     */
+    explicit ServiceStats(unsigned shards);
+
+    ServiceCounters& getShard(unsigned index) { return m_shards[index]; }
+    unsigned getShardCount() const { return m_count; }
+
+    /**
+     * @brief Somma i contatori di tutti i thread (valori approssimati se il servizio e' attivo).
+     */
+    ServiceTotals getTotals() const;
+
+private:
+    std::unique_ptr<ServiceCounters[]> m_shards;
+    unsigned m_count;
+};
+
+/**
+ * @brief Protocollo HTTP/1.1 di una connessione al servizio di verifica.
+ *
+ * Non usa socket: il ciclo di I/O (cf_server.h) passa a feed() i byte
+ * ricevuti e invia i byte che feed() aggiunge alla risposta. Piu' richieste
+ * nello stesso blocco (pipelining) vengono elaborate in ordine e le
+ * risposte accodate nello stesso ordine; una richiesta incompleta resta in
+ * attesa del blocco successivo.
+ *
+ * Endpoint (GET con ?cf=..., oppure POST con un corpo JSON che contiene
+ * un codice o un array di codici):
+ *   /validate   esito della verifica
+ *   /decode     verifica, forma normalizzata, data di nascita, sesso, eta'
+ *               e luogo di nascita (con place_plausible = false se il codice
+ *               catastale non esisteva alla data di nascita)
+ *   /extract    codici fiscali trovati nel corpo (testo qualsiasi, POST) o
+ *               in ?text=... (GET)
+ *   /stats      contatori del servizio
+ *
+ * I lotti vengono verificati con validateBatch() e decodificati con
+ * decodeBatch() a gruppi di 64; i buffer sono riusati tra le richieste.
+ */
+class ServiceConnection {
+public:
+    explicit ServiceConnection(const ServiceStats& stats);
+
+    /**
+     * @brief Elabora i byte ricevuti e aggiunge a out le risposte complete.
+     *
+     * @param counters Contatori del thread che esegue la chiamata
+     * @return false se la connessione va chiusa dopo l'invio di out
+     *         (Connection: close, HTTP/1.0 senza keep-alive o richiesta non valida)
+     */
+    bool feed(const char* data, size_t length, ServiceCounters& counters, std::string& out);
+
+private:
+    /// Esito dell'analisi dell'inizio del buffer
+    enum class Parse { Incomplete, Complete, Invalid };
+
+    struct Request {
+        std::string_view method;
+        std::string_view path;
+        std::string_view query;
+        std::string_view body;
+        size_t size = 0;                ///< Byte occupati da intestazioni e corpo
+        bool keepAlive = true;
+        bool http10 = false;            ///< HTTP/1.0: la persistenza va dichiarata nella risposta
+        bool expectContinue = false;    ///< Expect: 100-continue
+        int error = 0;                  ///< Stato HTTP se la richiesta non e' accettabile
+    };
+
+    Parse parseRequest(std::string_view input, Request& request) const;
+    void handleRequest(const Request& request, ServiceCounters& counters, std::string& out);
+    bool handleCodes(std::string_view json, bool decode, ServiceCounters& counters);
+    void handleExtract(std::string_view text, ServiceCounters& counters);
+    void handleStats();
+    void writeResponse(int status, bool keepAlive, bool http10, std::string& out) const;
+    void setError(int status, const char* message);
+
+    const ServiceStats& m_stats;
+    std::string m_input;            ///< Byte ricevuti non ancora elaborati
+    std::string m_body;             ///< Corpo della risposta in costruzione (riusato)
+    std::string m_query;            ///< Parametro decodificato dalla query (riusato)
+    bool m_continueSent = false;    ///< "100 Continue" gia' inviato per la richiesta in corso
+};
+
+} // namespace cfparser
+
+#endif // CF_SERVICE_H
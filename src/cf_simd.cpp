@@ -0,0 +1,789 @@
+#include "cf_simd.h"
+#include "cf_parser.h"
+#include "bit_util.h"
+#include <algorithm>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define CF_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// Le funzioni AVX2 vengono compilate anche senza /arch:AVX2 e chiamate solo
+// se la CPU le supporta (GCC/Clang richiedono l'attributo target).
+#if defined(__GNUC__) || defined(__clang__)
+#define CF_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define CF_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define CF_TARGET_SSSE3
+#define CF_TARGET_AVX2
+#endif
+
+namespace cfparser {
+namespace simd {
+
+// Blocco di classificazione: una maschera a 64 bit per blocco
+static constexpr size_t BLOCK = 64;
+
+// Posizioni (0-based) che devono contenere una lettera
+static constexpr int LETTER_POSITIONS[] = {0, 1, 2, 3, 4, 5, 8, 11, 15};
+
+// Posizioni (0-based) che devono contenere una cifra o una lettera omocodica
+static constexpr int NUMERIC_POSITIONS[] = {6, 7, 9, 10, 12, 13, 14};
+
+// ============================================================================
+// Rilevamento CPU
+// ============================================================================
+
+static Level detectLevelUncached() {
+#if defined(CF_SIMD_X86)
+#if defined(_MSC_VER)
+    int info[4] = {0};
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    const bool ssse3 = (info[2] & (1 << 9)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+        __cpuidex(info, 7, 0);
+        if (info[1] & (1 << 5)) {
+            return Level::AVX2;
+        }
+    }
+    return ssse3 ? Level::SSSE3 : Level::SSE2;
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return Level::AVX2;
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+        return Level::SSSE3;
+    }
+    return __builtin_cpu_supports("sse2") ? Level::SSE2 : Level::Scalar;
+#endif
+#else
+    return Level::Scalar;
+#endif
+}
+
+Level detectLevel() {
+    static const Level level = detectLevelUncached();
+    return level;
+}
+
+// ============================================================================
+// Classificazione dei blocchi
+// ============================================================================
+
+/**
+ * @brief Classifica fino a 64 code unit.
+ *
+ * letters: bit i = 1 se text[i] e' una lettera ASCII; numeric: bit i = 1 se
+ * text[i] puo' stare in una posizione numerica (cifra o lettera omocodica
+ * LMNPQRSTUV). Lettere e cifre insieme danno gli alfanumerici.
+ */
+template <typename CharT>
+static void classifyScalar(const CharT* text, size_t n, uint64_t& letters, uint64_t& numeric) {
+    letters = 0;
+    numeric = 0;
+    for (size_t i = 0; i < n; i++) {
+        const uint32_t c = static_cast<uint32_t>(text[i]);
+        const uint32_t lower = c | 0x20;
+        const uint64_t bit = uint64_t(1) << i;
+        if (lower - 'a' < 26) {
+            letters |= bit;
+            if (lower - 'l' < 11 && lower != 'o') {
+                numeric |= bit;
+            }
+        } else if (c - '0' < 10) {
+            numeric |= bit;
+        }
+    }
+}
+
+#if defined(CF_SIMD_X86)
+
+/**
+ * @brief Classifica 8 code unit: restituisce le maschere a 16 bit (0xFFFF per lane).
+ */
+static inline void classify8(__m128i c, __m128i& letter, __m128i& numeric) {
+    const __m128i zero = _mm_setzero_si128();
+    // (c | 0x20) - 'a' <= 25  <=>  saturazione a zero dopo aver sottratto 25
+    const __m128i lower = _mm_or_si128(c, _mm_set1_epi16(0x20));
+    letter = _mm_cmpeq_epi16(_mm_subs_epu16(_mm_sub_epi16(lower, _mm_set1_epi16('a')),
+                                            _mm_set1_epi16(25)), zero);
+    // Omocodia: 'l'..'v' tranne 'o'
+    const __m128i omocode = _mm_andnot_si128(
+        _mm_cmpeq_epi16(lower, _mm_set1_epi16('o')),
+        _mm_cmpeq_epi16(_mm_subs_epu16(_mm_sub_epi16(lower, _mm_set1_epi16('l')),
+                                       _mm_set1_epi16(10)), zero));
+    const __m128i rebased = _mm_sub_epi16(c, _mm_set1_epi16('0'));
+    const __m128i digit = _mm_cmpeq_epi16(_mm_subs_epu16(rebased, _mm_set1_epi16(9)), zero);
+    numeric = _mm_or_si128(digit, omocode);
+}
+
+static void classifySSE2(const char16_t* text, uint64_t& letters, uint64_t& numeric) {
+    letters = 0;
+    numeric = 0;
+    for (size_t i = 0; i < BLOCK; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i + 8));
+        __m128i la, na, lb, nb;
+        classify8(a, la, na);
+        classify8(b, lb, nb);
+        const uint64_t l = static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(la, lb)));
+        const uint64_t n = static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(na, nb)));
+        letters |= l << i;
+        numeric |= n << i;
+    }
+}
+
+CF_TARGET_AVX2
+static inline void classify16(__m256i c, __m256i& letter, __m256i& numeric) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i lower = _mm256_or_si256(c, _mm256_set1_epi16(0x20));
+    letter = _mm256_cmpeq_epi16(_mm256_subs_epu16(_mm256_sub_epi16(lower, _mm256_set1_epi16('a')),
+                                                  _mm256_set1_epi16(25)), zero);
+    const __m256i omocode = _mm256_andnot_si256(
+        _mm256_cmpeq_epi16(lower, _mm256_set1_epi16('o')),
+        _mm256_cmpeq_epi16(_mm256_subs_epu16(_mm256_sub_epi16(lower, _mm256_set1_epi16('l')),
+                                             _mm256_set1_epi16(10)), zero));
+    const __m256i rebased = _mm256_sub_epi16(c, _mm256_set1_epi16('0'));
+    const __m256i digit = _mm256_cmpeq_epi16(_mm256_subs_epu16(rebased, _mm256_set1_epi16(9)), zero);
+    numeric = _mm256_or_si256(digit, omocode);
+}
+
+CF_TARGET_AVX2
+static void classifyAVX2(const char16_t* text, uint64_t& letters, uint64_t& numeric) {
+    letters = 0;
+    numeric = 0;
+    for (size_t i = 0; i < BLOCK; i += 32) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i + 16));
+        __m256i la, na, lb, nb;
+        classify16(a, la, na);
+        classify16(b, lb, nb);
+        // packs lavora per lane da 128 bit: riordina i quadword 0,2,1,3
+        const __m256i l = _mm256_permute4x64_epi64(_mm256_packs_epi16(la, lb), 0xD8);
+        const __m256i n = _mm256_permute4x64_epi64(_mm256_packs_epi16(na, nb), 0xD8);
+        letters |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(l))) << i;
+        numeric |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(n))) << i;
+    }
+}
+
+/**
+ * @brief Classifica 16 byte: restituisce le maschere per byte (0xFF per lane).
+ */
+static inline void classifyBytes16(__m128i c, __m128i& letter, __m128i& numeric) {
+    const __m128i zero = _mm_setzero_si128();
+    // Come classify8, con aritmetica a 8 bit: i byte >= 0x80 non rientrano
+    // in nessuno degli intervalli
+    const __m128i lower = _mm_or_si128(c, _mm_set1_epi8(0x20));
+    letter = _mm_cmpeq_epi8(_mm_subs_epu8(_mm_sub_epi8(lower, _mm_set1_epi8('a')),
+                                          _mm_set1_epi8(25)), zero);
+    const __m128i omocode = _mm_andnot_si128(
+        _mm_cmpeq_epi8(lower, _mm_set1_epi8('o')),
+        _mm_cmpeq_epi8(_mm_subs_epu8(_mm_sub_epi8(lower, _mm_set1_epi8('l')),
+                                     _mm_set1_epi8(10)), zero));
+    const __m128i rebased = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    const __m128i digit = _mm_cmpeq_epi8(_mm_subs_epu8(rebased, _mm_set1_epi8(9)), zero);
+    numeric = _mm_or_si128(digit, omocode);
+}
+
+static void classifyBytesSSE2(const char* text, uint64_t& letters, uint64_t& numeric) {
+    letters = 0;
+    numeric = 0;
+    for (size_t i = 0; i < BLOCK; i += 16) {
+        __m128i l, n;
+        classifyBytes16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i)), l, n);
+        letters |= uint64_t(static_cast<uint32_t>(_mm_movemask_epi8(l))) << i;
+        numeric |= uint64_t(static_cast<uint32_t>(_mm_movemask_epi8(n))) << i;
+    }
+}
+
+CF_TARGET_AVX2
+static void classifyBytesAVX2(const char* text, uint64_t& letters, uint64_t& numeric) {
+    const __m256i zero = _mm256_setzero_si256();
+    letters = 0;
+    numeric = 0;
+    for (size_t i = 0; i < BLOCK; i += 32) {
+        const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+        const __m256i lower = _mm256_or_si256(c, _mm256_set1_epi8(0x20));
+        const __m256i l = _mm256_cmpeq_epi8(
+            _mm256_subs_epu8(_mm256_sub_epi8(lower, _mm256_set1_epi8('a')), _mm256_set1_epi8(25)), zero);
+        const __m256i omocode = _mm256_andnot_si256(
+            _mm256_cmpeq_epi8(lower, _mm256_set1_epi8('o')),
+            _mm256_cmpeq_epi8(_mm256_subs_epu8(_mm256_sub_epi8(lower, _mm256_set1_epi8('l')),
+                                               _mm256_set1_epi8(10)), zero));
+        const __m256i rebased = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+        const __m256i digit = _mm256_cmpeq_epi8(_mm256_subs_epu8(rebased, _mm256_set1_epi8(9)), zero);
+        const __m256i n = _mm256_or_si256(digit, omocode);
+        letters |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(l))) << i;
+        numeric |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(n))) << i;
+    }
+}
+
+#endif // CF_SIMD_X86
+
+template <typename CharT>
+static void classifyBlock(const CharT* text, size_t n, Level level,
+                          uint64_t& letters, uint64_t& numeric) {
+#if defined(CF_SIMD_X86)
+    if constexpr (sizeof(CharT) == 2) {
+        if (n == BLOCK && level == Level::AVX2) {
+            classifyAVX2(reinterpret_cast<const char16_t*>(text), letters, numeric);
+            return;
+        }
+        if (n == BLOCK && level != Level::Scalar) {
+            classifySSE2(reinterpret_cast<const char16_t*>(text), letters, numeric);
+            return;
+        }
+    }
+    if constexpr (sizeof(CharT) == 1) {
+        if (n == BLOCK && level == Level::AVX2) {
+            classifyBytesAVX2(reinterpret_cast<const char*>(text), letters, numeric);
+            return;
+        }
+        if (n == BLOCK && level != Level::Scalar) {
+            classifyBytesSSE2(reinterpret_cast<const char*>(text), letters, numeric);
+            return;
+        }
+    }
+#endif
+    (void)level;
+    classifyScalar(text, n, letters, numeric);
+}
+
+// ============================================================================
+// Ricerca dei candidati
+// ============================================================================
+
+/**
+ * @brief Bit [k, k+64) della concatenazione (hi:lo).
+ */
+static inline uint64_t shiftPair(uint64_t lo, uint64_t hi, int k) {
+    return k == 0 ? lo : (lo >> k) | (hi << (64 - k));
+}
+
+/**
+ * @brief Maschera degli inizi di finestra validi nel blocco corrente.
+ *
+ * lo/hi sono le maschere del blocco corrente e del successivo.
+ */
+static inline uint64_t candidateMask(uint64_t lettersLo, uint64_t lettersHi,
+                                     uint64_t numericLo, uint64_t numericHi) {
+    // 16 alfanumerici consecutivi (raddoppio: 1, 2, 4, 8 posizioni)
+    uint64_t runLo = lettersLo | numericLo, runHi = lettersHi | numericHi;
+    for (int k = 1; k < 16; k *= 2) {
+        runLo &= shiftPair(runLo, runHi, k);
+        runHi &= runHi >> k;
+    }
+
+    uint64_t mask = runLo;
+    for (int pos : LETTER_POSITIONS) {
+        mask &= shiftPair(lettersLo, lettersHi, pos);
+    }
+    for (int pos : NUMERIC_POSITIONS) {
+        mask &= shiftPair(numericLo, numericHi, pos);
+    }
+    return mask;
+}
+
+template <typename CharT>
+static size_t findCandidateImpl(const CharT* text, size_t length, size_t from, Level level) {
+    if (length < 16 || from > length - 16) {
+        return SIZE_MAX;
+    }
+
+    const size_t lastStart = length - 16;
+    size_t base = from;
+
+    uint64_t lettersLo, numericLo, lettersHi, numericHi;
+    classifyBlock(text + base, std::min(BLOCK, length - base), level, lettersLo, numericLo);
+
+    while (base <= lastStart) {
+        const size_t nextBase = base + BLOCK;
+        if (nextBase < length) {
+            classifyBlock(text + nextBase, std::min(BLOCK, length - nextBase), level,
+                          lettersHi, numericHi);
+        } else {
+            lettersHi = numericHi = 0;
+        }
+
+        const uint64_t mask = candidateMask(lettersLo, lettersHi, numericLo, numericHi);
+        if (mask != 0) {
+            const size_t offset = base + lowestBit(mask);
+            return offset <= lastStart ? offset : SIZE_MAX;
+        }
+
+        base = nextBase;
+        lettersLo = lettersHi;
+        numericLo = numericHi;
+    }
+
+    return SIZE_MAX;
+}
+
+size_t findCandidate(const char16_t* text, size_t length, size_t from, Level level) {
+    return findCandidateImpl(text, length, from, level);
+}
+
+size_t findCandidate(const char16_t* text, size_t length, size_t from) {
+    return findCandidateImpl(text, length, from, detectLevel());
+}
+
+size_t findCandidate(const wchar_t* text, size_t length, size_t from) {
+    if constexpr (sizeof(wchar_t) == sizeof(char16_t)) {
+        return findCandidateImpl(reinterpret_cast<const char16_t*>(text), length, from,
+                                 detectLevel());
+    } else {
+        return findCandidateImpl(text, length, from, Level::Scalar);
+    }
+}
+
+size_t findCandidate(const char* text, size_t length, size_t from, Level level) {
+    return findCandidateImpl(reinterpret_cast<const unsigned char*>(text), length, from, level);
+}
+
+size_t findCandidate(const char* text, size_t length, size_t from) {
+    return findCandidateImpl(reinterpret_cast<const unsigned char*>(text), length, from,
+                             detectLevel());
+}
+
+// ============================================================================
+// Verifica di 16 caratteri
+// ============================================================================
+
+// Classi (tabella A): un bit per insieme della grammatica
+static constexpr uint8_t A_LETTER = 0x01;
+static constexpr uint8_t A_VOWEL  = 0x02;
+static constexpr uint8_t A_VX     = 0x04;   // vocale o X
+static constexpr uint8_t A_DIGIT  = 0x08;   // cifra o omocodia
+static constexpr uint8_t A_NZ     = 0x10;   // cifra diversa da 0
+static constexpr uint8_t A_ZERO   = 0x20;   // 0 o L
+static constexpr uint8_t A_BEL_AM = 0x40;
+static constexpr uint8_t A_BEL_Z  = 0x80;
+
+// Classi (tabella B): mese e giorno
+static constexpr uint8_t B_FEB       = 0x01;
+static constexpr uint8_t B_MONTH_30  = 0x02;
+static constexpr uint8_t B_MONTH_31  = 0x04;
+static constexpr uint8_t B_TENS_NZ   = 0x08;
+static constexpr uint8_t B_TENS_ANY  = 0x10;
+static constexpr uint8_t B_TENS_3    = 0x20;
+static constexpr uint8_t B_UNITS_01  = 0x40;
+
+/**
+ * @brief Tabella indicizzata per simbolo (0-35), estesa a 48 byte per PSHUFB.
+ */
+struct SymbolTable {
+    alignas(16) uint8_t v[48];
+};
+
+static constexpr uint8_t classA(uint8_t s) {
+    using namespace matcher;
+    return (contains(LETTERS, s) ? A_LETTER : 0) |
+           (contains(VOWELS, s) ? A_VOWEL : 0) |
+           (contains(VOWELS_X, s) ? A_VX : 0) |
+           (contains(DIGIT, s) ? A_DIGIT : 0) |
+           (contains(DIGIT_NZ, s) ? A_NZ : 0) |
+           (contains(DIGIT_0, s) ? A_ZERO : 0) |
+           (contains(BELFIORE_AM, s) ? A_BEL_AM : 0) |
+           (contains(BELFIORE_Z, s) ? A_BEL_Z : 0);
+}
+
+static constexpr uint8_t classB(uint8_t s) {
+    using namespace matcher;
+    return (s == symbolOf('B') ? B_FEB : 0) |
+           (contains(MONTHS_30, s) ? B_MONTH_30 : 0) |
+           (contains(MONTHS_31, s) ? B_MONTH_31 : 0) |
+           (contains(DAY_TENS_NZ, s) ? B_TENS_NZ : 0) |
+           (contains(DAY_TENS_ANY, s) ? B_TENS_ANY : 0) |
+           (contains(DAY_TENS_3, s) ? B_TENS_3 : 0) |
+           (contains(DAY_UNITS_01, s) ? B_UNITS_01 : 0);
+}
+
+template <typename F>
+static constexpr SymbolTable makeTable(F f) {
+    SymbolTable t{};
+    for (uint8_t s = 0; s < 36; s++) {
+        t.v[s] = f(s);
+    }
+    return t;
+}
+
+static constexpr SymbolTable CLASS_A = makeTable(classA);
+static constexpr SymbolTable CLASS_B = makeTable(classB);
+static constexpr SymbolTable CIN_ODD = makeTable([](uint8_t s) { return matcher::CIN_ODD_VALUES[s]; });
+static constexpr SymbolTable CIN_EVEN = makeTable([](uint8_t s) { return matcher::CIN_EVEN_VALUES[s]; });
+
+/// Campo non valido -> esito, nell'ordine delle posizioni
+static constexpr matcher::Reason FIELD_REASON[] = {
+    matcher::Reason::InvalidSurname, matcher::Reason::InvalidName,
+    matcher::Reason::InvalidYear, matcher::Reason::InvalidMonth,
+    matcher::Reason::InvalidDay, matcher::Reason::InvalidBelfiore,
+    matcher::Reason::InvalidCIN
+};
+
+/**
+ * @brief Verifica una terna cognome/nome sulle classi dei tre caratteri.
+ *
+ * Lettere in tutte e tre le posizioni; dopo una vocale serve una vocale, e
+ * dopo una vocale in seconda posizione serve una vocale o una X.
+ */
+static inline bool tripletOk(uint8_t a0, uint8_t a1, uint8_t a2) {
+    return (a0 & a1 & a2 & A_LETTER) &&
+           (!(a0 & A_VOWEL) | !!(a1 & A_VOWEL)) &&
+           (!(a1 & A_VOWEL) | !!(a2 & A_VX));
+}
+
+/**
+ * @brief Applica i vincoli tra posizioni alle classi gia' calcolate.
+ */
+static matcher::Reason checkFields(const uint8_t* a, const uint8_t* b, int cinSum, uint8_t cinSymbol) {
+    const bool dayOk =
+        ((b[9] & B_TENS_NZ) && (a[10] & A_NZ)) |
+        ((b[9] & B_TENS_ANY) && (a[10] & A_DIGIT)) |
+        ((b[9] & B_TENS_3) && (((b[8] & B_MONTH_30) && (a[10] & A_ZERO)) |
+                               ((b[8] & B_MONTH_31) && (b[10] & B_UNITS_01))));
+
+    const bool belfioreOk =
+        ((a[11] & (A_BEL_AM | A_BEL_Z)) && (a[12] & A_NZ) && (a[13] & a[14] & A_DIGIT)) |
+        ((a[11] & A_BEL_AM) && (a[12] & A_ZERO) &&
+         (((a[13] & A_NZ) && (a[14] & A_DIGIT)) | ((a[13] & A_ZERO) && (a[14] & A_NZ))));
+
+    const bool cinOk = (a[15] & A_LETTER) && cinSymbol == 10 + cinSum % 26;
+
+    const unsigned bad =
+        (unsigned(!tripletOk(a[0], a[1], a[2])) << 0) |
+        (unsigned(!tripletOk(a[3], a[4], a[5])) << 1) |
+        (unsigned(!(a[6] & a[7] & A_DIGIT)) << 2) |
+        (unsigned(!(b[8] & (B_FEB | B_MONTH_30 | B_MONTH_31))) << 3) |
+        (unsigned(!dayOk) << 4) |
+        (unsigned(!belfioreOk) << 5) |
+        (unsigned(!cinOk) << 6);
+
+    return bad == 0 ? matcher::Reason::Valid : FIELD_REASON[lowestBit(bad)];
+}
+
+#if defined(CF_SIMD_X86)
+
+/**
+ * @brief Lookup di 16 simboli (0-35) in una tabella da 48 byte con 3 PSHUFB.
+ *
+ * Gli indici fuori dal blocco di 16 saturano a >= 0x80 e PSHUFB restituisce 0.
+ */
+CF_TARGET_SSSE3
+static inline __m128i lookup36(const SymbolTable& t, __m128i idx) {
+    const __m128i bias = _mm_set1_epi8(0x70);
+    const __m128i t0 = _mm_load_si128(reinterpret_cast<const __m128i*>(t.v));
+    const __m128i t1 = _mm_load_si128(reinterpret_cast<const __m128i*>(t.v + 16));
+    const __m128i t2 = _mm_load_si128(reinterpret_cast<const __m128i*>(t.v + 32));
+    const __m128i i1 = _mm_sub_epi8(idx, _mm_set1_epi8(16));
+    const __m128i i2 = _mm_sub_epi8(idx, _mm_set1_epi8(32));
+    return _mm_or_si128(_mm_or_si128(
+        _mm_shuffle_epi8(t0, _mm_adds_epu8(idx, bias)),
+        _mm_shuffle_epi8(t1, _mm_adds_epu8(i1, bias))),
+        _mm_shuffle_epi8(t2, _mm_adds_epu8(i2, bias)));
+}
+
+static inline __m128i inRange(__m128i v, char lo, char hi) {
+    return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(static_cast<char>(lo - 1))),
+                         _mm_cmpgt_epi8(_mm_set1_epi8(static_cast<char>(hi + 1)), v));
+}
+
+/**
+ * @brief Carica 16 code unit e li converte in simboli 0-35 (0xFF se non validi).
+ */
+static inline __m128i loadSymbols(const char16_t* cf) {
+    const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cf));
+    const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cf + 8));
+
+    // I code unit non ASCII diventano 0 o >= 0x80 e non passano i confronti
+    const __m128i bytes = _mm_packus_epi16(lo, hi);
+    const __m128i lower = inRange(bytes, 'a', 'z');
+    const __m128i upper = _mm_sub_epi8(bytes, _mm_and_si128(lower, _mm_set1_epi8(0x20)));
+
+    const __m128i isDigit = inRange(upper, '0', '9');
+    const __m128i isLetter = inRange(upper, 'A', 'Z');
+    const __m128i isAlnum = _mm_or_si128(isDigit, isLetter);
+
+    // Simbolo 0-35: cifre 0-9, lettere 10-35
+    const __m128i symbols = _mm_sub_epi8(_mm_sub_epi8(upper, _mm_set1_epi8('0')),
+                                         _mm_and_si128(isLetter, _mm_set1_epi8(7)));
+    return _mm_or_si128(symbols, _mm_andnot_si128(isAlnum, _mm_set1_epi8(-1)));
+}
+
+CF_TARGET_SSSE3
+static matcher::Reason validateSSSE3(const char16_t* cf) {
+    const __m128i symbols = loadSymbols(cf);
+    if (_mm_movemask_epi8(symbols) != 0) {
+        return matcher::Reason::InvalidCharacter;
+    }
+
+    // Pesi CIN: tabella dispari sulle posizioni 0,2,..14, pari su 1,3,..13
+    const __m128i oddPositions = _mm_setr_epi8(-1, 0, -1, 0, -1, 0, -1, 0,
+                                               -1, 0, -1, 0, -1, 0, -1, 0);
+    const __m128i evenPositions = _mm_setr_epi8(0, -1, 0, -1, 0, -1, 0, -1,
+                                                0, -1, 0, -1, 0, -1, 0, 0);
+    const __m128i weights = _mm_or_si128(
+        _mm_and_si128(lookup36(CIN_ODD, symbols), oddPositions),
+        _mm_and_si128(lookup36(CIN_EVEN, symbols), evenPositions));
+    const __m128i sums = _mm_sad_epu8(weights, _mm_setzero_si128());
+    const int cinSum = _mm_cvtsi128_si32(sums) + _mm_extract_epi16(sums, 4);
+
+    alignas(16) uint8_t a[16];
+    alignas(16) uint8_t b[16];
+    alignas(16) uint8_t s[16];
+    _mm_store_si128(reinterpret_cast<__m128i*>(a), lookup36(CLASS_A, symbols));
+    _mm_store_si128(reinterpret_cast<__m128i*>(b), lookup36(CLASS_B, symbols));
+    _mm_store_si128(reinterpret_cast<__m128i*>(s), symbols);
+
+    return checkFields(a, b, cinSum, s[15]);
+}
+
+#endif // CF_SIMD_X86
+
+// ============================================================================
+// Elaborazione a lotti
+// ============================================================================
+
+#if defined(CF_SIMD_X86)
+
+/**
+ * @brief Trasposizione di una matrice 16x16 di byte (righe <-> colonne).
+ *
+ * Quattro passaggi di interleave tra la riga j e la riga j+8.
+ */
+static inline void transpose16x16(__m128i* m) {
+    __m128i t[16];
+    for (int pass = 0; pass < 4; pass++) {
+        for (int j = 0; j < 8; j++) {
+            t[2 * j] = _mm_unpacklo_epi8(m[j], m[j + 8]);
+            t[2 * j + 1] = _mm_unpackhi_epi8(m[j], m[j + 8]);
+        }
+        for (int j = 0; j < 16; j++) {
+            m[j] = t[j];
+        }
+    }
+}
+
+/// 0xFF nelle lane in cui x contiene tutti i bit indicati
+static inline __m128i hasAll(__m128i x, uint8_t bits) {
+    const __m128i b = _mm_set1_epi8(static_cast<char>(bits));
+    return _mm_cmpeq_epi8(_mm_and_si128(x, b), b);
+}
+
+/// 0xFF nelle lane in cui x contiene almeno uno dei bit indicati
+static inline __m128i hasAny(__m128i x, uint8_t bits) {
+    const __m128i none = _mm_cmpeq_epi8(_mm_and_si128(x, _mm_set1_epi8(static_cast<char>(bits))),
+                                        _mm_setzero_si128());
+    return _mm_andnot_si128(none, _mm_set1_epi8(-1));
+}
+
+static inline __m128i select(__m128i mask, matcher::Reason reason, __m128i current) {
+    return _mm_or_si128(_mm_and_si128(mask, _mm_set1_epi8(static_cast<char>(reason))),
+                        _mm_andnot_si128(mask, current));
+}
+
+static inline __m128i tripletBad(__m128i a0, __m128i a1, __m128i a2) {
+    const __m128i letters = hasAll(_mm_and_si128(_mm_and_si128(a0, a1), a2), A_LETTER);
+    const __m128i v0 = hasAll(a0, A_VOWEL);
+    const __m128i v1 = hasAll(a1, A_VOWEL);
+    const __m128i vx2 = hasAll(a2, A_VX);
+    return _mm_or_si128(_mm_andnot_si128(letters, _mm_set1_epi8(-1)),
+                        _mm_or_si128(_mm_andnot_si128(v1, v0), _mm_andnot_si128(vx2, v1)));
+}
+
+/**
+ * @brief Verifica 16 record: una lane per record, un registro per posizione.
+ *
+ * Dopo la trasposizione classi, vincoli tra posizioni e CIN sono calcolati
+ * per 16 record alla volta con le stesse tabelle di validate16().
+ */
+CF_TARGET_SSSE3
+static void validateGroupSSSE3(const char16_t (*records)[16], uint8_t* results) {
+    __m128i col[16];
+    for (int r = 0; r < 16; r++) {
+        col[r] = loadSymbols(records[r]);
+    }
+    transpose16x16(col);
+
+    __m128i invalid = _mm_setzero_si128();
+    __m128i a[16];
+    for (int p = 0; p < 16; p++) {
+        invalid = _mm_or_si128(invalid, col[p]);
+        a[p] = lookup36(CLASS_A, col[p]);
+    }
+    invalid = _mm_cmplt_epi8(invalid, _mm_setzero_si128());
+    const __m128i b8 = lookup36(CLASS_B, col[8]);
+    const __m128i b9 = lookup36(CLASS_B, col[9]);
+    const __m128i b10 = lookup36(CLASS_B, col[10]);
+
+    // Somma dei pesi CIN su lane a 16 bit (massimo 15 * 25)
+    const __m128i zero = _mm_setzero_si128();
+    __m128i sumLo = zero, sumHi = zero;
+    for (int p = 0; p < 15; p++) {
+        const __m128i w = lookup36((p % 2 == 0) ? CIN_ODD : CIN_EVEN, col[p]);
+        sumLo = _mm_add_epi16(sumLo, _mm_unpacklo_epi8(w, zero));
+        sumHi = _mm_add_epi16(sumHi, _mm_unpackhi_epi8(w, zero));
+    }
+    // sum % 26 con moltiplicazione: floor(sum * 2521 / 65536) == sum / 26 per sum < 390
+    const __m128i k = _mm_set1_epi16(2521);
+    const __m128i m26 = _mm_set1_epi16(26);
+    sumLo = _mm_sub_epi16(sumLo, _mm_mullo_epi16(_mm_mulhi_epu16(sumLo, k), m26));
+    sumHi = _mm_sub_epi16(sumHi, _mm_mullo_epi16(_mm_mulhi_epu16(sumHi, k), m26));
+    const __m128i expected = _mm_add_epi8(_mm_packus_epi16(sumLo, sumHi), _mm_set1_epi8(10));
+    const __m128i cinBad = _mm_andnot_si128(
+        _mm_and_si128(hasAll(a[15], A_LETTER), _mm_cmpeq_epi8(expected, col[15])),
+        _mm_set1_epi8(-1));
+
+    const __m128i dayOk = _mm_or_si128(
+        _mm_or_si128(_mm_and_si128(hasAll(b9, B_TENS_NZ), hasAll(a[10], A_NZ)),
+                     _mm_and_si128(hasAll(b9, B_TENS_ANY), hasAll(a[10], A_DIGIT))),
+        _mm_and_si128(hasAll(b9, B_TENS_3),
+                      _mm_or_si128(_mm_and_si128(hasAll(b8, B_MONTH_30), hasAll(a[10], A_ZERO)),
+                                   _mm_and_si128(hasAll(b8, B_MONTH_31), hasAll(b10, B_UNITS_01)))));
+
+    const __m128i d13 = hasAll(a[13], A_DIGIT);
+    const __m128i d14 = hasAll(a[14], A_DIGIT);
+    const __m128i nz13 = hasAll(a[13], A_NZ);
+    const __m128i nz14 = hasAll(a[14], A_NZ);
+    const __m128i belfioreOk = _mm_or_si128(
+        _mm_and_si128(_mm_and_si128(hasAny(a[11], A_BEL_AM | A_BEL_Z), hasAll(a[12], A_NZ)),
+                      _mm_and_si128(d13, d14)),
+        _mm_and_si128(_mm_and_si128(hasAll(a[11], A_BEL_AM), hasAll(a[12], A_ZERO)),
+                      _mm_or_si128(_mm_and_si128(nz13, d14),
+                                   _mm_and_si128(hasAll(a[13], A_ZERO), nz14))));
+
+    const __m128i ones = _mm_set1_epi8(-1);
+    __m128i reason = _mm_setzero_si128();
+    reason = select(cinBad, matcher::Reason::InvalidCIN, reason);
+    reason = select(_mm_andnot_si128(belfioreOk, ones), matcher::Reason::InvalidBelfiore, reason);
+    reason = select(_mm_andnot_si128(dayOk, ones), matcher::Reason::InvalidDay, reason);
+    reason = select(_mm_andnot_si128(hasAny(b8, B_FEB | B_MONTH_30 | B_MONTH_31), ones),
+                    matcher::Reason::InvalidMonth, reason);
+    reason = select(_mm_andnot_si128(hasAll(_mm_and_si128(a[6], a[7]), A_DIGIT), ones),
+                    matcher::Reason::InvalidYear, reason);
+    reason = select(tripletBad(a[3], a[4], a[5]), matcher::Reason::InvalidName, reason);
+    reason = select(tripletBad(a[0], a[1], a[2]), matcher::Reason::InvalidSurname, reason);
+    reason = select(invalid, matcher::Reason::InvalidCharacter, reason);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(results), reason);
+}
+
+/**
+ * @brief Normalizza l'omocodia di un record su lane a 16 bit.
+ *
+ * Maiuscolo ASCII su tutte le posizioni; L-N e P-V diventano cifre nelle
+ * posizioni 6, 7, 9, 10, 12, 13, 14.
+ */
+static inline void normalizeRecordSSE2(const char16_t* in, char16_t* out) {
+    const __m128i positionsLo = _mm_setr_epi16(0, 0, 0, 0, 0, 0, -1, -1);
+    const __m128i positionsHi = _mm_setr_epi16(0, -1, -1, 0, -1, -1, -1, 0);
+    const __m128i* src = reinterpret_cast<const __m128i*>(in);
+    __m128i* dst = reinterpret_cast<__m128i*>(out);
+
+    for (int half = 0; half < 2; half++) {
+        __m128i c = _mm_loadu_si128(src + half);
+        const __m128i lower = _mm_and_si128(_mm_cmpgt_epi16(c, _mm_set1_epi16('a' - 1)),
+                                            _mm_cmplt_epi16(c, _mm_set1_epi16('z' + 1)));
+        c = _mm_sub_epi16(c, _mm_and_si128(lower, _mm_set1_epi16(0x20)));
+
+        const __m128i positions = half == 0 ? positionsLo : positionsHi;
+        const __m128i inLN = _mm_and_si128(_mm_cmpgt_epi16(c, _mm_set1_epi16('L' - 1)),
+                                           _mm_cmplt_epi16(c, _mm_set1_epi16('N' + 1)));
+        const __m128i inPV = _mm_and_si128(_mm_cmpgt_epi16(c, _mm_set1_epi16('P' - 1)),
+                                           _mm_cmplt_epi16(c, _mm_set1_epi16('V' + 1)));
+        // L-N: 'L' - '0' = 0x1C; P-V: 'P' - '3' = 0x1D
+        const __m128i delta = _mm_or_si128(_mm_and_si128(inLN, _mm_set1_epi16(0x1C)),
+                                           _mm_and_si128(inPV, _mm_set1_epi16(0x1D)));
+        c = _mm_sub_epi16(c, _mm_and_si128(delta, positions));
+
+        _mm_storeu_si128(dst + half, c);
+    }
+}
+
+#endif // CF_SIMD_X86
+
+matcher::Reason validate16(const char16_t* cf, Level level) {
+#if defined(CF_SIMD_X86)
+    if (level == Level::SSSE3 || level == Level::AVX2) {
+        return validateSSSE3(cf);
+    }
+#endif
+    (void)level;
+    return matcher::validate(cf);
+}
+
+matcher::Reason validate16(const char16_t* cf) {
+    return validate16(cf, detectLevel());
+}
+
+matcher::Reason validate16(const wchar_t* cf) {
+    if constexpr (sizeof(wchar_t) == sizeof(char16_t)) {
+        return validate16(reinterpret_cast<const char16_t*>(cf), detectLevel());
+    } else {
+        return matcher::validate(cf);
+    }
+}
+
+} // namespace simd
+
+// Lotti da 16 record: una lane per record nei registri a 128 bit
+static constexpr size_t BATCH_GROUP = 16;
+
+void validateBatch(const char16_t (*records)[16], size_t count, uint8_t* results) {
+    size_t i = 0;
+
+#if defined(CF_SIMD_X86)
+    const simd::Level level = simd::detectLevel();
+    if (level == simd::Level::SSSE3 || level == simd::Level::AVX2) {
+        for (; i + BATCH_GROUP <= count; i += BATCH_GROUP) {
+            simd::validateGroupSSSE3(records + i, results + i);
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        results[i] = static_cast<uint8_t>(matcher::validate(records[i]));
+    }
+}
+
+void normalizeOmocodiaBatch(const char16_t (*records)[16], char16_t (*normalized)[16], size_t count) {
+#if defined(CF_SIMD_X86)
+    if (simd::detectLevel() != simd::Level::Scalar) {
+        for (size_t i = 0; i < count; i++) {
+            simd::normalizeRecordSSE2(records[i], normalized[i]);
+        }
+        return;
+    }
+#endif
+
+    static constexpr bool OMOCODIA_POSITION[16] = {
+        false, false, false, false, false, false, true, true,
+        false, true, true, false, true, true, true, false
+    };
+    for (size_t i = 0; i < count; i++) {
+        for (int p = 0; p < 16; p++) {
+            char16_t c = records[i][p];
+            if (c >= u'a' && c <= u'z') {
+                c = static_cast<char16_t>(c - 0x20);
+            }
+            if (OMOCODIA_POSITION[p]) {
+                if (c >= u'L' && c <= u'N') {
+                    c = static_cast<char16_t>(c - 0x1C);
+                } else if (c >= u'P' && c <= u'V') {
+                    c = static_cast<char16_t>(c - 0x1D);
+                }
+            }
+            normalized[i][p] = c;
+        }
+    }
+}
+
+} // namespace cfparser
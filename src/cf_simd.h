@@ -0,0 +1,93 @@
+#ifndef CF_SIMD_H
+#define CF_SIMD_H
+
+#include <cstddef>
+#include <cstdint>
+#include "cf_matcher.h"
+
+namespace cfparser {
+namespace simd {
+
+/**
+ * @brief Set di istruzioni vettoriali usato dalle funzioni di questo modulo.
+ */
+enum class Level {
+    Scalar,     ///< Nessuna istruzione vettoriale (o CPU non x86)
+    SSE2,       ///< 8 code unit UTF-16 per istruzione
+    SSSE3,      ///< SSE2 + PSHUFB (lookup su tabelle da 16 byte)
+    AVX2        ///< 16 code unit UTF-16 per istruzione
+};
+
+/**
+ * @brief Rileva il set di istruzioni migliore disponibile sulla CPU.
+ *
+ * Il risultato viene calcolato alla prima chiamata e poi memorizzato.
+ */
+Level detectLevel();
+
+/**
+ * @brief Cerca la prossima finestra che ha la forma di un codice fiscale.
+ *
+ * Classifica il testo a blocchi (16/32 code unit per istruzione) come
+ * lettere o cifre e restituisce il primo offset p >= from tale che i 16
+ * caratteri da p sono tutti alfanumerici ASCII, hanno lettere nelle
+ * posizioni 0-5, 8, 11 e 15 e cifre o lettere omocodiche nelle altre. E'
+ * una condizione necessaria: il candidato va poi verificato con
+ * matcher::matchesAt().
+ *
+ * @param text Testo UTF-16
+ * @param length Numero di code unit
+ * @param from Offset da cui iniziare la ricerca
+ * @return L'offset del candidato, o SIZE_MAX se non ce ne sono
+ */
+size_t findCandidate(const char16_t* text, size_t length, size_t from);
+
+/**
+ * @brief Come sopra, con livello imposto (per confronti e diagnostica).
+ */
+size_t findCandidate(const char16_t* text, size_t length, size_t from, Level level);
+
+/**
+ * @brief Variante per wchar_t (UTF-16 su Windows, UTF-32 altrove).
+ *
+ * Con wchar_t a 32 bit viene usato il percorso scalare.
+ */
+size_t findCandidate(const wchar_t* text, size_t length, size_t from);
+
+/**
+ * @brief Variante per testo a 8 bit (ASCII, UTF-8, Latin-1).
+ *
+ * I byte non ASCII non sono ne' lettere ne' cifre. Un blocco da 64 byte
+ * richiede 4 istruzioni SSE2 o 2 AVX2 per classe.
+ */
+size_t findCandidate(const char* text, size_t length, size_t from);
+size_t findCandidate(const char* text, size_t length, size_t from, Level level);
+
+/**
+ * @brief Verifica esattamente 16 code unit e indica il primo campo errato.
+ *
+ * I 16 caratteri vengono caricati in un registro vettoriale, convertiti in
+ * maiuscolo con una sola maschera e classificati con lookup PSHUFB; i pesi
+ * del CIN sono letti con le stesse tabelle e sommati con PSADBW. I vincoli
+ * tra posizioni sono poi verificati con operazioni sui bit, senza salti
+ * dipendenti dai dati. Restituisce lo stesso esito di matcher::validate().
+ *
+ * @param cf Puntatore ad almeno 16 code unit
+ * @return Reason::Valid o il primo campo non valido
+ */
+matcher::Reason validate16(const char16_t* cf);
+
+/**
+ * @brief Come sopra, con livello imposto (per confronti e diagnostica).
+ */
+matcher::Reason validate16(const char16_t* cf, Level level);
+
+/**
+ * @brief Variante per wchar_t (con wchar_t a 32 bit usa matcher::validate).
+ */
+matcher::Reason validate16(const wchar_t* cf);
+
+} // namespace simd
+} // namespace cfparser
+
+#endif // CF_SIMD_H
@@ -0,0 +1,155 @@
+#include "cf_stats.h"
+#include "belfiore.h"
+#include "cf_decode.h"
+#include "cf_matcher.h"
+#include "cf_parser.h"
+#include "work_pool.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace cfparser {
+
+using matcher::symbolOf;
+
+/// Record verificati e decodificati insieme
+static constexpr size_t STATS_GROUP = 64;
+
+/// Dimensione nominale dei blocchi di righe assegnati ai thread
+static constexpr size_t CHUNK_BYTES = 1 << 20;
+
+void PopulationStats::merge(const PopulationStats& other) {
+    codes += other.codes;
+    rejected += other.rejected;
+    unknownBirthplace += other.unknownBirthplace;
+    for (size_t s = 0; s < 2; s++) {
+        bySex[s] += other.bySex[s];
+        for (size_t band = 0; band < AGE_BAND_COUNT; band++) {
+            byAgeBand[band][s] += other.byAgeBand[band][s];
+        }
+    }
+    for (size_t p = 0; p < PROVINCE_SLOTS; p++) {
+        byProvince[p] += other.byProvince[p];
+    }
+    for (size_t c = 0; c < COUNTRY_SLOTS; c++) {
+        byCountry[c] += other.byCountry[c];
+    }
+}
+
+void accumulateStats(const char16_t (*records)[16], size_t count, uint32_t referenceDate,
+                     PopulationStats& stats) {
+    uint8_t reasons[STATS_GROUP];
+    DecodedCF decoded[STATS_GROUP];
+
+    for (size_t base = 0; base < count; base += STATS_GROUP) {
+        const size_t n = std::min(STATS_GROUP, count - base);
+        validateBatch(records + base, n, reasons);
+        decodeBatch(records + base, n, referenceDate, decoded);
+
+        for (size_t i = 0; i < n; i++) {
+            if (reasons[i] != static_cast<uint8_t>(matcher::Reason::Valid) || !decoded[i].valid) {
+                stats.rejected++;
+                continue;
+            }
+            const size_t sex = decoded[i].sex == Sex::Female ? 1 : 0;
+            const size_t band = std::min<size_t>(decoded[i].age / AGE_BAND_YEARS, AGE_BAND_COUNT - 1);
+            stats.codes++;
+            stats.bySex[sex]++;
+            stats.byAgeBand[band][sex]++;
+
+            // Stati esteri: il numero del codice Z basta, senza tabella
+            const char16_t* belfiore = records[base + i] + 11;
+            if (symbolOf(belfiore[0]) == symbolOf('Z')) {
+                const int number = matcher::digitValue(symbolOf(belfiore[1])) * 100 +
+                                   matcher::digitValue(symbolOf(belfiore[2])) * 10 +
+                                   matcher::digitValue(symbolOf(belfiore[3]));
+                stats.byCountry[number]++;
+            } else if (const belfiore::Place* place = belfiore::lookup(belfiore)) {
+                stats.byProvince[provinceSlot(place->province)]++;
+            } else {
+                stats.unknownBirthplace++;
+            }
+        }
+    }
+}
+
+// ============================================================================
+// Elenchi di testo
+// ============================================================================
+
+/**
+ * @brief Inizio della riga che contiene position (0 o il byte dopo un a capo).
+ */
+static size_t lineBoundary(std::string_view text, size_t position) {
+    if (position == 0 || position >= text.size()) {
+        return std::min(position, text.size());
+    }
+    const size_t newline = text.find('\n', position - 1);
+    return newline == std::string_view::npos ? text.size() : newline + 1;
+}
+
+/**
+ * @brief Conta i codici delle righe contenute in text (righe intere).
+ */
+static void accumulateLines(std::string_view text, uint32_t referenceDate, PopulationStats& stats) {
+    char16_t records[STATS_GROUP][16];
+    size_t pending = 0;
+
+    size_t start = 0;
+    while (start < text.size()) {
+        const char* newline = static_cast<const char*>(
+            std::memchr(text.data() + start, '\n', text.size() - start));
+        const size_t end = newline != nullptr ? static_cast<size_t>(newline - text.data()) : text.size();
+        std::string_view line = text.substr(start, end - start);
+        start = end + 1;
+
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        if (line.find_first_not_of(" \t") == std::string_view::npos) {
+            continue;
+        }
+        // Caso comune: la riga e' il codice
+        size_t pos = 0;
+        if (line.size() != matcher::CF_LENGTH) {
+            pos = findCodiceFiscale(line, 0);
+            if (pos == std::string_view::npos) {
+                stats.rejected++;
+                continue;
+            }
+        }
+
+        for (size_t i = 0; i < matcher::CF_LENGTH; i++) {
+            records[pending][i] = static_cast<unsigned char>(line[pos + i]);
+        }
+        if (++pending == STATS_GROUP) {
+            accumulateStats(records, pending, referenceDate, stats);
+            pending = 0;
+        }
+    }
+    accumulateStats(records, pending, referenceDate, stats);
+}
+
+PopulationStats aggregateCodeList(std::string_view text, uint32_t referenceDate, unsigned threads) {
+    if (referenceDate == 0) {
+        referenceDate = today();
+    }
+
+    WorkPool pool(text.size() <= CHUNK_BYTES ? 1 : threads);
+    std::vector<PopulationStats> shards(pool.getThreadCount());
+    const size_t chunks = (text.size() + CHUNK_BYTES - 1) / CHUNK_BYTES;
+    pool.run(chunks, [&](size_t chunk, unsigned worker) {
+        const size_t begin = lineBoundary(text, chunk * CHUNK_BYTES);
+        const size_t end = lineBoundary(text, (chunk + 1) * CHUNK_BYTES);
+        if (begin < end) {
+            accumulateLines(text.substr(begin, end - begin), referenceDate, shards[worker]);
+        }
+    });
+
+    for (size_t t = 1; t < shards.size(); t++) {
+        shards[0].merge(shards[t]);
+    }
+    return shards[0];
+}
+
+} // namespace cfparser
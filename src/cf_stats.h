@@ -0,0 +1,91 @@
+#ifndef CF_STATS_H
+#define CF_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace cfparser {
+
+/// Ampiezza delle fasce d'eta' (anni)
+constexpr unsigned AGE_BAND_YEARS = 5;
+
+/// Fasce d'eta': 0-4, 5-9, ..., 95-99 (il codice non indica il secolo)
+constexpr size_t AGE_BAND_COUNT = 20;
+
+/// Sigle di provincia possibili (due lettere A-Z)
+constexpr size_t PROVINCE_SLOTS = 26 * 26;
+
+/// Numeri dei codici catastali degli stati esteri (Z000-Z999)
+constexpr size_t COUNTRY_SLOTS = 1000;
+
+/**
+ * @brief Posizione di una sigla di provincia in PopulationStats::byProvince.
+ *
+ * @param province Due lettere maiuscole (es. "MI")
+ */
+constexpr size_t provinceSlot(const char* province) {
+    return static_cast<size_t>(province[0] - 'A') * 26 + static_cast<size_t>(province[1] - 'A');
+}
+
+/**
+ * @brief Conteggi demografici di un insieme di codici fiscali.
+ *
+ * Tutti i conteggi riguardano i codici validi (struttura e CIN); le
+ * varianti omocodiche contano come il codice base. Circa 14 KB: ogni
+ * thread ne aggiorna una copia propria, sommata alle altre alla fine.
+ *
+ * byProvince e' una ripartizione completa dei nati in Italia solo se
+ * belfiore::isTableComplete(); con la tabella parziale la maggior parte
+ * dei comuni finisce in unknownBirthplace e va usata solo la somma dei due.
+ */
+struct PopulationStats {
+    uint64_t codes = 0;                             ///< Codici validi
+    uint64_t rejected = 0;                          ///< Righe non vuote senza un codice valido
+    uint64_t bySex[2] = {};                         ///< Maschi, femmine
+    uint64_t byAgeBand[AGE_BAND_COUNT][2] = {};     ///< Per fascia d'eta' e sesso
+    uint64_t byProvince[PROVINCE_SLOTS] = {};       ///< Nati in Italia, per provinceSlot()
+    uint64_t byCountry[COUNTRY_SLOTS] = {};         ///< Nati all'estero, per numero del codice Z
+    uint64_t unknownBirthplace = 0;                 ///< Nati in Italia, comune non nella tabella
+
+    /**
+     * @brief Somma i conteggi di other a questi.
+     */
+    void merge(const PopulationStats& other);
+};
+
+/**
+ * @brief Aggiunge un lotto di codici ai conteggi.
+ *
+ * I codici vengono verificati con validateBatch() e decodificati con
+ * decodeBatch() a gruppi di 64; il luogo di nascita e' letto dal codice
+ * catastale (il numero per gli stati esteri, la provincia dalla tabella
+ * incorporata per i comuni). Nessuna allocazione.
+ *
+ * @param records Array di count record da 16 code unit UTF-16
+ * @param count Numero di record
+ * @param referenceDate Data di riferimento per eta' e secolo (AAAAMMGG)
+ * @param stats Conteggi da aggiornare (i codici non validi vanno in rejected)
+ */
+void accumulateStats(const char16_t (*records)[16], size_t count, uint32_t referenceDate,
+                     PopulationStats& stats);
+
+/**
+ * @brief Calcola i conteggi di un elenco di codici fiscali, uno per riga.
+ *
+ * Come parseCodeList(), di ogni riga si prende il primo codice. Il testo
+ * viene diviso in blocchi di righe distribuiti tra i thread con
+ * WorkPool; ogni thread accumula in una copia propria di PopulationStats
+ * e le copie vengono sommate alla fine, senza sincronizzazione durante
+ * il conteggio.
+ *
+ * @param text Testo UTF-8 (es. un file mappato in memoria)
+ * @param referenceDate Data di riferimento per eta' e secolo (AAAAMMGG, 0 = oggi)
+ * @param threads Numero di thread (0 = tutti i core)
+ */
+PopulationStats aggregateCodeList(std::string_view text, uint32_t referenceDate = 0,
+                                  unsigned threads = 0);
+
+} // namespace cfparser
+
+#endif // CF_STATS_H
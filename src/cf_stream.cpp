@@ -0,0 +1,139 @@
+#include "cf_stream.h"
+#include "cf_matcher.h"
+#include "cf_simd.h"
+#include <algorithm>
+#include <type_traits>
+
+namespace cfparser {
+
+using matcher::CF_DFA;
+using matcher::symbolOf;
+
+StreamScanner::StreamScanner(bool overlapping) : m_overlapping(overlapping) {
+    reset();
+}
+
+void StreamScanner::reset() {
+    m_activeCount = 0;
+    m_position = 0;
+    for (size_t i = 0; i < matcher::CF_LENGTH; i++) {
+        m_active[i] = matcher::S_DEAD;
+        m_recent[i] = L' ';
+    }
+}
+
+/**
+ * @brief Prima posizione >= from in cui puo' iniziare un codice.
+ *
+ * Le finestre contenute tutte nel blocco sono filtrate con il prefiltro
+ * vettoriale; gli ultimi 15 caratteri vanno sempre dati all'automa, perche'
+ * un codice che inizia li' si completa nel blocco successivo. Per UTF-32
+ * (e wchar_t a 32 bit, filtrato in modo scalare) non si salta nulla.
+ */
+template <typename CharT>
+static size_t nextStart(const CharT* chunk, size_t length, size_t from) {
+    if constexpr (std::is_same_v<CharT, char> || std::is_same_v<CharT, char16_t> ||
+                  (std::is_same_v<CharT, wchar_t> && sizeof(wchar_t) == 2)) {
+        const size_t candidate = simd::findCandidate(chunk, length, from);
+        if (candidate != SIZE_MAX) {
+            return candidate;
+        }
+        return std::max(from, length - std::min(length, matcher::CF_LENGTH - 1));
+    } else {
+        return from;
+    }
+}
+
+template <typename CharT>
+size_t StreamScanner::feedImpl(const CharT* chunk, size_t length, std::vector<CFMatch>& matches) {
+    const size_t before = matches.size();
+
+    // Copie locali dello stato: il ciclo interno non scrive sui membri
+    uint8_t active[16];
+    size_t count = m_activeCount;
+    for (size_t k = 0; k < count; k++) {
+        active[k] = m_active[k];
+    }
+    uint64_t position = m_position;
+
+    // Senza tentativi vivi si salta al prossimo inizio possibile (calcolato
+    // una volta e riusato finche' non viene superato)
+    size_t skipTo = SIZE_MAX;
+    for (size_t i = 0; i < length; i++, position++) {
+        if (count == 0) {
+            if (skipTo == SIZE_MAX || skipTo < i) {
+                skipTo = nextStart(chunk, length, i);
+            }
+            position += skipTo - i;
+            i = skipTo;
+            if (i == length) {
+                break;
+            }
+        }
+
+        const uint8_t symbol = symbolOf(chunk[i]);
+        m_recent[position % matcher::CF_LENGTH] = static_cast<wchar_t>(
+            symbol < 10 ? L'0' + symbol : (symbol < matcher::SYMBOL_OTHER ? L'A' + symbol - 10 : L' '));
+
+        // Nuovo tentativo che inizia in questa posizione
+        active[count++] = matcher::S_SURNAME;
+
+        size_t alive = 0;
+        bool accepted = false;
+        for (size_t k = 0; k < count; k++) {
+            const uint8_t next = CF_DFA.next[active[k]][symbol];
+            if (next == matcher::S_ACCEPT) {
+                accepted = true;
+                if (!m_overlapping) {
+                    break;
+                }
+            } else if (next != matcher::S_DEAD) {
+                active[alive++] = next;
+            }
+        }
+
+        if (accepted) {
+            // Il tentativo piu' vecchio e' il primo a completarsi: e' il codice
+            // piu' a sinistra. I tentativi piu' recenti si sovrappongono e
+            // vengono scartati, salvo in modalita' overlapping.
+            CFMatch match;
+            match.offset = position + 1 - matcher::CF_LENGTH;
+            for (size_t j = 0; j < matcher::CF_LENGTH; j++) {
+                match.code[j] = m_recent[(match.offset + j) % matcher::CF_LENGTH];
+            }
+            match.code[matcher::CF_LENGTH] = L'\0';
+            match.cinValid = matcher::verifyCIN(match.code);
+            matches.push_back(match);
+            if (!m_overlapping) {
+                alive = 0;
+            }
+        }
+        count = alive;
+    }
+
+    for (size_t k = 0; k < count; k++) {
+        m_active[k] = active[k];
+    }
+    m_activeCount = count;
+    m_position = position;
+
+    return matches.size() - before;
+}
+
+size_t StreamScanner::feed(const char* chunk, size_t length, std::vector<CFMatch>& matches) {
+    return feedImpl(chunk, length, matches);
+}
+
+size_t StreamScanner::feed(const wchar_t* chunk, size_t length, std::vector<CFMatch>& matches) {
+    return feedImpl(chunk, length, matches);
+}
+
+size_t StreamScanner::feed(const char16_t* chunk, size_t length, std::vector<CFMatch>& matches) {
+    return feedImpl(chunk, length, matches);
+}
+
+size_t StreamScanner::feed(const char32_t* chunk, size_t length, std::vector<CFMatch>& matches) {
+    return feedImpl(chunk, length, matches);
+}
+
+} // namespace cfparser
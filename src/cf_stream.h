@@ -0,0 +1,87 @@
+#ifndef CF_STREAM_H
+#define CF_STREAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cfparser {
+
+/**
+ * @brief Codice fiscale trovato in un flusso di testo.
+ */
+struct CFMatch {
+    uint64_t offset;    ///< Offset assoluto (in code unit) dall'inizio del flusso
+    wchar_t code[17];   ///< Codice in maiuscolo, terminato da zero
+    bool cinValid;      ///< true se il CIN e' corretto
+};
+
+/**
+ * @brief Scanner incrementale: cerca i codici fiscali in un testo fornito
+ *        a blocchi di dimensione arbitraria.
+ *
+ * Usa lo stesso automa di extractCodiceFiscale(), ma conserva tra un blocco
+ * e l'altro gli stati dei tentativi ancora vivi (al piu' 16) e gli ultimi
+ * 16 caratteri, quindi un codice spezzato tra due blocchi viene trovato
+ * comunque. La memoria usata e' costante, indipendente dalla lunghezza del
+ * flusso.
+ *
+ * Per UTF-8 e UTF-16, quando non ci sono tentativi vivi, le posizioni che
+ * non possono iniziare un codice vengono saltate con il prefiltro
+ * vettoriale (simd::findCandidate()): l'automa lavora solo vicino ai
+ * candidati e alla fine di ogni blocco.
+ *
+ * Vengono restituiti tutti i codici, da sinistra a destra e senza
+ * sovrapposizioni (come ripetute ricerche a partire dalla fine del codice
+ * precedente). In modalita' overlapping vengono restituite invece tutte le
+ * finestre di 16 caratteri che rispettano la grammatica, anche sovrapposte:
+ * un codice con CIN errato non nasconde un codice valido che inizia al suo
+ * interno (serve a chi deve mascherare tutti i codici validi).
+ */
+class StreamScanner {
+public:
+    /**
+     * @param overlapping true per restituire anche i codici sovrapposti
+     */
+    explicit StreamScanner(bool overlapping = false);
+
+    /**
+     * @brief Elabora un blocco di testo.
+     *
+     * Gli offset sono in code unit del tipo usato: non mescolare tipi
+     * diversi nello stesso flusso.
+     *
+     * @param chunk Testo UTF-8, UTF-16 o UTF-32
+     * @param length Numero di code unit
+     * @param matches Vettore a cui aggiungere i codici completati in questo blocco
+     * @return Il numero di codici aggiunti
+     */
+    size_t feed(const char* chunk, size_t length, std::vector<CFMatch>& matches);
+    size_t feed(const wchar_t* chunk, size_t length, std::vector<CFMatch>& matches);
+    size_t feed(const char16_t* chunk, size_t length, std::vector<CFMatch>& matches);
+    size_t feed(const char32_t* chunk, size_t length, std::vector<CFMatch>& matches);
+
+    /**
+     * @brief Riporta lo scanner all'inizio di un nuovo flusso.
+     */
+    void reset();
+
+    /**
+     * @brief Numero di code unit elaborate dall'inizio del flusso.
+     */
+    uint64_t getPosition() const { return m_position; }
+
+private:
+    template <typename CharT>
+    size_t feedImpl(const CharT* chunk, size_t length, std::vector<CFMatch>& matches);
+
+    uint8_t m_active[16];   ///< Stati dei tentativi vivi, dal piu' vecchio
+    size_t m_activeCount;   ///< Numero di tentativi vivi
+    wchar_t m_recent[16];   ///< Ultimi 16 caratteri (buffer circolare)
+    uint64_t m_position;    ///< Offset assoluto del prossimo carattere
+    bool m_overlapping;     ///< Un codice trovato non consuma i caratteri
+};
+
+} // namespace cfparser
+
+#endif // CF_STREAM_H
@@ -0,0 +1,195 @@
+#include "cf_verify.h"
+#include "belfiore.h"
+#include "cf_generator.h"
+#include "cf_matcher.h"
+#include "cf_parser.h"
+#include <algorithm>
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define VERIFY_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace cfparser {
+
+using matcher::symbolOf;
+
+/// Record normalizzati per gruppo in verifyBatch()
+static constexpr size_t VERIFY_GROUP = 64;
+
+// Posizioni di ciascun campo (bit i = posizione i)
+static constexpr uint32_t SURNAME_POSITIONS = 0x0007;
+static constexpr uint32_t NAME_POSITIONS = 0x0038;
+static constexpr uint32_t DATE_POSITIONS = 0x07C0;
+static constexpr uint32_t BELFIORE_POSITIONS = 0x7800;
+
+static constexpr char MONTH_LETTERS[] = "ABCDEHLMPRST";
+static constexpr int FEMALE_DAY_OFFSET = 40;
+
+// ============================================================================
+// Confronto
+// ============================================================================
+
+/**
+ * @brief Maschera delle posizioni in cui i due record di 16 code unit differiscono.
+ */
+static inline uint32_t differences(const char16_t* a, const char16_t* b) {
+#if defined(VERIFY_SSE2)
+    const __m128i* pa = reinterpret_cast<const __m128i*>(a);
+    const __m128i* pb = reinterpret_cast<const __m128i*>(b);
+    const __m128i lo = _mm_cmpeq_epi16(_mm_loadu_si128(pa), _mm_loadu_si128(pb));
+    const __m128i hi = _mm_cmpeq_epi16(_mm_loadu_si128(pa + 1), _mm_loadu_si128(pb + 1));
+    return ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(lo, hi))) & 0xFFFF;
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < matcher::CF_LENGTH; i++) {
+        mask |= static_cast<uint32_t>(a[i] != b[i]) << i;
+    }
+    return mask;
+#endif
+}
+
+static void writeTwoDigits(char16_t* out, uint32_t value) {
+    out[0] = static_cast<char16_t>(u'0' + value / 10 % 10);
+    out[1] = static_cast<char16_t>(u'0' + value % 10);
+}
+
+/**
+ * @brief Scrive il codice catastale dichiarato in forma normalizzata.
+ *
+ * @return false se il testo non ha la forma di un codice catastale
+ */
+static bool expectedBelfiore(std::string_view declared, char16_t* out) {
+    if (declared.size() != 4) {
+        return false;
+    }
+    const uint8_t letter = symbolOf(declared[0]);
+    if (letter < 10 || letter >= matcher::SYMBOL_OTHER) {
+        return false;
+    }
+    out[0] = static_cast<char16_t>(u'A' + letter - 10);
+    for (size_t k = 1; k < 4; k++) {
+        const int digit = matcher::digitValue(symbolOf(declared[k]));
+        if (digit < 0) {
+            return false;
+        }
+        out[k] = static_cast<char16_t>(u'0' + digit);
+    }
+    return true;
+}
+
+/**
+ * @brief Confronta la denominazione dichiarata con quella del codice catastale.
+ *
+ * @param belfiore Codice catastale normalizzato del codice fiscale
+ * @return false se il luogo e' sicuramente diverso
+ */
+static bool placeNameMatches(std::string_view declared, const char16_t* belfiore) {
+    const belfiore::Place* place = belfiore::lookup(belfiore);
+    if (place == nullptr) {
+        return true;
+    }
+    const wchar_t* name = place->name;
+    size_t i = 0;
+    while (true) {
+        char expected = 0;
+        while (*name != L'\0' && (expected = foldLetter(*name)) == 0) {
+            name++;
+        }
+        char actual = 0;
+        while (i < declared.size() && (actual = foldLetter(decodeUtf8(declared, i))) == 0) {
+        }
+        if (expected != actual) {
+            return false;
+        }
+        if (expected == 0) {
+            return true;
+        }
+        name++;
+    }
+}
+
+/**
+ * @brief Verifica un codice gia' normalizzato (maiuscolo, senza omocodia).
+ */
+static uint8_t verifyNormalized(const char16_t* cf, const DeclaredData& declared) {
+    char16_t expected[16] = {};
+    uint32_t known = 0;
+
+    char letters[3];
+    if (!declared.surname.empty() && encodeSurname(declared.surname, letters)) {
+        std::copy(letters, letters + 3, expected);
+        known |= SURNAME_POSITIONS;
+    }
+    if (!declared.name.empty() && encodeName(declared.name, letters)) {
+        std::copy(letters, letters + 3, expected + 3);
+        known |= NAME_POSITIONS;
+    }
+
+    // Il giorno atteso usa il sesso del codice: data e sesso restano
+    // conflitti distinti
+    const bool female = cf[9] >= u'4';
+    const uint32_t month = declared.birthDate / 100 % 100;
+    if (declared.birthDate != 0 && month >= 1 && month <= 12) {
+        writeTwoDigits(expected + 6, declared.birthDate / 10000 % 100);
+        expected[8] = static_cast<char16_t>(MONTH_LETTERS[month - 1]);
+        writeTwoDigits(expected + 9, declared.birthDate % 100 + (female ? FEMALE_DAY_OFFSET : 0));
+        known |= DATE_POSITIONS;
+    }
+
+    bool placeByName = false;
+    if (!declared.birthplace.empty()) {
+        if (expectedBelfiore(declared.birthplace, expected + 11)) {
+            known |= BELFIORE_POSITIONS;
+        } else {
+            placeByName = true;
+        }
+    }
+
+    const uint32_t mismatch = differences(cf, expected) & known;
+    uint8_t conflicts = 0;
+    if (mismatch & SURNAME_POSITIONS) {
+        conflicts |= conflictBit(Conflict::Surname);
+    }
+    if (mismatch & NAME_POSITIONS) {
+        conflicts |= conflictBit(Conflict::Name);
+    }
+    if (mismatch & DATE_POSITIONS) {
+        conflicts |= conflictBit(Conflict::BirthDate);
+    }
+    if ((mismatch & BELFIORE_POSITIONS) ||
+        (placeByName && !placeNameMatches(declared.birthplace, cf + 11))) {
+        conflicts |= conflictBit(Conflict::Birthplace);
+    }
+    if (declared.sex.has_value() && (*declared.sex == Sex::Female) != female) {
+        conflicts |= conflictBit(Conflict::Sex);
+    }
+    if (!belfiore::isPlausibleBirthplace(cf, declared.birthDate)) {
+        conflicts |= conflictBit(Conflict::UnknownBirthplace);
+    }
+    return conflicts;
+}
+
+// ============================================================================
+// API pubblica
+// ============================================================================
+
+uint8_t verifyCodiceFiscale(const char16_t* cf, const DeclaredData& declared) {
+    char16_t normalized[1][16];
+    normalizeOmocodiaBatch(reinterpret_cast<const char16_t (*)[16]>(cf), normalized, 1);
+    return verifyNormalized(normalized[0], declared);
+}
+
+void verifyBatch(const char16_t (*records)[16], const DeclaredData* declared, size_t count,
+                 uint8_t* conflicts) {
+    char16_t normalized[VERIFY_GROUP][16];
+    for (size_t base = 0; base < count; base += VERIFY_GROUP) {
+        const size_t n = std::min(VERIFY_GROUP, count - base);
+        normalizeOmocodiaBatch(records + base, normalized, n);
+        for (size_t i = 0; i < n; i++) {
+            conflicts[base + i] = verifyNormalized(normalized[i], declared[base + i]);
+        }
+    }
+}
+
+} // namespace cfparser
@@ -0,0 +1,90 @@
+#ifndef CF_VERIFY_H
+#define CF_VERIFY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include "cf_decode.h"
+
+namespace cfparser {
+
+/**
+ * @brief Parte del codice fiscale in disaccordo con i dati anagrafici.
+ */
+enum class Conflict : uint8_t {
+    Surname,        ///< Posizioni 1-3
+    Name,           ///< Posizioni 4-6
+    BirthDate,      ///< Anno, mese e giorno (posizioni 7-11)
+    Sex,            ///< Giorno + 40 per le femmine
+    Birthplace,     ///< Codice catastale (posizioni 12-15)
+    UnknownBirthplace,  ///< Codice catastale inesistente o non in uso alla data di nascita
+    Count
+};
+
+/**
+ * @brief Bit di un conflitto nella maschera restituita da verifyBatch().
+ */
+constexpr uint8_t conflictBit(Conflict conflict) {
+    return static_cast<uint8_t>(1u << static_cast<unsigned>(conflict));
+}
+
+/**
+ * @brief Dati anagrafici dichiarati per un codice fiscale.
+ *
+ * I campi vuoti (o a zero) non vengono verificati. I testi non vengono
+ * copiati: possono puntare direttamente al buffer di lettura.
+ */
+struct DeclaredData {
+    std::string_view surname;       ///< Cognome (UTF-8 o Latin-1)
+    std::string_view name;          ///< Nome (UTF-8 o Latin-1)
+    uint32_t birthDate = 0;         ///< Data di nascita (AAAAMMGG)
+    std::optional<Sex> sex;         ///< Sesso
+    std::string_view birthplace;    ///< Codice catastale o denominazione del comune/stato
+};
+
+/**
+ * @brief Confronta un codice fiscale con i dati anagrafici dichiarati.
+ *
+ * Dai dati dichiarati si costruisce il codice atteso, posizione per
+ * posizione: lettere di cognome e nome (stesse regole di
+ * generateCodiceFiscale()), anno, mese, giorno (+40 se il codice indica una
+ * femmina) e codice catastale. Il codice viene normalizzato con le tabelle
+ * di normalizeOmocodiaBatch(), quindi le varianti omocodiche coincidono con
+ * il codice base; il confronto delle 16 posizioni e' un'unica operazione
+ * vettoriale e la maschera delle differenze viene ricondotta ai campi.
+ *
+ * Il secolo non e' verificabile (il codice contiene solo le ultime due
+ * cifre dell'anno). Un luogo dichiarato per nome viene confrontato con la
+ * denominazione del codice catastale nella tabella incorporata, ignorando
+ * maiuscole, accenti, spazi e apostrofi; se il codice non e' nella tabella
+ * il luogo non viene contestato. Indipendentemente dai dati dichiarati, il
+ * codice catastale e' UnknownBirthplace se non e' plausibile secondo
+ * belfiore::isPlausibleBirthplace() alla data di nascita dichiarata (con la
+ * tabella incorporata parziale non accade mai).
+ *
+ * Il formato e il CIN non vengono verificati: usare prima validateBatch().
+ *
+ * @param cf Codice fiscale (16 code unit, anche in minuscolo o omocodico)
+ * @param declared Dati dichiarati
+ * @return Maschera dei conflitti (conflictBit()), 0 se i dati concordano
+ */
+uint8_t verifyCodiceFiscale(const char16_t* cf, const DeclaredData& declared);
+
+/**
+ * @brief Come verifyCodiceFiscale() per un lotto di record.
+ *
+ * I codici vengono normalizzati a gruppi con normalizeOmocodiaBatch() in
+ * un buffer sullo stack; nessuna allocazione.
+ *
+ * @param records Array di count record da 16 code unit UTF-16
+ * @param declared Array di count dati dichiarati
+ * @param count Numero di record
+ * @param conflicts Array di count maschere di conflitti
+ */
+void verifyBatch(const char16_t (*records)[16], const DeclaredData* declared, size_t count,
+                 uint8_t* conflicts);
+
+} // namespace cfparser
+
+#endif // CF_VERIFY_H
@@ -10,6 +10,7 @@ namespace config {
 
 static const wchar_t* SECTION_HOTKEY = L"Hotkey";
 static const wchar_t* SECTION_GENERAL = L"General";
+static const wchar_t* SECTION_ROSTER = L"Roster";
 
 std::wstring getExePath() {
     wchar_t path[MAX_PATH] = {0};
@@ -92,6 +93,12 @@ AppConfig load() {
     // Leggi autostart
     cfg.autostart = GetPrivateProfileIntW(SECTION_GENERAL, L"Autostart", 0, path.c_str()) != 0;
 
+    // Leggi il percorso del filtro dell'anagrafica (impostato a mano nel file)
+    wchar_t rosterPath[MAX_PATH] = {0};
+    GetPrivateProfileStringW(SECTION_ROSTER, L"FilterPath", L"",
+                             rosterPath, MAX_PATH, path.c_str());
+    cfg.rosterFilterPath = rosterPath;
+
     return cfg;
 }
 
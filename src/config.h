@@ -15,6 +15,7 @@ struct AppConfig {
     UINT hotkeyModifiers;  ///< Combinazione di MOD_CONTROL | MOD_ALT | MOD_SHIFT | MOD_WIN
     UINT hotkeyVK;         ///< Codice del tasto virtuale
     bool autostart;
+    std::wstring rosterFilterPath;  ///< Filtro dell'anagrafica pazienti (vuoto = non usato)
 
     AppConfig()
         : hotkeyModifiers(MOD_CONTROL)
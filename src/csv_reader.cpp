@@ -0,0 +1,189 @@
+#include "csv_reader.h"
+#include "bit_util.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define CSV_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace cfparser {
+namespace csv {
+
+// Blocco di classificazione: una maschera a 64 bit per blocco
+static constexpr size_t BLOCK = 64;
+
+// ============================================================================
+// Classificazione
+// ============================================================================
+
+struct BlockMasks {
+    uint64_t quote;
+    uint64_t delimiter;
+    uint64_t newline;
+};
+
+static void classifyScalar(const char* text, size_t n, char delimiter, BlockMasks& masks) {
+    masks = {0, 0, 0};
+    for (size_t i = 0; i < n; i++) {
+        const uint64_t bit = uint64_t(1) << i;
+        if (text[i] == '"') {
+            masks.quote |= bit;
+        } else if (text[i] == delimiter) {
+            masks.delimiter |= bit;
+        } else if (text[i] == '\n') {
+            masks.newline |= bit;
+        }
+    }
+}
+
+#if defined(CSV_SSE2)
+
+static inline uint64_t equalMask(const char* text, __m128i value) {
+    uint64_t mask = 0;
+    for (size_t i = 0; i < BLOCK; i += 16) {
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+        mask |= uint64_t(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(c, value)))) << i;
+    }
+    return mask;
+}
+
+static void classifySSE2(const char* text, char delimiter, BlockMasks& masks) {
+    masks.quote = equalMask(text, _mm_set1_epi8('"'));
+    masks.delimiter = equalMask(text, _mm_set1_epi8(delimiter));
+    masks.newline = equalMask(text, _mm_set1_epi8('\n'));
+}
+
+#endif
+
+static void classifyBlock(const char* text, size_t n, char delimiter, BlockMasks& masks) {
+#if defined(CSV_SSE2)
+    if (n == BLOCK) {
+        classifySSE2(text, delimiter, masks);
+        return;
+    }
+#endif
+    classifyScalar(text, n, delimiter, masks);
+}
+
+/**
+ * @brief XOR prefisso: bit i = XOR dei bit 0..i (1 tra due virgolette).
+ */
+static inline uint64_t prefixXor(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+// ============================================================================
+// API pubblica
+// ============================================================================
+
+char detectDelimiter(std::string_view headerLine) {
+    static constexpr char CANDIDATES[] = {';', ',', '\t', '|'};
+    size_t counts[sizeof(CANDIDATES)] = {};
+    bool quoted = false;
+    for (char c : headerLine) {
+        if (c == '\n') {
+            break;
+        }
+        if (c == '"') {
+            quoted = !quoted;
+        }
+        for (size_t k = 0; k < sizeof(CANDIDATES) && !quoted; k++) {
+            counts[k] += c == CANDIDATES[k] ? 1 : 0;
+        }
+    }
+    size_t best = 0;
+    for (size_t k = 1; k < sizeof(CANDIDATES); k++) {
+        if (counts[k] > counts[best]) {
+            best = k;
+        }
+    }
+    return CANDIDATES[best];
+}
+
+size_t tokenize(std::string_view text, char delimiter, bool final, Records& records) {
+    records.clear();
+    std::vector<Field>& fields = records.m_fields;
+    std::vector<uint32_t>& firstField = records.m_firstField;
+
+    const char* data = text.data();
+    const size_t length = text.size();
+    uint64_t insideCarry = 0;       // Tutti 1 se il blocco precedente finisce tra virgolette
+    size_t fieldBegin = 0;
+    size_t consumed = 0;
+
+    auto endField = [&](size_t end, bool endOfRecord) {
+        // CRLF: il CR fuori dalle virgolette non fa parte del campo
+        if (endOfRecord && end > fieldBegin && data[end - 1] == '\r') {
+            end--;
+        }
+        fields.push_back({static_cast<uint32_t>(fieldBegin), static_cast<uint32_t>(end)});
+        if (endOfRecord) {
+            firstField.push_back(static_cast<uint32_t>(fields.size()));
+        }
+    };
+
+    for (size_t base = 0; base < length; base += BLOCK) {
+        const size_t n = std::min(BLOCK, length - base);
+        BlockMasks masks;
+        classifyBlock(data + base, n, delimiter, masks);
+
+        const uint64_t inside = prefixXor(masks.quote) ^ insideCarry;
+        insideCarry = (inside >> 63) != 0 ? ~uint64_t(0) : 0;
+
+        uint64_t separators = (masks.delimiter | masks.newline) & ~inside;
+        while (separators != 0) {
+            const unsigned bit = lowestBit(separators);
+            const size_t position = base + bit;
+            const bool endOfRecord = ((masks.newline >> bit) & 1) != 0;
+            endField(position, endOfRecord);
+            fieldBegin = position + 1;
+            if (endOfRecord) {
+                consumed = fieldBegin;
+            }
+            separators &= separators - 1;
+        }
+    }
+
+    if (final && consumed < length) {
+        endField(length, true);
+        consumed = length;
+    } else {
+        // Scarta i campi del record incompleto
+        fields.resize(firstField.back());
+    }
+    return consumed;
+}
+
+std::string_view fieldText(std::string_view text, Field field, char* scratch, size_t capacity) {
+    std::string_view value = text.substr(field.begin, field.end - field.begin);
+    if (value.empty() || value.front() != '"') {
+        return value;
+    }
+    value.remove_prefix(1);
+    if (!value.empty() && value.back() == '"') {
+        value.remove_suffix(1);
+    }
+    if (value.find("\"\"") == std::string_view::npos) {
+        return value;
+    }
+
+    size_t n = 0;
+    for (size_t i = 0; i < value.size() && n < capacity; i++) {
+        scratch[n++] = value[i];
+        if (value[i] == '"' && i + 1 < value.size() && value[i + 1] == '"') {
+            i++;
+        }
+    }
+    return std::string_view(scratch, n);
+}
+
+} // namespace csv
+} // namespace cfparser
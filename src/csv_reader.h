@@ -0,0 +1,94 @@
+#ifndef CSV_READER_H
+#define CSV_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace cfparser {
+namespace csv {
+
+/**
+ * @brief Campo di un record: intervallo di byte nel buffer letto.
+ *
+ * L'intervallo comprende le eventuali virgolette; usare fieldText() per il
+ * contenuto.
+ */
+struct Field {
+    uint32_t begin;
+    uint32_t end;
+};
+
+/**
+ * @brief Record estratti da un buffer da tokenize().
+ *
+ * I campi di tutti i record sono in un unico vettore; i vettori vengono
+ * svuotati ma non liberati tra una chiamata e l'altra, quindi dopo i primi
+ * buffer la lettura non alloca piu' memoria.
+ */
+class Records {
+public:
+    Records() { clear(); }
+
+    void clear() {
+        m_fields.clear();
+        m_firstField.assign(1, 0);
+    }
+
+    size_t getRecordCount() const { return m_firstField.size() - 1; }
+    size_t getFieldCount(size_t record) const { return m_firstField[record + 1] - m_firstField[record]; }
+    const Field* getFields(size_t record) const { return m_fields.data() + m_firstField[record]; }
+
+private:
+    friend size_t tokenize(std::string_view text, char delimiter, bool final, Records& records);
+
+    std::vector<Field> m_fields;
+    std::vector<uint32_t> m_firstField;     ///< Primo campo di ogni record, piu' la fine
+};
+
+/**
+ * @brief Sceglie il separatore di campo guardando la riga di intestazione.
+ *
+ * @return Il piu' frequente tra ';', ',', TAB e '|' fuori dalle virgolette
+ *         (';' se nessuno compare, come negli export di MilleWin)
+ */
+char detectDelimiter(std::string_view headerLine);
+
+/**
+ * @brief Divide in campi i record completi di un buffer (RFC 4180).
+ *
+ * I campi tra virgolette possono contenere separatori, a capo e virgolette
+ * raddoppiate. Il testo viene classificato a blocchi di 64 byte (SSE2 dove
+ * disponibile): virgolette, separatori e a capo diventano maschere di bit,
+ * le zone tra virgolette si ottengono con uno XOR prefisso e i campi si
+ * ricavano dai bit rimasti, senza esaminare i byte uno per uno. Le righe
+ * possono terminare con LF o CRLF.
+ *
+ * @param text Buffer che inizia all'inizio di un record (meno di 4 GB)
+ * @param delimiter Separatore di campo
+ * @param final true se il buffer arriva alla fine dei dati: anche
+ *        l'ultimo record senza a capo e' completo
+ * @param records Record trovati (il contenuto precedente viene scartato)
+ * @return Byte consumati, cioe' l'inizio del primo record incompleto; il
+ *         resto va riproposto all'inizio del buffer successivo
+ */
+size_t tokenize(std::string_view text, char delimiter, bool final, Records& records);
+
+/**
+ * @brief Contenuto di un campo, senza virgolette esterne.
+ *
+ * Se il campo contiene virgolette raddoppiate il testo viene ricopiato in
+ * scratch (troncato a capacity byte); altrimenti il risultato punta a text.
+ *
+ * @param text Buffer passato a tokenize()
+ * @param field Campo
+ * @param scratch Buffer di appoggio
+ * @param capacity Dimensione di scratch
+ */
+std::string_view fieldText(std::string_view text, Field field, char* scratch, size_t capacity);
+
+} // namespace csv
+} // namespace cfparser
+
+#endif // CSV_READER_H
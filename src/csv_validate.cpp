@@ -0,0 +1,486 @@
+#include "csv_validate.h"
+#include "belfiore.h"
+#include "cf_decode.h"
+#include "cf_generator.h"
+#include "cf_matcher.h"
+#include "cf_parser.h"
+#include "cf_verify.h"
+#include "csv_reader.h"
+#include "work_pool.h"
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cfparser {
+
+using matcher::CF_LENGTH;
+using matcher::Reason;
+using matcher::symbolOf;
+
+/// Righe assegnate a ciascun lavoro del pool
+static constexpr size_t ROWS_PER_TASK = 4096;
+
+/// Righe verificate insieme (buffer sullo stack)
+static constexpr size_t ROW_GROUP = 32;
+
+/// Byte copiati da un campo con virgolette raddoppiate (oltre viene troncato)
+static constexpr size_t MAX_FIELD_BYTES = 128;
+
+static constexpr const char* CHECK_NAMES[CSV_CHECK_COUNT] = {
+    "cf_mancante",
+    "cf_non_valido",
+    "cin_errato",
+    "cognome",
+    "nome",
+    "data_nascita",
+    "sesso",
+    "luogo_nascita",
+    "luogo_inesistente",
+    "data_illeggibile",
+    "sesso_illeggibile"
+};
+
+const char* csvCheckName(CsvCheck check) {
+    return CHECK_NAMES[static_cast<size_t>(check)];
+}
+
+static constexpr uint16_t bitOf(CsvCheck check) {
+    return static_cast<uint16_t>(1u << static_cast<unsigned>(check));
+}
+
+// ============================================================================
+// Lettura dei campi
+// ============================================================================
+
+static std::string_view trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+/**
+ * @brief Legge una data dichiarata.
+ *
+ * @return La data (AAAAMMGG), 0 se non leggibile; l'eventuale ora e'
+ *         ignorata
+ */
+static uint32_t parseDate(std::string_view text) {
+    const size_t time = text.find_first_of(" T");
+    if (time != std::string_view::npos) {
+        text = text.substr(0, time);
+    }
+
+    uint32_t parts[3] = {};
+    size_t widths[3] = {};
+    size_t count = 0;
+    size_t i = 0;
+    while (i < text.size() && count < 3) {
+        const size_t start = i;
+        uint32_t value = 0;
+        while (i < text.size() && text[i] >= '0' && text[i] <= '9' && i - start < 8) {
+            value = value * 10 + static_cast<uint32_t>(text[i] - '0');
+            i++;
+        }
+        if (i == start) {
+            return 0;
+        }
+        parts[count] = value;
+        widths[count++] = i - start;
+        if (i < text.size()) {
+            if (text[i] != '/' && text[i] != '-' && text[i] != '.') {
+                return 0;
+            }
+            i++;
+        }
+    }
+    if (i < text.size()) {
+        return 0;
+    }
+
+    uint32_t year, month, day;
+    if (count == 1 && widths[0] == 8) {
+        year = parts[0] / 10000;
+        month = parts[0] / 100 % 100;
+        day = parts[0] % 100;
+    } else if (count == 3 && widths[0] == 4 && widths[1] <= 2 && widths[2] <= 2) {
+        year = parts[0];
+        month = parts[1];
+        day = parts[2];
+    } else if (count == 3 && widths[2] == 4 && widths[0] <= 2 && widths[1] <= 2) {
+        day = parts[0];
+        month = parts[1];
+        year = parts[2];
+    } else {
+        return 0;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > 31) {
+        return 0;
+    }
+    return year * 10000 + month * 100 + day;
+}
+
+/**
+ * @brief Legge il sesso dichiarato (M/F, Maschio/Femmina, 1/2).
+ */
+static std::optional<Sex> parseSex(std::string_view text) {
+    if (text == "1") {
+        return Sex::Male;
+    }
+    if (text == "2") {
+        return Sex::Female;
+    }
+    switch (text.empty() ? '\0' : text.front()) {
+    case 'M': case 'm':
+        return Sex::Male;
+    case 'F': case 'f':
+        return Sex::Female;
+    default:
+        return std::nullopt;
+    }
+}
+
+static void appendCsvField(std::string& out, std::string_view text, char delimiter) {
+    if (text.find_first_of(std::string_view("\"\r\n", 3)) == std::string_view::npos &&
+        text.find(delimiter) == std::string_view::npos) {
+        out.append(text.data(), text.size());
+        return;
+    }
+    out += '"';
+    for (char c : text) {
+        out += c;
+        if (c == '"') {
+            out += '"';
+        }
+    }
+    out += '"';
+}
+
+// ============================================================================
+// Intestazione
+// ============================================================================
+
+/**
+ * @brief Indica se il nome di una colonna e' uno dei candidati.
+ *
+ * Il confronto ignora maiuscole, accenti, spazi e simboli: "Data di
+ * nascita", "DATA_NASCITA" e "datanascita" coincidono.
+ */
+static bool headerMatches(std::string_view header, std::initializer_list<const char*> candidates) {
+    char folded[64];
+    size_t n = 0;
+    for (size_t i = 0; i < header.size() && n < sizeof(folded);) {
+        const char32_t c = decodeUtf8(header, i);
+        const char letter = c >= '0' && c <= '9' ? static_cast<char>(c) : foldLetter(c);
+        if (letter != 0) {
+            folded[n++] = letter;
+        }
+    }
+    const std::string_view name(folded, n);
+    for (const char* candidate : candidates) {
+        if (name == candidate) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void resolveColumns(std::string_view text, const csv::Field* fields, size_t count,
+                           CsvColumns& columns) {
+    char scratch[MAX_FIELD_BYTES];
+    for (size_t c = 0; c < count; c++) {
+        const std::string_view header = trim(csv::fieldText(text, fields[c], scratch, sizeof(scratch)));
+        const int index = static_cast<int>(c);
+        if (columns.codiceFiscale < 0 &&
+            headerMatches(header, {"CODICEFISCALE", "CODFISCALE", "CODFISC", "CODICEFISC", "CF"})) {
+            columns.codiceFiscale = index;
+        } else if (columns.surname < 0 && headerMatches(header, {"COGNOME", "COGN"})) {
+            columns.surname = index;
+        } else if (columns.name < 0 && headerMatches(header, {"NOME"})) {
+            columns.name = index;
+        } else if (columns.birthDate < 0 &&
+                   headerMatches(header, {"DATANASCITA", "DATADINASCITA", "DATANASC", "DTNASCITA",
+                                          "NASCITA"})) {
+            columns.birthDate = index;
+        } else if (columns.sex < 0 && headerMatches(header, {"SESSO", "SEX", "GENERE"})) {
+            columns.sex = index;
+        } else if (columns.birthplace < 0 &&
+                   headerMatches(header, {"COMUNENASCITA", "COMUNEDINASCITA", "LUOGONASCITA",
+                                          "LUOGODINASCITA", "COMUNENASC", "LUOGONASC",
+                                          "CODICECATASTALE", "BELFIORE"})) {
+            columns.birthplace = index;
+        }
+    }
+}
+
+// ============================================================================
+// Validazione di un lotto
+// ============================================================================
+
+/**
+ * @brief Dati di un lotto letti da tutti i thread.
+ */
+struct Batch {
+    std::string_view text;
+    const csv::Records* records;
+    size_t firstRecord;         ///< 1 per il primo lotto con intestazione
+    uint64_t recordBase;        ///< Record dei lotti precedenti
+    CsvColumns columns;
+    char delimiter;
+};
+
+/// Contatori di un thread: righe, righe valide, poi un elemento per controllo
+struct WorkerCounts {
+    uint64_t rows = 0;
+    uint64_t validRows = 0;
+    uint64_t checks[CSV_CHECK_COUNT] = {};
+};
+
+/// Controllo corrispondente a ciascun Conflict
+static constexpr CsvCheck CONFLICT_CHECKS[] = {
+    CsvCheck::Surname, CsvCheck::Name, CsvCheck::BirthDate, CsvCheck::Sex, CsvCheck::Birthplace,
+    CsvCheck::UnknownBirthplace
+};
+
+static_assert(std::size(CONFLICT_CHECKS) == static_cast<size_t>(Conflict::Count),
+              "Conflitto senza controllo corrispondente");
+
+static std::string_view column(const Batch& batch, size_t record, int index, char* scratch) {
+    if (index < 0 || static_cast<size_t>(index) >= batch.records->getFieldCount(record)) {
+        return std::string_view();
+    }
+    const csv::Field field = batch.records->getFields(record)[index];
+    return trim(csv::fieldText(batch.text, field, scratch, MAX_FIELD_BYTES));
+}
+
+/**
+ * @brief Valida le righe [first, last) del lotto (indici dopo l'intestazione).
+ *
+ * Le righe sono elaborate a gruppi di ROW_GROUP con buffer sullo stack: i
+ * codici vengono copiati in record da 16 code unit, mentre i dati
+ * dichiarati restano viste sul buffer del lotto (solo i campi con
+ * virgolette raddoppiate vengono ricopiati, in un'area per riga).
+ */
+static void validateRows(const Batch& batch, size_t first, size_t last, std::string& out,
+                         WorkerCounts& counts) {
+    enum { CODE_FIELD, SURNAME_FIELD, NAME_FIELD, PLACE_FIELD, TEXT_FIELDS };
+    char scratch[ROW_GROUP][TEXT_FIELDS][MAX_FIELD_BYTES];
+    char16_t codes[ROW_GROUP][16];
+    std::string_view codeText[ROW_GROUP];
+    DeclaredData declared[ROW_GROUP];
+    uint16_t checks[ROW_GROUP];
+    bool skipped[ROW_GROUP];
+    uint8_t reasons[ROW_GROUP];
+    uint8_t conflicts[ROW_GROUP];
+    const CsvColumns& columns = batch.columns;
+
+    for (size_t group = first; group < last; group += ROW_GROUP) {
+        const size_t n = std::min(ROW_GROUP, last - group);
+
+        // Lettura dei campi
+        for (size_t g = 0; g < n; g++) {
+            const size_t record = batch.firstRecord + group + g;
+            const csv::Field* fields = batch.records->getFields(record);
+            skipped[g] = batch.records->getFieldCount(record) == 1 && fields[0].begin == fields[0].end;
+
+            const std::string_view code = column(batch, record, columns.codiceFiscale, scratch[g][CODE_FIELD]);
+            codeText[g] = code;
+            checks[g] = 0;
+            if (code.empty()) {
+                checks[g] |= bitOf(CsvCheck::MissingCode);
+            } else if (code.size() != CF_LENGTH) {
+                checks[g] |= bitOf(CsvCheck::InvalidCode);
+            }
+            for (size_t i = 0; i < CF_LENGTH; i++) {
+                codes[g][i] = i < code.size() ? static_cast<unsigned char>(code[i]) : u' ';
+            }
+
+            DeclaredData& data = declared[g];
+            data = DeclaredData();
+            data.surname = column(batch, record, columns.surname, scratch[g][SURNAME_FIELD]);
+            data.name = column(batch, record, columns.name, scratch[g][NAME_FIELD]);
+            data.birthplace = column(batch, record, columns.birthplace, scratch[g][PLACE_FIELD]);
+
+            char temp[MAX_FIELD_BYTES];
+            const std::string_view date = column(batch, record, columns.birthDate, temp);
+            if (!date.empty()) {
+                data.birthDate = parseDate(date);
+                checks[g] |= data.birthDate == 0 ? bitOf(CsvCheck::UnreadableDate) : 0;
+            }
+            const std::string_view sex = column(batch, record, columns.sex, temp);
+            if (!sex.empty()) {
+                data.sex = parseSex(sex);
+                checks[g] |= data.sex.has_value() ? 0 : bitOf(CsvCheck::UnreadableSex);
+            }
+        }
+
+        validateBatch(codes, n, reasons);
+        verifyBatch(codes, declared, n, conflicts);
+
+        // Risultati
+        for (size_t g = 0; g < n; g++) {
+            if (skipped[g]) {
+                continue;
+            }
+            uint16_t rowChecks = checks[g];
+            const bool sized = (rowChecks & (bitOf(CsvCheck::MissingCode) | bitOf(CsvCheck::InvalidCode))) == 0;
+            const Reason reason = static_cast<Reason>(reasons[g]);
+            if (sized && reason == Reason::InvalidCIN) {
+                rowChecks |= bitOf(CsvCheck::InvalidCIN);
+            } else if (sized && reason != Reason::Valid) {
+                rowChecks |= bitOf(CsvCheck::InvalidCode);
+            }
+
+            // Dati anagrafici: solo se il codice e' leggibile (anche con CIN errato)
+            if (sized && (reason == Reason::Valid || reason == Reason::InvalidCIN)) {
+                for (size_t c = 0; c < std::size(CONFLICT_CHECKS); c++) {
+                    if ((conflicts[g] >> c) & 1) {
+                        rowChecks |= bitOf(CONFLICT_CHECKS[c]);
+                    }
+                }
+            }
+
+            counts.rows++;
+            counts.validRows += rowChecks == 0 ? 1 : 0;
+
+            char number[24];
+            std::snprintf(number, sizeof(number), "%llu",
+                          static_cast<unsigned long long>(batch.recordBase + batch.firstRecord + group + g + 1));
+            out += number;
+            out += batch.delimiter;
+            appendCsvField(out, codeText[g], batch.delimiter);
+            out += batch.delimiter;
+            out += rowChecks == 0 ? "OK" : "ERRORE";
+            out += batch.delimiter;
+            bool firstCheck = true;
+            for (size_t c = 0; c < CSV_CHECK_COUNT; c++) {
+                if ((rowChecks >> c) & 1) {
+                    counts.checks[c]++;
+                    if (!firstCheck) {
+                        out += '|';
+                    }
+                    out += CHECK_NAMES[c];
+                    firstCheck = false;
+                }
+            }
+            out += '\n';
+        }
+    }
+}
+
+// ============================================================================
+// API pubblica
+// ============================================================================
+
+bool validateCsv(std::FILE* input, std::FILE* output, const CsvOptions& options, CsvReport& report) {
+    report = CsvReport();
+
+    std::vector<char> buffer(std::max<size_t>(options.batchBytes, 4096));
+    size_t filled = 0;
+    bool eof = false;
+    bool firstBatch = true;
+    uint64_t recordBase = 0;
+    CsvColumns columns = options.columns;
+    char delimiter = options.delimiter;
+
+    csv::Records records;
+    std::vector<std::string> taskOutput;    // Testo di ciascun lavoro, riusato tra i lotti
+    WorkPool pool(options.threads);
+    std::vector<WorkerCounts> workerCounts(pool.getThreadCount());
+
+    while (!eof || filled > 0) {
+        if (!eof) {
+            const size_t read = std::fread(buffer.data() + filled, 1, buffer.size() - filled, input);
+            filled += read;
+            report.bytes += read;
+            if (filled < buffer.size()) {
+                if (std::ferror(input)) {
+                    report.error = "errore di lettura";
+                    return false;
+                }
+                eof = true;
+            }
+        }
+
+        if (firstBatch) {
+            if (filled >= 3 && std::memcmp(buffer.data(), "\xEF\xBB\xBF", 3) == 0) {
+                std::memmove(buffer.data(), buffer.data() + 3, filled - 3);
+                filled -= 3;
+            }
+            if (delimiter == 0) {
+                delimiter = csv::detectDelimiter(std::string_view(buffer.data(), filled));
+            }
+        }
+
+        const std::string_view text(buffer.data(), filled);
+        const size_t consumed = csv::tokenize(text, delimiter, eof, records);
+        if (records.getRecordCount() == 0 && !eof) {
+            // Record piu' lungo del buffer
+            buffer.resize(buffer.size() * 2);
+            continue;
+        }
+
+        size_t firstRecord = 0;
+        if (firstBatch) {
+            firstBatch = false;
+            if (options.header && records.getRecordCount() > 0) {
+                resolveColumns(text, records.getFields(0), records.getFieldCount(0), columns);
+                firstRecord = 1;
+            }
+            if (columns.codiceFiscale < 0) {
+                report.error = "colonna del codice fiscale non trovata";
+                return false;
+            }
+            std::fprintf(output, "riga%ccodice_fiscale%cesito%cproblemi\n",
+                         delimiter, delimiter, delimiter);
+        }
+
+        const size_t rows = records.getRecordCount() - firstRecord;
+        const size_t tasks = (rows + ROWS_PER_TASK - 1) / ROWS_PER_TASK;
+        if (taskOutput.size() < tasks) {
+            taskOutput.resize(tasks);
+        }
+
+        const Batch batch{text, &records, firstRecord, recordBase, columns, delimiter};
+        pool.run(tasks, [&](size_t task, unsigned worker) {
+            std::string& out = taskOutput[task];
+            out.clear();
+            const size_t first = task * ROWS_PER_TASK;
+            validateRows(batch, first, std::min(rows, first + ROWS_PER_TASK), out,
+                         workerCounts[worker]);
+        });
+
+        for (size_t task = 0; task < tasks; task++) {
+            const std::string& out = taskOutput[task];
+            if (std::fwrite(out.data(), 1, out.size(), output) != out.size()) {
+                report.error = "errore di scrittura";
+                return false;
+            }
+        }
+
+        recordBase += records.getRecordCount();
+        std::memmove(buffer.data(), buffer.data() + consumed, filled - consumed);
+        filled -= consumed;
+    }
+
+    for (const WorkerCounts& counts : workerCounts) {
+        report.rows += counts.rows;
+        report.validRows += counts.validRows;
+        for (size_t c = 0; c < CSV_CHECK_COUNT; c++) {
+            report.checkCounts[c] += counts.checks[c];
+        }
+    }
+    report.columns = columns;
+    report.delimiter = delimiter;
+    return true;
+}
+
+} // namespace cfparser
@@ -0,0 +1,99 @@
+#ifndef CSV_VALIDATE_H
+#define CSV_VALIDATE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace cfparser {
+
+/**
+ * @brief Controlli eseguiti su ogni riga di un export anagrafico.
+ */
+enum class CsvCheck : uint8_t {
+    MissingCode,        ///< Campo del codice fiscale vuoto
+    InvalidCode,        ///< Codice non conforme (lunghezza, caratteri, data...)
+    InvalidCIN,         ///< Carattere di controllo errato
+    Surname,            ///< Lettere del cognome diverse da quelle del codice
+    Name,               ///< Lettere del nome diverse da quelle del codice
+    BirthDate,          ///< Data di nascita diversa da quella del codice
+    Sex,                ///< Sesso diverso da quello del codice
+    Birthplace,         ///< Comune o stato di nascita diverso da quello del codice
+    UnknownBirthplace,  ///< Codice catastale inesistente o non in uso alla data di nascita
+    UnreadableDate,     ///< Data di nascita non leggibile
+    UnreadableSex,      ///< Sesso non leggibile
+    Count
+};
+
+constexpr size_t CSV_CHECK_COUNT = static_cast<size_t>(CsvCheck::Count);
+
+/**
+ * @brief Nome breve di un controllo, come scritto nel file dei risultati.
+ */
+const char* csvCheckName(CsvCheck check);
+
+/**
+ * @brief Colonne dell'export (0-based; -1 = assente).
+ */
+struct CsvColumns {
+    int codiceFiscale = -1;
+    int surname = -1;
+    int name = -1;
+    int birthDate = -1;     ///< GG/MM/AAAA, GG-MM-AAAA, GG.MM.AAAA, AAAA-MM-GG o AAAAMMGG
+    int sex = -1;           ///< M/F, Maschio/Femmina o 1/2
+    int birthplace = -1;    ///< Codice catastale o denominazione
+};
+
+/**
+ * @brief Opzioni di validateCsv().
+ */
+struct CsvOptions {
+    char delimiter = 0;             ///< Separatore (0 = rileva dall'intestazione)
+    bool header = true;             ///< La prima riga contiene i nomi delle colonne
+    CsvColumns columns;             ///< Colonne a -1 cercate per nome nell'intestazione
+    unsigned threads = 0;           ///< Numero di thread (0 = tutti i core)
+    size_t batchBytes = 4 << 20;    ///< Byte letti per lotto
+};
+
+/**
+ * @brief Riepilogo di validateCsv().
+ */
+struct CsvReport {
+    uint64_t bytes = 0;                         ///< Byte letti
+    uint64_t rows = 0;                          ///< Righe di dati (vuote escluse)
+    uint64_t validRows = 0;                     ///< Righe senza problemi
+    uint64_t checkCounts[CSV_CHECK_COUNT] = {}; ///< Righe con ciascun problema
+    CsvColumns columns;                         ///< Colonne usate
+    char delimiter = 0;                         ///< Separatore usato
+    const char* error = nullptr;                ///< Motivo dell'errore, se validateCsv() fallisce
+};
+
+/**
+ * @brief Valida un export CSV di anagrafiche, riga per riga.
+ *
+ * Il file viene letto a lotti di options.batchBytes, divisi in campi da
+ * csv::tokenize(). Le righe di ogni lotto sono ripartite tra i thread:
+ * i codici fiscali vengono copiati in record da 16 code unit e verificati
+ * con validateBatch(); cognome, nome, data, sesso e luogo di nascita
+ * dichiarati vengono confrontati con il codice da verifyBatch() (le
+ * varianti omocodiche sono ammesse). Buffer, campi e risultati sono
+ * riusati da un lotto all'altro: la memoria non cresce con la dimensione
+ * del file e non si alloca per campo.
+ *
+ * Per ogni riga viene scritto, nell'ordine, "riga;codice;esito;problemi"
+ * (con il separatore dell'input): riga e' il numero del record (1 =
+ * intestazione), esito OK o ERRORE, problemi i nomi dei controlli falliti
+ * separati da '|'.
+ *
+ * @param input File da leggere (anche stdin)
+ * @param output File dei risultati
+ * @param options Opzioni
+ * @param report Riepilogo
+ * @return false in caso di errore di lettura/scrittura o se la colonna del
+ *         codice fiscale non e' stata trovata (report.error)
+ */
+bool validateCsv(std::FILE* input, std::FILE* output, const CsvOptions& options, CsvReport& report);
+
+} // namespace cfparser
+
+#endif // CSV_VALIDATE_H
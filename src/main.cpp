@@ -20,6 +20,9 @@
 #include "hotkey_manager.h"
 #include "window_finder.h"
 #include "cf_parser.h"
+#include "belfiore.h"
+#include "cf_correct.h"
+#include "roster_filter.h"
 #include "clipboard.h"
 #include "tray_icon.h"
 #include "dialogs.h"
@@ -44,6 +47,7 @@ static config::AppConfig g_savedConfig;  // Configurazione salvata su file
 static bool g_hotkeyModified = false;    // true se la hotkey è stata modificata
 static bool g_running = true;
 static bool g_updateCheckSilent = true;  // true se il controllo aggiornamenti è silenzioso
+static cfparser::RosterFilter g_roster;   // Anagrafica pazienti (se configurata)
 
 // ============================================================================
 // Forward declarations
@@ -168,6 +172,11 @@ bool initializeApplication(HINSTANCE hInstance) {
     // Verifica stato autostart dal Task Scheduler
     g_config.autostart = config::isAutostartEnabled();
 
+    // Filtro dell'anagrafica pazienti (opzionale: se non e' configurato non si
+    // segnala nulla; se e' configurato ma non si carica lo si dice all'avvio)
+    const bool rosterFailed = !g_config.rosterFilterPath.empty() &&
+                              !g_roster.load(g_config.rosterFilterPath);
+
     // Registra la classe della finestra
     WNDCLASSEXW wcex = {0};
     wcex.cbSize = sizeof(WNDCLASSEXW);
@@ -232,6 +241,14 @@ bool initializeApplication(HINSTANCE hInstance) {
                            g_hotkeyManager->getConfig().toString();
     g_trayIcon->create(tooltip);
 
+    // Senza filtro ogni paziente risulterebbe in anagrafica: avvisa
+    if (rosterFailed) {
+        g_trayIcon->showBalloon(L"Anagrafica pazienti non caricata",
+                                L"Filtro non trovato o non valido: " + g_config.rosterFilterPath +
+                                L". L'avviso \"non in anagrafica\" e' disattivato.",
+                                NIIF_WARNING, 5000);
+    }
+
     // Mostra notifica di avvio
     overlay::show(L"CF Extractor avviato",
                   g_hotkeyManager->getConfig().toString(),
@@ -336,12 +353,43 @@ void processHotkeyAction() {
     if (clipboard::copyToClipboard(g_hwndMain, cfNormalized)) {
         // Mostra overlay di successo
         std::wstring message = cfNormalized;
+
+        // Luogo di nascita, se il codice catastale e' nella tabella
+        const auto* place = cfparser::belfiore::lookupCodiceFiscale(cfNormalized.c_str());
+        if (place != nullptr) {
+            message += L" - ";
+            message += place->name;
+            if (!place->isForeign()) {
+                message += L" (";
+                message += std::wstring(place->province, place->province + 2);
+                message += L")";
+            }
+        }
+
         if (cf != cfNormalized) {
             message += L" (da omocodice)";
         }
 
+        // Paziente assente dall'anagrafica (solo se il filtro e' configurato)
+        const bool known = !g_roster.isLoaded() || g_roster.containsCodiceFiscale(cf);
+        if (!known) {
+            message += L" - non in anagrafica";
+        }
+
+        // CIN errato: probabile errore di battitura nell'anagrafica
+        const bool cinOk = cfparser::verifyCIN(cf);
+        if (!cinOk) {
+            message = cf + L": CIN errato";
+            const auto fixes = cfparser::suggestCorrections(cf, 1);
+            if (!fixes.empty()) {
+                message += L", forse ";
+                message += fixes.front().code;
+            }
+        }
+
         overlay::show(L"Codice Fiscale copiato", message,
-                      overlay::OverlayType::Success, OVERLAY_TIMEOUT_MS);
+                      cinOk && known ? overlay::OverlayType::Success : overlay::OverlayType::Warning,
+                      OVERLAY_TIMEOUT_MS);
 
         // Suona un beep di conferma
         MessageBeep(MB_OK);
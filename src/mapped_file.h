@@ -0,0 +1,79 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+namespace cfparser {
+
+/**
+ * @brief File mappato in memoria in sola lettura.
+ *
+ * Usa CreateFileMapping/MapViewOfFile su Windows e mmap altrove. Il
+ * contenuto resta valido finche' l'oggetto esiste; le pagine vengono
+ * caricate dal sistema operativo al primo accesso, quindi aprire un file
+ * grande non costa una lettura completa.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Apre e mappa un file (chiude l'eventuale file precedente).
+     *
+     * @param path Percorso del file
+     * @return true se il file e' stato mappato (un file vuoto e' valido, con
+     *         getData() == nullptr)
+     */
+    bool open(const std::filesystem::path& path);
+
+    /**
+     * @brief Rilascia la mappatura.
+     */
+    void close();
+
+    /**
+     * @brief Indica al sistema che l'intervallo verra' letto in sequenza.
+     *
+     * Il sistema puo' leggere in anticipo dal disco e liberare presto le
+     * pagine gia' lette. Su Windows non ha effetto (la lettura anticipata
+     * delle viste mappate e' automatica).
+     */
+    void adviseSequential(size_t offset, size_t length) const;
+
+    bool isOpen() const { return m_isOpen; }
+    const uint8_t* getData() const { return m_data; }
+    size_t getSize() const { return m_size; }
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_isOpen = false;
+#ifdef _WIN32
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+#endif
+};
+
+/**
+ * @brief Apre un file con fopen() a partire da un percorso UTF-8.
+ *
+ * Su Windows il percorso viene convertito e il file aperto con _wfopen(),
+ * cosi' funzionano anche i nomi con caratteri non ASCII.
+ *
+ * @return Il file, o nullptr in caso di errore
+ */
+std::FILE* openFile(const std::string& path, const char* mode);
+
+} // namespace cfparser
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,225 @@
+#include "mwcf_core.h"
+#include "belfiore.h"
+#include "cf_decode.h"
+#include "cf_matcher.h"
+#include "cf_parser.h"
+#include <algorithm>
+#include <string_view>
+#include <type_traits>
+
+using namespace cfparser;
+using matcher::symbolOf;
+
+/// Record convertiti in UTF-16 e verificati insieme (buffer sullo stack)
+static constexpr size_t CORE_GROUP = 64;
+
+static_assert(static_cast<int>(matcher::Reason::InvalidCIN) == MWCF_INVALID_CIN,
+              "gli esiti dell'ABI C seguono matcher::Reason");
+static_assert(sizeof(mwcf_match) == 32 && sizeof(mwcf_decoded) == 16, "layout dell'ABI C");
+
+// ============================================================================
+// Conversioni
+// ============================================================================
+
+/**
+ * @brief Copia count record (con passo stride) in record UTF-16 contigui.
+ */
+template <typename CharT>
+static void loadRecords(const CharT* records, size_t count, size_t stride, char16_t (*out)[16]) {
+    for (size_t i = 0; i < count; i++) {
+        const CharT* record = records + i * stride;
+        for (size_t k = 0; k < matcher::CF_LENGTH; k++) {
+            out[i][k] = static_cast<char16_t>(static_cast<std::make_unsigned_t<CharT>>(record[k]));
+        }
+    }
+}
+
+/**
+ * @brief Forma normalizzata (ASCII) di un codice valido: cifre al posto delle omocodie e CIN ricalcolato.
+ */
+static void storeNormalized(const char16_t* normalized, char* out) {
+    for (size_t k = 0; k < matcher::CF_LENGTH - 1; k++) {
+        out[k] = static_cast<char>(normalized[k]);
+    }
+    out[matcher::CF_LENGTH - 1] = matcher::calculateCIN(out);
+}
+
+/**
+ * @brief Riempie out da un record valido gia' normalizzato e dal risultato di decodeBatch().
+ */
+static void storeDecoded(const char* normalized, const DecodedCF& decoded, mwcf_decoded* out) {
+    *out = mwcf_decoded{};
+    if (!decoded.valid) {
+        return;
+    }
+    out->year = decoded.year;
+    out->month = decoded.month;
+    out->day = decoded.day;
+    out->sex = decoded.sex == Sex::Female ? 'F' : 'M';
+    out->age = decoded.age;
+    out->valid = 1;
+    std::copy(normalized + 11, normalized + 15, out->belfiore);
+    if (out->belfiore[0] == 'Z') {
+        // Stato estero: la sigla e' sempre EE, anche se il codice non e' in tabella
+        out->province[0] = 'E';
+        out->province[1] = 'E';
+    } else if (const belfiore::Place* place = belfiore::lookup(out->belfiore)) {
+        std::copy(place->province, place->province + 2, out->province);
+    }
+}
+
+template <typename CharT>
+static int validateOne(const CharT* cf, size_t length) {
+    if (cf == nullptr || length != matcher::CF_LENGTH) {
+        return MWCF_INVALID_LENGTH;
+    }
+    return static_cast<int>(matcher::validate(cf));
+}
+
+template <typename CharT>
+static size_t extractAll(const CharT* text, size_t length, mwcf_match* matches, size_t capacity) {
+    if (text == nullptr) {
+        return 0;
+    }
+    const std::basic_string_view<CharT> view(text, length);
+    size_t found = 0;
+    size_t from = 0;
+    size_t position;
+    while ((position = findCodiceFiscale(view, from)) != view.npos) {
+        if (found < capacity) {
+            mwcf_match& match = matches[found];
+            match = mwcf_match{};
+            match.offset = position;
+            for (size_t k = 0; k < matcher::CF_LENGTH; k++) {
+                const uint8_t symbol = symbolOf(text[position + k]);
+                match.code[k] = static_cast<char>(symbol < 10 ? '0' + symbol : 'A' + symbol - 10);
+            }
+            match.cin_valid = matcher::verifyCIN(match.code) ? 1 : 0;
+        }
+        found++;
+        from = position + matcher::CF_LENGTH;
+    }
+    return found;
+}
+
+// ============================================================================
+// API C
+// ============================================================================
+
+extern "C" {
+
+uint32_t mwcf_abi_version(void) {
+    return MWCF_ABI_VERSION;
+}
+
+const char* mwcf_version(void) {
+    return MWCF_VERSION;
+}
+
+int mwcf_validate(const char* cf, size_t length) {
+    return validateOne(cf, length);
+}
+
+int mwcf_validate_utf16(const uint16_t* cf, size_t length) {
+    return validateOne(cf, length);
+}
+
+size_t mwcf_extract_all(const char* text, size_t length, mwcf_match* matches, size_t capacity) {
+    return extractAll(text, length, matches, capacity);
+}
+
+size_t mwcf_extract_all_utf16(const uint16_t* text, size_t length, mwcf_match* matches, size_t capacity) {
+    // uint16_t e char16_t hanno la stessa rappresentazione: il prefiltro vettoriale lavora sul testo originale
+    return extractAll(reinterpret_cast<const char16_t*>(text), length, matches, capacity);
+}
+
+int mwcf_normalize(const char* cf, size_t length, char* out) {
+    const int result = validateOne(cf, length);
+    if (result == MWCF_VALID) {
+        char16_t normalized[16];
+        loadRecords(cf, 1, 0, &normalized);
+        normalizeOmocodiaBatch(&normalized, &normalized, 1);
+        storeNormalized(normalized, out);
+    }
+    return result;
+}
+
+int mwcf_decode(const char* cf, size_t length, uint32_t reference_date, mwcf_decoded* out) {
+    *out = mwcf_decoded{};
+    const int result = validateOne(cf, length);
+    if (result == MWCF_VALID) {
+        mwcf_decode_batch(cf, 1, matcher::CF_LENGTH, reference_date, out);
+    }
+    return result;
+}
+
+void mwcf_validate_batch(const char* records, size_t count, size_t stride, uint8_t* results) {
+    char16_t group[CORE_GROUP][16];
+    for (size_t base = 0; base < count; base += CORE_GROUP) {
+        const size_t n = std::min(CORE_GROUP, count - base);
+        loadRecords(records + base * stride, n, stride, group);
+        validateBatch(group, n, results + base);
+    }
+}
+
+void mwcf_validate_batch_utf16(const uint16_t* records, size_t count, size_t stride, uint8_t* results) {
+    char16_t group[CORE_GROUP][16];
+    for (size_t base = 0; base < count; base += CORE_GROUP) {
+        const size_t n = std::min(CORE_GROUP, count - base);
+        loadRecords(records + base * stride, n, stride, group);
+        validateBatch(group, n, results + base);
+    }
+}
+
+size_t mwcf_normalize_batch(const char* records, size_t count, size_t stride, char* out, size_t out_stride,
+                            uint8_t* results) {
+    char16_t group[CORE_GROUP][16];
+    uint8_t reasons[CORE_GROUP];
+    size_t valid = 0;
+    for (size_t base = 0; base < count; base += CORE_GROUP) {
+        const size_t n = std::min(CORE_GROUP, count - base);
+        loadRecords(records + base * stride, n, stride, group);
+        validateBatch(group, n, reasons);
+        normalizeOmocodiaBatch(group, group, n);
+        for (size_t i = 0; i < n; i++) {
+            if (reasons[i] == MWCF_VALID) {
+                storeNormalized(group[i], out + (base + i) * out_stride);
+                valid++;
+            }
+        }
+        if (results != nullptr) {
+            std::copy(reasons, reasons + n, results + base);
+        }
+    }
+    return valid;
+}
+
+size_t mwcf_decode_batch(const char* records, size_t count, size_t stride, uint32_t reference_date,
+                         mwcf_decoded* out) {
+    if (reference_date == 0) {
+        reference_date = today();
+    }
+    char16_t group[CORE_GROUP][16];
+    uint8_t reasons[CORE_GROUP];
+    DecodedCF decoded[CORE_GROUP];
+    size_t valid = 0;
+    for (size_t base = 0; base < count; base += CORE_GROUP) {
+        const size_t n = std::min(CORE_GROUP, count - base);
+        loadRecords(records + base * stride, n, stride, group);
+        validateBatch(group, n, reasons);
+        decodeBatch(group, n, reference_date, decoded);
+        normalizeOmocodiaBatch(group, group, n);
+        for (size_t i = 0; i < n; i++) {
+            char normalized[16];
+            storeNormalized(group[i], normalized);
+            if (reasons[i] != MWCF_VALID) {
+                decoded[i].valid = false;
+            }
+            storeDecoded(normalized, decoded[i], out + base + i);
+            valid += out[base + i].valid;
+        }
+    }
+    return valid;
+}
+
+} // extern "C"
@@ -0,0 +1,154 @@
+/**
+ * @file mwcf_core.h
+ * @brief Interfaccia C della libreria condivisa mwcf_core (DLL / .so)
+ *
+ * Espone verifica, estrazione, normalizzazione e decodifica dei codici
+ * fiscali ad altri linguaggi (script, generatori di report, intranet) con
+ * un ABI C stabile: solo tipi C a dimensione fissa, nessun tipo C++ e
+ * nessuna eccezione attraversa l'interfaccia. Le funzioni non allocano
+ * memoria: i risultati vanno in buffer forniti dal chiamante. Sono tutte
+ * thread-safe.
+ *
+ * I testi sono a 8 bit (ASCII, UTF-8 o Latin-1; i byte non ASCII non fanno
+ * mai parte di un codice) oppure UTF-16 per le funzioni con suffisso _utf16.
+ * Un record e' formato da 16 caratteri consecutivi; nelle funzioni a lotti
+ * il record i inizia a records + i * stride (stride = 16 per record
+ * contigui, 17 per codici separati da un a capo, ...).
+ */
+
+#ifndef MWCF_CORE_H
+#define MWCF_CORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#if defined(MWCF_CORE_BUILD)
+#define MWCF_API __declspec(dllexport)
+#else
+#define MWCF_API __declspec(dllimport)
+#endif
+#elif defined(__GNUC__) || defined(__clang__)
+#define MWCF_API __attribute__((visibility("default")))
+#else
+#define MWCF_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Versione dell'ABI: cambia solo con modifiche incompatibili. */
+#define MWCF_ABI_VERSION 1
+
+/** Lunghezza di un codice fiscale. */
+#define MWCF_CF_LENGTH 16
+
+/**
+ * Esiti della verifica (stessi valori di matcher::Reason): 0 = valido,
+ * altrimenti il primo campo non valido.
+ */
+#define MWCF_VALID              0
+#define MWCF_INVALID_LENGTH     1
+#define MWCF_INVALID_CHARACTER  2
+#define MWCF_INVALID_SURNAME    3
+#define MWCF_INVALID_NAME       4
+#define MWCF_INVALID_YEAR       5
+#define MWCF_INVALID_MONTH      6
+#define MWCF_INVALID_DAY        7
+#define MWCF_INVALID_BELFIORE   8
+#define MWCF_INVALID_CIN        9
+
+/** Codice trovato da mwcf_extract_all(). */
+typedef struct mwcf_match {
+    uint64_t offset;                    /**< Offset (in caratteri) nel testo */
+    char code[MWCF_CF_LENGTH + 1];      /**< Codice in maiuscolo, terminato da zero */
+    uint8_t cin_valid;                  /**< 1 se il CIN e' corretto */
+    uint8_t reserved[6];
+} mwcf_match;
+
+/** Dati ricavati da un codice fiscale (mwcf_decode()). */
+typedef struct mwcf_decoded {
+    uint16_t year;                      /**< Anno di nascita (secolo dedotto dalla data di riferimento) */
+    uint8_t month;                      /**< Mese (1-12) */
+    uint8_t day;                        /**< Giorno (1-31) */
+    char sex;                           /**< 'M' o 'F' */
+    uint8_t age;                        /**< Anni compiuti alla data di riferimento */
+    uint8_t valid;                      /**< 1 se il codice e' valido e decodificato */
+    uint8_t reserved;
+    char belfiore[5];                   /**< Codice catastale del luogo di nascita, es. "H501" */
+    char province[3];                   /**< Provincia: "EE" per ogni codice Z, "" se il comune non e' in tabella */
+} mwcf_decoded;
+
+/** Versione dell'ABI della libreria caricata (confrontare con MWCF_ABI_VERSION). */
+MWCF_API uint32_t mwcf_abi_version(void);
+
+/** Versione della libreria, es. "1.3.1". */
+MWCF_API const char* mwcf_version(void);
+
+/**
+ * Verifica un codice fiscale (struttura, omocodia e CIN).
+ *
+ * @return MWCF_VALID o il primo campo non valido
+ */
+MWCF_API int mwcf_validate(const char* cf, size_t length);
+MWCF_API int mwcf_validate_utf16(const uint16_t* cf, size_t length);
+
+/**
+ * Cerca tutti i codici fiscali in un testo, da sinistra a destra e senza
+ * sovrapposizioni (anche quelli con CIN errato, segnalati da cin_valid).
+ *
+ * @param matches Buffer per al piu' capacity codici (puo' essere NULL se capacity = 0)
+ * @return Il numero totale di codici nel testo: se e' maggiore di capacity,
+ *         solo i primi capacity sono stati scritti
+ */
+MWCF_API size_t mwcf_extract_all(const char* text, size_t length, mwcf_match* matches, size_t capacity);
+MWCF_API size_t mwcf_extract_all_utf16(const uint16_t* text, size_t length, mwcf_match* matches,
+                                       size_t capacity);
+
+/**
+ * Forma normalizzata di un codice valido: maiuscolo e senza omocodia.
+ *
+ * @param out 16 caratteri (senza terminatore), scritti solo se il codice e' valido
+ * @return MWCF_VALID o il primo campo non valido
+ */
+MWCF_API int mwcf_normalize(const char* cf, size_t length, char* out);
+
+/**
+ * Decodifica data di nascita, sesso, eta' e luogo di nascita.
+ *
+ * @param reference_date Data di riferimento AAAAMMGG (0 = oggi)
+ * @param out Risultato (valid = 0 se il codice non e' valido)
+ * @return MWCF_VALID o il primo campo non valido
+ */
+MWCF_API int mwcf_decode(const char* cf, size_t length, uint32_t reference_date, mwcf_decoded* out);
+
+/**
+ * Verifica count record: results[i] e' l'esito del record i.
+ */
+MWCF_API void mwcf_validate_batch(const char* records, size_t count, size_t stride, uint8_t* results);
+MWCF_API void mwcf_validate_batch_utf16(const uint16_t* records, size_t count, size_t stride,
+                                        uint8_t* results);
+
+/**
+ * Normalizza count record: il record normalizzato i va in out + i * out_stride
+ * (scritto solo se valido); results (opzionale) riceve gli esiti.
+ *
+ * @return Il numero di record validi
+ */
+MWCF_API size_t mwcf_normalize_batch(const char* records, size_t count, size_t stride, char* out,
+                                     size_t out_stride, uint8_t* results);
+
+/**
+ * Decodifica count record in out[0..count).
+ *
+ * @return Il numero di record validi
+ */
+MWCF_API size_t mwcf_decode_batch(const char* records, size_t count, size_t stride, uint32_t reference_date,
+                                  mwcf_decoded* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MWCF_CORE_H */
@@ -0,0 +1,110 @@
+#include "omocodia.h"
+#include <algorithm>
+#include "cf_matcher.h"
+
+namespace cfparser {
+
+using matcher::symbolOf;
+
+/**
+ * @brief Differenza (mod 26) del peso CIN quando la cifra d in posizione
+ *        OMOCODIA_ORDER[k] viene sostituita dalla sua lettera omocodica.
+ */
+struct CinDeltaTable {
+    uint8_t delta[OMOCODIA_POSITION_COUNT][10];
+};
+
+static constexpr CinDeltaTable buildCinDeltas() {
+    CinDeltaTable t{};
+    for (size_t k = 0; k < OMOCODIA_POSITION_COUNT; k++) {
+        const size_t pos = matcher::OMOCODIA_ORDER[k];
+        for (uint8_t d = 0; d < 10; d++) {
+            const int letter = matcher::cinValue(pos, symbolOf(matcher::OMOCODIA_LETTERS[d]));
+            const int digit = matcher::cinValue(pos, d);
+            t.delta[k][d] = static_cast<uint8_t>((letter - digit + 26) % 26);
+        }
+    }
+    return t;
+}
+
+static constexpr CinDeltaTable CIN_DELTAS = buildCinDeltas();
+
+bool isLegalOmocodia(const wchar_t* cf) {
+    return matcher::omocodiaLevel(cf) >= 0;
+}
+
+std::optional<PackedCF> canonicalKey(const wchar_t* cf) {
+    const auto packed = PackedCF::pack(cf);
+    if (!packed.has_value()) {
+        return std::nullopt;
+    }
+    return packed->getCanonical();
+}
+
+std::optional<PackedCF> canonicalKey(const std::wstring& cf) {
+    if (cf.length() != matcher::CF_LENGTH) {
+        return std::nullopt;
+    }
+    return canonicalKey(cf.c_str());
+}
+
+size_t enumerateOmocodiaVariants(const wchar_t* cf, wchar_t (*out)[16], OmocodiaVariants which) {
+    const auto key = canonicalKey(cf);
+    if (!key.has_value()) {
+        return 0;
+    }
+
+    // Codice base: cifre normalizzate, maiuscolo
+    wchar_t current[16];
+    key->unpack(current);
+
+    int digits[OMOCODIA_POSITION_COUNT];
+    for (size_t k = 0; k < OMOCODIA_POSITION_COUNT; k++) {
+        digits[k] = current[matcher::OMOCODIA_ORDER[k]] - L'0';
+    }
+
+    int sum = 0;
+    for (size_t i = 0; i < matcher::CF_LENGTH - 1; i++) {
+        sum += matcher::cinValue(i, symbolOf(current[i]));
+    }
+
+    if (which == OmocodiaVariants::Legal) {
+        for (size_t level = 0; level <= OMOCODIA_POSITION_COUNT; level++) {
+            if (level > 0) {
+                const size_t k = level - 1;
+                current[matcher::OMOCODIA_ORDER[k]] =
+                    static_cast<wchar_t>(matcher::OMOCODIA_LETTERS[digits[k]]);
+                sum += CIN_DELTAS.delta[k][digits[k]];
+            }
+            current[15] = static_cast<wchar_t>(L'A' + sum % 26);
+            std::copy(current, current + 16, out[level]);
+        }
+        return OMOCODIA_POSITION_COUNT + 1;
+    }
+
+    // Codice Gray: il passo i cambia il bit meno significativo a 1 di i
+    unsigned mask = 0;
+    for (size_t i = 0; i < OMOCODIA_VARIANT_COUNT; i++) {
+        if (i > 0) {
+            size_t k = 0;
+            while (((i >> k) & 1) == 0) {
+                k++;
+            }
+            mask ^= 1u << k;
+
+            const size_t pos = matcher::OMOCODIA_ORDER[k];
+            if (mask & (1u << k)) {
+                current[pos] = static_cast<wchar_t>(matcher::OMOCODIA_LETTERS[digits[k]]);
+                sum += CIN_DELTAS.delta[k][digits[k]];
+            } else {
+                current[pos] = static_cast<wchar_t>(L'0' + digits[k]);
+                sum += 26 - CIN_DELTAS.delta[k][digits[k]];
+            }
+        }
+        current[15] = static_cast<wchar_t>(L'A' + sum % 26);
+        std::copy(current, current + 16, out[mask]);
+    }
+    return OMOCODIA_VARIANT_COUNT;
+}
+
+} // namespace cfparser
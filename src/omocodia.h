@@ -0,0 +1,68 @@
+#ifndef OMOCODIA_H
+#define OMOCODIA_H
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include "packed_cf.h"
+
+namespace cfparser {
+
+/// Numero di posizioni omocodiche e di combinazioni possibili
+constexpr size_t OMOCODIA_POSITION_COUNT = 7;
+constexpr size_t OMOCODIA_VARIANT_COUNT = size_t(1) << OMOCODIA_POSITION_COUNT;
+
+/**
+ * @brief Insieme di varianti da generare.
+ */
+enum class OmocodiaVariants {
+    Legal,  ///< Solo le 8 varianti con sostituzioni da destra (0-7 lettere)
+    All     ///< Tutte le 128 combinazioni delle 7 posizioni
+};
+
+/**
+ * @brief Verifica che le lettere omocodiche seguano l'ordine previsto.
+ *
+ * Le cifre vanno sostituite a partire da quella piu' a destra (posizioni
+ * 14, 13, 12, 10, 9, 7, 6): una lettera a sinistra di una cifra ancora
+ * presente non e' un'omocodia legittima.
+ *
+ * @param cf Puntatore a 16 caratteri
+ */
+bool isLegalOmocodia(const wchar_t* cf);
+
+/**
+ * @brief Chiave canonica di un codice fiscale: il codice base senza omocodia.
+ *
+ * Tutte le varianti omocodiche legittime dello stesso codice hanno la
+ * stessa chiave. Costo costante (nessuna enumerazione).
+ *
+ * @param cf Puntatore a 16 caratteri
+ * @return La chiave, o std::nullopt se il codice non e' valido o se le
+ *         sostituzioni non seguono l'ordine previsto
+ */
+std::optional<PackedCF> canonicalKey(const wchar_t* cf);
+std::optional<PackedCF> canonicalKey(const std::wstring& cf);
+
+/**
+ * @brief Genera le varianti omocodiche di un codice fiscale.
+ *
+ * Il CIN di ogni variante e' aggiornato con una tabella di differenze per
+ * posizione e cifra: ogni passo (in ordine di codice Gray) cambia una sola
+ * posizione e somma una sola differenza, senza ricalcolare il checksum.
+ *
+ * Con OmocodiaVariants::All la variante con maschera m (bit k = posizione
+ * OMOCODIA_ORDER[k] sostituita) e' scritta in out[m]; con Legal la variante
+ * con k sostituzioni e' scritta in out[k].
+ *
+ * @param cf Un codice valido (base o variante legittima), 16 caratteri
+ * @param out Buffer di almeno 8 (Legal) o 128 (All) record da 16 caratteri
+ * @param which Insieme di varianti da generare
+ * @return Il numero di varianti scritte, 0 se il codice non e' valido o
+ *         se le sostituzioni non seguono l'ordine previsto
+ */
+size_t enumerateOmocodiaVariants(const wchar_t* cf, wchar_t (*out)[16], OmocodiaVariants which);
+
+} // namespace cfparser
+
+#endif // OMOCODIA_H
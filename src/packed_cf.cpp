@@ -0,0 +1,167 @@
+#include "packed_cf.h"
+#include "cf_matcher.h"
+
+namespace cfparser {
+
+using matcher::symbolOf;
+
+// Lettere ammesse per il mese e per il codice catastale, in ordine alfabetico
+static constexpr char MONTH_LETTERS[] = "ABCDEHLMPRST";
+static constexpr char BELFIORE_LETTERS[] = "ABCDEFGHIJKLMZ";
+
+// Radici delle cifre del corpo (dalla meno significativa)
+static constexpr uint64_t RADIX_BELFIORE_NUMBER = 1000;
+static constexpr uint64_t RADIX_BELFIORE_LETTER = 14;
+static constexpr uint64_t RADIX_DAY = 100;
+static constexpr uint64_t RADIX_MONTH = 12;
+static constexpr uint64_t RADIX_YEAR = 100;
+static constexpr uint64_t RADIX_LETTER = 26;
+static constexpr uint64_t OMOCODIA_LEVELS = 8;
+
+/**
+ * @brief Indice di un simbolo in un alfabeto, -1 se assente.
+ */
+static constexpr int indexIn(const char* alphabet, uint8_t symbol) {
+    for (int i = 0; alphabet[i]; i++) {
+        if (symbolOf(alphabet[i]) == symbol) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Valori dei simboli nei campi del codice, -1 se non ammessi.
+ *
+ * Calcolati a compile time: pack() legge una tabella per carattere invece
+ * di scorrere gli alfabeti.
+ */
+struct SymbolTables {
+    int8_t digit[matcher::SYMBOL_COUNT];     ///< Cifra (o lettera omocodica)
+    int8_t month[matcher::SYMBOL_COUNT];     ///< Indice in MONTH_LETTERS
+    int8_t belfiore[matcher::SYMBOL_COUNT];  ///< Indice in BELFIORE_LETTERS
+};
+
+static constexpr SymbolTables buildSymbolTables() {
+    SymbolTables tables = {};
+    for (uint8_t symbol = 0; symbol < matcher::SYMBOL_COUNT; symbol++) {
+        tables.digit[symbol] = static_cast<int8_t>(matcher::digitValue(symbol));
+        tables.month[symbol] = static_cast<int8_t>(indexIn(MONTH_LETTERS, symbol));
+        tables.belfiore[symbol] = static_cast<int8_t>(indexIn(BELFIORE_LETTERS, symbol));
+    }
+    return tables;
+}
+
+static constexpr SymbolTables SYMBOLS = buildSymbolTables();
+
+/**
+ * @brief Valore di una sequenza di posizioni numeriche (cifre o omocodia).
+ */
+template <typename CharT>
+static uint64_t digitsValue(const CharT* cf, size_t from, size_t count) {
+    uint64_t value = 0;
+    for (size_t i = from; i < from + count; i++) {
+        value = value * 10 + static_cast<uint64_t>(SYMBOLS.digit[symbolOf(cf[i])]);
+    }
+    return value;
+}
+
+template <typename CharT>
+static std::optional<PackedCF> packImpl(const CharT* cf) {
+    if (!matcher::matchesAt(cf) || !matcher::verifyCIN(cf)) {
+        return std::nullopt;
+    }
+
+    const int level = matcher::omocodiaLevel(cf);
+    if (level < 0) {
+        return std::nullopt;
+    }
+
+    uint64_t body = 0;
+    for (size_t i = 0; i < 6; i++) {
+        body = body * RADIX_LETTER + (symbolOf(cf[i]) - 10);
+    }
+    body = body * RADIX_YEAR + digitsValue(cf, 6, 2);
+    body = body * RADIX_MONTH + static_cast<uint64_t>(SYMBOLS.month[symbolOf(cf[8])]);
+    body = body * RADIX_DAY + digitsValue(cf, 9, 2);
+    body = body * RADIX_BELFIORE_LETTER +
+           static_cast<uint64_t>(SYMBOLS.belfiore[symbolOf(cf[11])]);
+    body = body * RADIX_BELFIORE_NUMBER + digitsValue(cf, 12, 3);
+
+    return PackedCF::fromValue(body * OMOCODIA_LEVELS + static_cast<uint64_t>(level));
+}
+
+template <typename CharT>
+static void writeDigits(CharT* out, size_t from, size_t count, uint64_t value) {
+    for (size_t i = from + count; i-- > from;) {
+        out[i] = static_cast<CharT>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+template <typename CharT>
+static void unpackImpl(uint64_t value, CharT* out) {
+    const int level = static_cast<int>(value % OMOCODIA_LEVELS);
+    uint64_t body = value / OMOCODIA_LEVELS;
+
+    writeDigits(out, 12, 3, body % RADIX_BELFIORE_NUMBER);
+    body /= RADIX_BELFIORE_NUMBER;
+    out[11] = static_cast<CharT>(BELFIORE_LETTERS[body % RADIX_BELFIORE_LETTER]);
+    body /= RADIX_BELFIORE_LETTER;
+    writeDigits(out, 9, 2, body % RADIX_DAY);
+    body /= RADIX_DAY;
+    out[8] = static_cast<CharT>(MONTH_LETTERS[body % RADIX_MONTH]);
+    body /= RADIX_MONTH;
+    writeDigits(out, 6, 2, body % RADIX_YEAR);
+    body /= RADIX_YEAR;
+    for (size_t i = 6; i-- > 0;) {
+        out[i] = static_cast<CharT>('A' + body % RADIX_LETTER);
+        body /= RADIX_LETTER;
+    }
+
+    for (int k = 0; k < level; k++) {
+        const size_t pos = matcher::OMOCODIA_ORDER[k];
+        out[pos] = static_cast<CharT>(matcher::OMOCODIA_LETTERS[out[pos] - '0']);
+    }
+
+    out[15] = static_cast<CharT>(matcher::calculateCIN(out));
+}
+
+std::optional<PackedCF> PackedCF::pack(const char* cf) {
+    return packImpl(cf);
+}
+
+std::optional<PackedCF> PackedCF::pack(const wchar_t* cf) {
+    return packImpl(cf);
+}
+
+std::optional<PackedCF> PackedCF::pack(const char16_t* cf) {
+    return packImpl(cf);
+}
+
+std::optional<PackedCF> PackedCF::fromString(const std::wstring& cf) {
+    if (cf.length() != matcher::CF_LENGTH) {
+        return std::nullopt;
+    }
+    return packImpl(cf.c_str());
+}
+
+void PackedCF::unpack(char* out) const {
+    unpackImpl(m_value, out);
+}
+
+void PackedCF::unpack(wchar_t* out) const {
+    unpackImpl(m_value, out);
+}
+
+void PackedCF::unpack(char16_t* out) const {
+    unpackImpl(m_value, out);
+}
+
+std::wstring PackedCF::toString() const {
+    std::wstring cf(matcher::CF_LENGTH, L' ');
+    unpackImpl(m_value, &cf[0]);
+    return cf;
+}
+
+} // namespace cfparser
@@ -0,0 +1,120 @@
+#ifndef PACKED_CF_H
+#define PACKED_CF_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+
+namespace cfparser {
+
+/**
+ * @brief Codice fiscale compresso in un intero a 64 bit.
+ *
+ * Ogni posizione usa solo l'alfabeto che la grammatica ammette:
+ *
+ *   cognome e nome   6 lettere        26^6
+ *   anno             2 cifre          100
+ *   mese             1 di 12 lettere  12
+ *   giorno           2 cifre          100
+ *   codice catastale A-M o Z + 3 cifre 14 * 1000
+ *   omocodia         livello 0-7      8
+ *
+ * Le cifre sono memorizzate in forma normalizzata e il livello di omocodia
+ * indica quante cifre, a partire da destra, sono sostituite da lettere
+ * (ordine previsto dall'Agenzia delle Entrate). Il CIN non e' memorizzato:
+ * viene ricalcolato. Il totale (circa 2^62) sta in 64 bit.
+ *
+ * Il valore numerico segue l'ordine alfabetico del codice normalizzato e,
+ * a parita', il livello di omocodia: confronto e hash sono operazioni su un
+ * solo intero.
+ */
+class PackedCF {
+public:
+    PackedCF() : m_value(0) {}
+
+    /**
+     * @brief Comprime un codice fiscale di 16 caratteri.
+     *
+     * @param cf Puntatore a 16 caratteri (maiuscoli o minuscoli)
+     * @return Il codice compresso, o std::nullopt se il codice non e' valido
+     *         (struttura o CIN) o se le sostituzioni omocodiche non seguono
+     *         l'ordine previsto e quindi non sono rappresentabili
+     */
+    static std::optional<PackedCF> pack(const char* cf);
+    static std::optional<PackedCF> pack(const wchar_t* cf);
+    static std::optional<PackedCF> pack(const char16_t* cf);
+
+    /**
+     * @brief Come pack(), a partire da una stringa.
+     */
+    static std::optional<PackedCF> fromString(const std::wstring& cf);
+
+    /**
+     * @brief Ricostruisce un PackedCF dal valore numerico (es. letto da file).
+     */
+    static PackedCF fromValue(uint64_t value) { return PackedCF(value); }
+
+    /**
+     * @brief Scrive i 16 caratteri del codice (maiuscoli, senza terminatore).
+     */
+    void unpack(char* out) const;
+    void unpack(wchar_t* out) const;
+    void unpack(char16_t* out) const;
+
+    /**
+     * @brief Restituisce il codice fiscale come stringa.
+     */
+    std::wstring toString() const;
+
+    /**
+     * @brief Valore numerico (per serializzazione e ordinamento).
+     */
+    uint64_t getValue() const { return m_value; }
+
+    /**
+     * @brief Numero di cifre sostituite da lettere omocodiche (0-7).
+     */
+    int getOmocodiaLevel() const { return static_cast<int>(m_value & 7); }
+
+    /**
+     * @brief Codice base, senza sostituzioni omocodiche (livello 0).
+     */
+    PackedCF getCanonical() const { return PackedCF(m_value & ~uint64_t(7)); }
+
+    bool operator==(const PackedCF& other) const { return m_value == other.m_value; }
+    bool operator!=(const PackedCF& other) const { return m_value != other.m_value; }
+    bool operator<(const PackedCF& other) const { return m_value < other.m_value; }
+    bool operator<=(const PackedCF& other) const { return m_value <= other.m_value; }
+    bool operator>(const PackedCF& other) const { return m_value > other.m_value; }
+    bool operator>=(const PackedCF& other) const { return m_value >= other.m_value; }
+
+    /**
+     * @brief Hash del valore (moltiplicazione di Fibonacci + fold).
+     */
+    size_t hash() const {
+        const uint64_t h = m_value * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(h ^ (h >> 32));
+    }
+
+private:
+    explicit PackedCF(uint64_t value) : m_value(value) {}
+
+    uint64_t m_value;
+};
+
+static_assert(sizeof(PackedCF) == sizeof(uint64_t), "PackedCF deve occupare 64 bit");
+
+} // namespace cfparser
+
+namespace std {
+
+template <>
+struct hash<cfparser::PackedCF> {
+    size_t operator()(const cfparser::PackedCF& cf) const { return cf.hash(); }
+};
+
+} // namespace std
+
+#endif // PACKED_CF_H
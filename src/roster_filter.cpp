@@ -0,0 +1,252 @@
+#include "roster_filter.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace cfparser {
+
+// ============================================================================
+// Hash e posizioni
+// ============================================================================
+
+static constexpr char FILE_MAGIC[8] = {'M', 'W', 'C', 'F', 'X', 'O', 'R', '\0'};
+static constexpr uint32_t FORMAT_VERSION = 1;
+static constexpr uint32_t FINGERPRINT_BITS = 16;
+static constexpr int MAX_BUILD_ATTEMPTS = 64;
+
+/**
+ * @brief Mescola i bit della chiave (finalizzatore di MurmurHash3).
+ */
+static inline uint64_t mixKey(uint64_t key, uint64_t seed) {
+    uint64_t h = key + seed;
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+static inline uint64_t rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+/**
+ * @brief Riduce 32 bit dell'hash a [0, n) senza divisione.
+ */
+static inline uint32_t reduce(uint64_t h, uint64_t n) {
+    return static_cast<uint32_t>((static_cast<uint64_t>(static_cast<uint32_t>(h)) * n) >> 32);
+}
+
+static inline uint16_t fingerprintOf(uint64_t h) {
+    return static_cast<uint16_t>(h ^ (h >> 32));
+}
+
+/**
+ * @brief Le 3 celle di una chiave, una per ciascun blocco.
+ */
+static inline void slotsOf(uint64_t h, uint64_t blockLength, uint32_t slots[3]) {
+    slots[0] = reduce(h, blockLength);
+    slots[1] = reduce(rotl64(h, 21), blockLength) + static_cast<uint32_t>(blockLength);
+    slots[2] = reduce(rotl64(h, 42), blockLength) + static_cast<uint32_t>(2 * blockLength);
+}
+
+static inline uint64_t nextSeed(uint64_t& state) {
+    // splitmix64
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// ============================================================================
+// Costruzione
+// ============================================================================
+
+std::optional<RosterFilter> RosterFilter::build(const std::vector<PackedCF>& roster) {
+    std::vector<uint64_t> keys;
+    keys.reserve(roster.size());
+    for (const PackedCF& cf : roster) {
+        keys.push_back(cf.getCanonical().getValue());
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    std::optional<RosterFilter> filter(std::in_place);
+    if (!filter->buildFrom(keys)) {
+        return std::nullopt;
+    }
+    return filter;
+}
+
+bool RosterFilter::buildFrom(std::vector<uint64_t>& keys) {
+    const size_t count = keys.size();
+    const uint64_t capacity = 32 + (count * 123 + 99) / 100;
+    const uint64_t blockLength = (capacity + 2) / 3;
+    const size_t cells = static_cast<size_t>(blockLength * 3);
+
+    // Per ogni cella: numero di chiavi e xor degli hash (quando resta una
+    // sola chiave, lo xor e' proprio il suo hash)
+    std::vector<uint32_t> cellCount(cells);
+    std::vector<uint64_t> cellXor(cells);
+    std::vector<uint32_t> queue(cells);
+    std::vector<uint64_t> stackHash(count);
+    std::vector<uint8_t> stackBlock(count);
+
+    uint64_t seedState = 0x4D57434652535452ull;  // "MWCFRSTR"
+    for (int attempt = 0; attempt < MAX_BUILD_ATTEMPTS; attempt++) {
+        const uint64_t seed = nextSeed(seedState);
+        std::fill(cellCount.begin(), cellCount.end(), 0);
+        std::fill(cellXor.begin(), cellXor.end(), 0);
+
+        for (uint64_t key : keys) {
+            const uint64_t h = mixKey(key, seed);
+            uint32_t slots[3];
+            slotsOf(h, blockLength, slots);
+            for (uint32_t slot : slots) {
+                cellCount[slot]++;
+                cellXor[slot] ^= h;
+            }
+        }
+
+        // Peeling: si rimuovono ripetutamente le chiavi che sono le sole
+        // occupanti di una cella
+        size_t queueSize = 0;
+        for (size_t i = 0; i < cells; i++) {
+            if (cellCount[i] == 1) {
+                queue[queueSize++] = static_cast<uint32_t>(i);
+            }
+        }
+
+        size_t stackSize = 0;
+        while (queueSize > 0) {
+            const uint32_t cell = queue[--queueSize];
+            if (cellCount[cell] != 1) {
+                continue;
+            }
+            const uint64_t h = cellXor[cell];
+            stackHash[stackSize] = h;
+            stackBlock[stackSize] = static_cast<uint8_t>(cell / blockLength);
+            stackSize++;
+
+            uint32_t slots[3];
+            slotsOf(h, blockLength, slots);
+            for (uint32_t slot : slots) {
+                cellCount[slot]--;
+                cellXor[slot] ^= h;
+                if (cellCount[slot] == 1) {
+                    queue[queueSize++] = slot;
+                }
+            }
+        }
+
+        if (stackSize != count) {
+            continue;
+        }
+
+        // Assegnazione in ordine inverso: la cella propria di ogni chiave
+        // riceve il valore che rende lo xor delle 3 celle uguale all'impronta
+        std::vector<uint16_t> fingerprints(cells, 0);
+        for (size_t i = stackSize; i-- > 0;) {
+            const uint64_t h = stackHash[i];
+            uint32_t slots[3];
+            slotsOf(h, blockLength, slots);
+            const uint8_t own = stackBlock[i];
+            uint16_t value = fingerprintOf(h);
+            for (int b = 0; b < 3; b++) {
+                if (b != own) {
+                    value ^= fingerprints[slots[b]];
+                }
+            }
+            fingerprints[slots[own]] = value;
+        }
+
+        m_owned = std::move(fingerprints);
+        m_file.close();
+        m_fingerprints = m_owned.data();
+        m_seed = seed;
+        m_blockLength = blockLength;
+        m_keyCount = count;
+        return true;
+    }
+
+    return false;
+}
+
+// ============================================================================
+// Query
+// ============================================================================
+
+bool RosterFilter::contains(PackedCF cf) const {
+    if (m_fingerprints == nullptr) {
+        return false;
+    }
+    const uint64_t h = mixKey(cf.getCanonical().getValue(), m_seed);
+    uint32_t slots[3];
+    slotsOf(h, m_blockLength, slots);
+    const uint16_t value = m_fingerprints[slots[0]] ^ m_fingerprints[slots[1]] ^ m_fingerprints[slots[2]];
+    return value == fingerprintOf(h);
+}
+
+bool RosterFilter::containsCodiceFiscale(std::wstring_view cf) const {
+    if (cf.size() != 16) {
+        return false;
+    }
+    auto packed = PackedCF::pack(cf.data());
+    return packed.has_value() && contains(*packed);
+}
+
+// ============================================================================
+// Serializzazione
+// ============================================================================
+
+bool RosterFilter::save(const std::filesystem::path& path) const {
+    if (m_fingerprints == nullptr) {
+        return false;
+    }
+
+    FileHeader header = {};
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(header.magic));
+    header.version = FORMAT_VERSION;
+    header.fingerprintBits = FINGERPRINT_BITS;
+    header.seed = m_seed;
+    header.blockLength = m_blockLength;
+    header.keyCount = m_keyCount;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(m_fingerprints),
+               static_cast<std::streamsize>(getSizeBytes()));
+    return static_cast<bool>(file);
+}
+
+bool RosterFilter::load(const std::filesystem::path& path) {
+    MappedFile file;
+    if (!file.open(path) || file.getSize() < sizeof(FileHeader)) {
+        return false;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, file.getData(), sizeof(header));
+    if (std::memcmp(header.magic, FILE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != FORMAT_VERSION ||
+        header.fingerprintBits != FINGERPRINT_BITS ||
+        header.blockLength == 0 || header.blockLength > UINT32_MAX / 3 ||
+        file.getSize() != sizeof(FileHeader) + header.blockLength * 3 * sizeof(uint16_t)) {
+        return false;
+    }
+
+    m_owned.clear();
+    m_owned.shrink_to_fit();
+    m_file = std::move(file);
+    m_fingerprints = reinterpret_cast<const uint16_t*>(m_file.getData() + sizeof(FileHeader));
+    m_seed = header.seed;
+    m_blockLength = header.blockLength;
+    m_keyCount = header.keyCount;
+    return true;
+}
+
+} // namespace cfparser
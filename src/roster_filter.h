@@ -0,0 +1,108 @@
+#ifndef ROSTER_FILTER_H
+#define ROSTER_FILTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <vector>
+#include "mapped_file.h"
+#include "packed_cf.h"
+
+namespace cfparser {
+
+/**
+ * @brief Filtro di appartenenza all'anagrafica pazienti (xor filter).
+ *
+ * Rappresenta un insieme statico di codici fiscali, indicizzati per codice
+ * canonico (senza omocodia): tutte le varianti omocodiche di un paziente
+ * risultano presenti. Ogni chiave occupa circa 20 bit (impronte da 16 bit,
+ * 1,23 celle per chiave); una query legge 3 celle, senza salti dipendenti
+ * dai dati.
+ *
+ * contains() non da' falsi negativi; i falsi positivi (un codice assente
+ * segnalato come presente) hanno probabilita' 1/65536.
+ *
+ * Formato del file (little-endian): intestazione FileHeader seguita dalle
+ * impronte uint16_t. Il file viene mappato in memoria e usato direttamente,
+ * senza copie.
+ */
+class RosterFilter {
+public:
+    RosterFilter() = default;
+
+    /**
+     * @brief Costruisce il filtro da un elenco di codici.
+     *
+     * I duplicati (anche varianti omocodiche dello stesso codice) sono
+     * ammessi e contati una sola volta.
+     *
+     * @return Il filtro, o std::nullopt se la costruzione non e' riuscita
+     */
+    static std::optional<RosterFilter> build(const std::vector<PackedCF>& roster);
+
+    /**
+     * @brief Salva il filtro su file.
+     *
+     * @return true se la scrittura e' riuscita
+     */
+    bool save(const std::filesystem::path& path) const;
+
+    /**
+     * @brief Carica un filtro salvato con save(), mappandolo in memoria.
+     *
+     * @return true se il file esiste e ha un formato valido
+     */
+    bool load(const std::filesystem::path& path);
+
+    /**
+     * @brief Indica se il filtro contiene dati (costruito o caricato).
+     */
+    bool isLoaded() const { return m_fingerprints != nullptr; }
+
+    /**
+     * @brief Verifica se un codice (o una sua variante omocodica) e' in anagrafica.
+     */
+    bool contains(PackedCF cf) const;
+
+    /**
+     * @brief Come sopra, a partire dal testo del codice.
+     *
+     * @return false anche se il codice non e' valido
+     */
+    bool containsCodiceFiscale(std::wstring_view cf) const;
+
+    /**
+     * @brief Numero di codici distinti nel filtro.
+     */
+    uint64_t getKeyCount() const { return m_keyCount; }
+
+    /**
+     * @brief Dimensione del filtro in byte (impronte).
+     */
+    size_t getSizeBytes() const { return static_cast<size_t>(m_blockLength) * 3 * sizeof(uint16_t); }
+
+private:
+    struct FileHeader {
+        char magic[8];          ///< "MWCFXOR\0"
+        uint32_t version;       ///< FORMAT_VERSION
+        uint32_t fingerprintBits;
+        uint64_t seed;
+        uint64_t blockLength;   ///< Celle per ciascuna delle 3 funzioni hash
+        uint64_t keyCount;
+    };
+
+    bool buildFrom(std::vector<uint64_t>& keys);
+
+    const uint16_t* m_fingerprints = nullptr;
+    uint64_t m_seed = 0;
+    uint64_t m_blockLength = 0;
+    uint64_t m_keyCount = 0;
+    std::vector<uint16_t> m_owned;  ///< Impronte del filtro costruito in memoria
+    MappedFile m_file;              ///< File mappato del filtro caricato
+};
+
+} // namespace cfparser
+
+#endif // ROSTER_FILTER_H
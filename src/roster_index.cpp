@@ -0,0 +1,212 @@
+#include "roster_index.h"
+#include "bit_util.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+namespace cfparser {
+
+static constexpr char FILE_MAGIC[8] = {'M', 'W', 'C', 'F', 'I', 'D', 'X', '\0'};
+static constexpr uint32_t FORMAT_VERSION = 1;
+
+/// Sentinella in posizione 0: nessun codice canonico vale UINT64_MAX
+/// (i 3 bit bassi sono sempre zero), quindi il confronto finale fallisce.
+static constexpr uint64_t SENTINEL = UINT64_MAX;
+
+/// Chiavi per linea di cache
+static constexpr size_t KEYS_PER_LINE = 64 / sizeof(uint64_t);
+
+/// Ricerche interleaved in lookupBatch()
+static constexpr size_t BATCH_LANES = 16;
+
+// ============================================================================
+// Costruzione
+// ============================================================================
+
+/**
+ * @brief Dispone le chiavi ordinate in ordine di Eytzinger.
+ *
+ * Visita l'albero implicito in ordine simmetrico (sinistro, nodo, destro):
+ * il nodo visitato per i-esimo riceve la i-esima chiave. La profondita'
+ * della ricorsione e' log2(count).
+ *
+ * @return Indice della prossima chiave da assegnare
+ */
+static size_t fillEytzinger(const std::vector<IndexEntry>& sorted, size_t next, size_t k,
+                            uint64_t* keys, uint64_t* offsets) {
+    if (k <= sorted.size()) {
+        next = fillEytzinger(sorted, next, 2 * k, keys, offsets);
+        keys[k] = sorted[next].cf.getValue();
+        offsets[k] = sorted[next].offset;
+        next = fillEytzinger(sorted, next + 1, 2 * k + 1, keys, offsets);
+    }
+    return next;
+}
+
+RosterIndex RosterIndex::build(std::vector<IndexEntry> entries) {
+    for (IndexEntry& entry : entries) {
+        entry.cf = entry.cf.getCanonical();
+    }
+    std::sort(entries.begin(), entries.end(), [](const IndexEntry& a, const IndexEntry& b) {
+        return a.cf != b.cf ? a.cf < b.cf : a.offset < b.offset;
+    });
+    entries.erase(std::unique(entries.begin(), entries.end(),
+                              [](const IndexEntry& a, const IndexEntry& b) { return a.cf == b.cf; }),
+                  entries.end());
+
+    RosterIndex index;
+    index.m_ownedKeys.assign(entries.size() + 1, SENTINEL);
+    index.m_ownedOffsets.assign(entries.size() + 1, 0);
+    fillEytzinger(entries, 0, 1, index.m_ownedKeys.data(), index.m_ownedOffsets.data());
+    index.m_keys = index.m_ownedKeys.data();
+    index.m_offsets = index.m_ownedOffsets.data();
+    index.m_count = entries.size();
+    return index;
+}
+
+// ============================================================================
+// Ricerca
+// ============================================================================
+
+static inline void prefetch(const void* address) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+    (void)address;
+#endif
+}
+
+std::optional<uint64_t> RosterIndex::lookup(PackedCF cf) const {
+    if (m_keys == nullptr) {
+        return std::nullopt;
+    }
+    const uint64_t key = cf.getCanonical().getValue();
+
+    // Discesa senza salti: a destra se la chiave del nodo e' minore. I
+    // discendenti di k a 3 livelli di distanza (8k .. 8k+7) stanno in una
+    // sola linea di cache, che viene precaricata.
+    uint64_t k = 1;
+    while (k <= m_count) {
+        prefetch(reinterpret_cast<const char*>(m_keys) + k * KEYS_PER_LINE * sizeof(uint64_t));
+        k = 2 * k + (m_keys[k] < key ? 1 : 0);
+    }
+
+    // Il risultato e' l'ultimo nodo in cui si e' scesi a sinistra: si tolgono
+    // le discese a destra finali (bit a 1) e l'ultima discesa a sinistra.
+    // Se si e' sempre scesi a destra, k diventa 0 (sentinella).
+    k >>= lowestBit(~k) + 1;
+    if (m_keys[k] != key) {
+        return std::nullopt;
+    }
+    return m_offsets[k];
+}
+
+void RosterIndex::lookupBatch(const PackedCF* cfs, size_t count, uint64_t* offsets) const {
+    if (m_keys == nullptr) {
+        std::fill(offsets, offsets + count, NOT_FOUND);
+        return;
+    }
+
+    // Ogni ricerca scende al piu' bitWidth(count) livelli: dopo tanti passi
+    // tutti i k superano m_count. Le ricerche gia' concluse restano ferme
+    // (leggono la sentinella in posizione 0).
+    int levels = 0;
+    while ((m_count >> levels) != 0) {
+        levels++;
+    }
+
+    for (size_t base = 0; base < count; base += BATCH_LANES) {
+        const size_t lanes = std::min(BATCH_LANES, count - base);
+        uint64_t keys[BATCH_LANES];
+        uint64_t k[BATCH_LANES];
+        for (size_t j = 0; j < lanes; j++) {
+            keys[j] = cfs[base + j].getCanonical().getValue();
+            k[j] = 1;
+        }
+
+        for (int level = 0; level < levels; level++) {
+            for (size_t j = 0; j < lanes; j++) {
+                const bool active = k[j] <= m_count;
+                const uint64_t node = active ? k[j] : 0;
+                prefetch(reinterpret_cast<const char*>(m_keys) + node * KEYS_PER_LINE * sizeof(uint64_t));
+                const uint64_t next = 2 * k[j] + (m_keys[node] < keys[j] ? 1 : 0);
+                k[j] = active ? next : k[j];
+            }
+        }
+
+        for (size_t j = 0; j < lanes; j++) {
+            const uint64_t node = k[j] >> (lowestBit(~k[j]) + 1);
+            offsets[base + j] = m_keys[node] == keys[j] ? m_offsets[node] : NOT_FOUND;
+        }
+    }
+}
+
+std::optional<uint64_t> RosterIndex::lookupCodiceFiscale(std::wstring_view cf) const {
+    if (cf.size() != 16) {
+        return std::nullopt;
+    }
+    auto packed = PackedCF::pack(cf.data());
+    if (!packed.has_value()) {
+        return std::nullopt;
+    }
+    return lookup(*packed);
+}
+
+// ============================================================================
+// Serializzazione
+// ============================================================================
+
+bool RosterIndex::save(const std::filesystem::path& path) const {
+    if (m_keys == nullptr) {
+        return false;
+    }
+
+    FileHeader header = {};
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(header.magic));
+    header.version = FORMAT_VERSION;
+    header.count = m_count;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    const std::streamsize arrayBytes = static_cast<std::streamsize>((m_count + 1) * sizeof(uint64_t));
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(m_keys), arrayBytes);
+    file.write(reinterpret_cast<const char*>(m_offsets), arrayBytes);
+    return static_cast<bool>(file);
+}
+
+bool RosterIndex::load(const std::filesystem::path& path) {
+    MappedFile file;
+    if (!file.open(path) || file.getSize() < sizeof(FileHeader)) {
+        return false;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, file.getData(), sizeof(header));
+    if (std::memcmp(header.magic, FILE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != FORMAT_VERSION ||
+        header.count >= (file.getSize() - sizeof(FileHeader)) / (2 * sizeof(uint64_t)) ||
+        file.getSize() != sizeof(FileHeader) + 2 * (header.count + 1) * sizeof(uint64_t)) {
+        return false;
+    }
+
+    m_ownedKeys.clear();
+    m_ownedKeys.shrink_to_fit();
+    m_ownedOffsets.clear();
+    m_ownedOffsets.shrink_to_fit();
+    m_file = std::move(file);
+    m_keys = reinterpret_cast<const uint64_t*>(m_file.getData() + sizeof(FileHeader));
+    m_offsets = m_keys + header.count + 1;
+    m_count = header.count;
+    return true;
+}
+
+} // namespace cfparser
@@ -0,0 +1,126 @@
+#ifndef ROSTER_INDEX_H
+#define ROSTER_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <vector>
+#include "mapped_file.h"
+#include "packed_cf.h"
+
+namespace cfparser {
+
+/**
+ * @brief Voce dell'indice: codice fiscale e posizione del record.
+ */
+struct IndexEntry {
+    PackedCF cf;        ///< Codice (viene indicizzato il codice canonico)
+    uint64_t offset;    ///< Offset del record nel file dell'anagrafica
+};
+
+/**
+ * @brief Indice esatto codice fiscale -> offset del record, su file.
+ *
+ * Le chiavi (codici canonici, senza omocodia) sono ordinate e disposte in
+ * ordine di Eytzinger: il nodo k ha figli 2k e 2k+1, come in uno heap. La
+ * ricerca scende l'albero senza salti condizionati e i nodi dei livelli
+ * successivi sono contigui, quindi si possono precaricare: con 8 chiavi per
+ * linea di cache, una linea copre 3 livelli.
+ *
+ * Occupa 16 byte per voce (chiave + offset, in due array separati: la
+ * ricerca legge solo le chiavi). Il file viene mappato in memoria e usato
+ * cosi' com'e', senza lettura iniziale.
+ *
+ * Formato del file (little-endian): intestazione FileHeader di 64 byte,
+ * chiavi uint64_t[count + 1] (la posizione 0 e' una sentinella), offset
+ * uint64_t[count + 1] nello stesso ordine.
+ */
+class RosterIndex {
+public:
+    /// Valore restituito da lookupBatch() per i codici assenti
+    static constexpr uint64_t NOT_FOUND = UINT64_MAX;
+
+    RosterIndex() = default;
+
+    /**
+     * @brief Costruisce l'indice in memoria.
+     *
+     * A parita' di codice canonico (record duplicati o varianti omocodiche)
+     * viene tenuto l'offset minore, cioe' il primo record del file.
+     */
+    static RosterIndex build(std::vector<IndexEntry> entries);
+
+    /**
+     * @brief Salva l'indice su file.
+     *
+     * @return true se la scrittura e' riuscita
+     */
+    bool save(const std::filesystem::path& path) const;
+
+    /**
+     * @brief Apre un indice salvato con save(), mappandolo in memoria.
+     *
+     * @return true se il file esiste e ha un formato valido
+     */
+    bool load(const std::filesystem::path& path);
+
+    /**
+     * @brief Indica se l'indice contiene dati (costruito o caricato).
+     */
+    bool isLoaded() const { return m_keys != nullptr; }
+
+    /**
+     * @brief Cerca un codice (o una sua variante omocodica).
+     *
+     * @return L'offset del record, o std::nullopt se il codice non c'e'
+     */
+    std::optional<uint64_t> lookup(PackedCF cf) const;
+
+    /**
+     * @brief Come sopra, a partire dal testo del codice.
+     *
+     * @return std::nullopt anche se il codice non e' valido
+     */
+    std::optional<uint64_t> lookupCodiceFiscale(std::wstring_view cf) const;
+
+    /**
+     * @brief Cerca molti codici insieme.
+     *
+     * Conviene per le scansioni massive: le ricerche procedono a gruppi di
+     * 16, un livello dell'albero alla volta, quindi gli accessi a memoria di
+     * codici diversi si sovrappongono invece di attendersi a vicenda.
+     *
+     * @param cfs Codici da cercare
+     * @param count Numero di codici
+     * @param offsets Output: offset del record, o NOT_FOUND
+     */
+    void lookupBatch(const PackedCF* cfs, size_t count, uint64_t* offsets) const;
+
+    /**
+     * @brief Numero di codici distinti nell'indice.
+     */
+    uint64_t getKeyCount() const { return m_count; }
+
+private:
+    struct FileHeader {
+        char magic[8];          ///< "MWCFIDX\0"
+        uint32_t version;       ///< FORMAT_VERSION
+        uint32_t reserved;
+        uint64_t count;         ///< Numero di chiavi
+        uint64_t padding[5];    ///< Allinea le chiavi a 64 byte
+    };
+    static_assert(sizeof(FileHeader) == 64, "L'intestazione deve occupare una linea di cache");
+
+    const uint64_t* m_keys = nullptr;     ///< Chiavi in ordine di Eytzinger (da 1)
+    const uint64_t* m_offsets = nullptr;  ///< Offset, stesso ordine delle chiavi
+    uint64_t m_count = 0;
+    std::vector<uint64_t> m_ownedKeys;    ///< Dati dell'indice costruito in memoria
+    std::vector<uint64_t> m_ownedOffsets;
+    MappedFile m_file;                    ///< File mappato dell'indice caricato
+};
+
+} // namespace cfparser
+
+#endif // ROSTER_INDEX_H
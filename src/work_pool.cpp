@@ -0,0 +1,115 @@
+#include "work_pool.h"
+#include <algorithm>
+
+namespace cfparser {
+
+WorkPool::WorkPool(unsigned threads) {
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    if (threads == 0) {
+        threads = 1;
+    }
+
+    m_queues.reset(new Queue[threads]);
+    m_threads.reserve(threads);
+    for (unsigned worker = 0; worker < threads; worker++) {
+        m_threads.emplace_back(&WorkPool::workerLoop, this, worker);
+    }
+}
+
+WorkPool::~WorkPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void WorkPool::run(size_t count, const std::function<void(size_t index, unsigned worker)>& task) {
+    if (count == 0) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const size_t threads = m_threads.size();
+    for (size_t worker = 0; worker < threads; worker++) {
+        std::lock_guard<std::mutex> queueLock(m_queues[worker].mutex);
+        m_queues[worker].begin = count / threads * worker + std::min(worker, count % threads);
+        m_queues[worker].end = count / threads * (worker + 1) + std::min(worker + 1, count % threads);
+    }
+    m_task = &task;
+    m_busy = static_cast<unsigned>(threads);
+    m_generation++;
+    m_wake.notify_all();
+
+    m_done.wait(lock, [this] { return m_busy == 0; });
+    m_task = nullptr;
+}
+
+bool WorkPool::takeTask(unsigned worker, size_t& index) {
+    Queue& own = m_queues[worker];
+    {
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (own.begin < own.end) {
+            index = own.begin++;
+            return true;
+        }
+    }
+
+    // Furto: la meta' finale dell'intervallo di un altro thread
+    const unsigned threads = getThreadCount();
+    for (unsigned k = 1; k < threads; k++) {
+        Queue& victim = m_queues[(worker + k) % threads];
+        size_t stolenBegin;
+        size_t stolenEnd;
+        {
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            const size_t remaining = victim.end - victim.begin;
+            if (remaining == 0) {
+                continue;
+            }
+            stolenEnd = victim.end;
+            stolenBegin = victim.end - (remaining + 1) / 2;
+            victim.end = stolenBegin;
+        }
+
+        std::lock_guard<std::mutex> lock(own.mutex);
+        own.begin = stolenBegin + 1;
+        own.end = stolenEnd;
+        index = stolenBegin;
+        return true;
+    }
+    return false;
+}
+
+void WorkPool::workerLoop(unsigned worker) {
+    uint64_t seen = 0;
+    for (;;) {
+        const std::function<void(size_t, unsigned)>* task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+            if (m_stop) {
+                return;
+            }
+            seen = m_generation;
+            task = m_task;
+        }
+
+        size_t index;
+        while (takeTask(worker, index)) {
+            (*task)(index, worker);
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_busy == 0) {
+            m_done.notify_one();
+        }
+    }
+}
+
+} // namespace cfparser
@@ -0,0 +1,72 @@
+#ifndef WORK_POOL_H
+#define WORK_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cfparser {
+
+/**
+ * @brief Pool di thread con work stealing per lavori indicizzati.
+ *
+ * run() divide gli indici [0, count) in intervalli contigui, uno per
+ * thread: ogni thread consuma il proprio dall'inizio (nell'ordine degli
+ * indici, a vantaggio della localita') e, quando l'ha esaurito, ruba la
+ * meta' finale dell'intervallo rimasto a un altro thread. I lavori di
+ * durata molto diversa (file piccoli e grandi) si bilanciano da soli.
+ *
+ * I thread vengono creati una volta e riusati tra una chiamata e l'altra.
+ */
+class WorkPool {
+public:
+    /**
+     * @param threads Numero di thread (0 = tutti i core)
+     */
+    explicit WorkPool(unsigned threads = 0);
+    ~WorkPool();
+
+    WorkPool(const WorkPool&) = delete;
+    WorkPool& operator=(const WorkPool&) = delete;
+
+    /**
+     * @brief Esegue task(indice, thread) per ogni indice e attende la fine.
+     *
+     * @param count Numero di lavori
+     * @param task Funzione chiamata in parallelo; thread e' in [0, getThreadCount())
+     */
+    void run(size_t count, const std::function<void(size_t index, unsigned worker)>& task);
+
+    unsigned getThreadCount() const { return static_cast<unsigned>(m_threads.size()); }
+
+private:
+    /// Intervallo di lavori di un thread (una linea di cache ciascuno)
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    void workerLoop(unsigned worker);
+    bool takeTask(unsigned worker, size_t& index);
+
+    std::vector<std::thread> m_threads;
+    std::unique_ptr<Queue[]> m_queues;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;     ///< Nuovo lavoro o arresto
+    std::condition_variable m_done;     ///< Tutti i thread hanno finito
+    const std::function<void(size_t, unsigned)>* m_task = nullptr;
+    uint64_t m_generation = 0;          ///< Incrementato a ogni run()
+    unsigned m_busy = 0;                ///< Thread ancora al lavoro
+    bool m_stop = false;
+};
+
+} // namespace cfparser
+
+#endif // WORK_POOL_H
@@ -0,0 +1,62 @@
+/**
+ * @file belfiore_test.cpp
+ * @brief Test della tabella dei codici catastali e di isPlausibleBirthplace()
+ *
+ * Un codice soppresso e' accettato fino alla data di cessazione e
+ * respinto dopo; un codice con numero 000 e' sempre respinto. Un codice
+ * assente dalla tabella e' respinto solo se la tabella e' completa.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include "belfiore.h"
+
+using namespace cfparser::belfiore;
+
+struct Case {
+    const char* name;
+    const char* cf;
+    uint32_t birthDate;
+    bool plausible;
+};
+
+static const Case CASES[] = {
+    {"comune in uso", "RSSMRA85T10H501S", 19851210, true},
+    {"data di nascita non nota", "RSSMRA85T10Z111X", 0, true},
+    {"stato soppresso, nato prima della cessazione", "RSSMRA85T10Z111X", 19851210, true},
+    {"stato soppresso, nato il giorno della cessazione", "RSSMRA90R02Z111X", 19901002, true},
+    {"stato soppresso, nato dopo la cessazione", "RSSMRA95T10Z111X", 19951210, false},
+    {"stato soppresso con cifre omocodiche", "RSSMRA95T10Z1MMX", 19951210, false},
+    {"URSS dopo la cessazione", "RSSMRA92A01Z135X", 19920101, false},
+    {"numero 000", "RSSMRA85T10A000X", 19851210, false},
+    {"numero 000 omocodico", "RSSMRA85T10ZLLLX", 19851210, false},
+    {"codice non in tabella", "RSSMRA85T10M999X", 19851210, !isTableComplete()},
+};
+
+int main() {
+    int failures = 0;
+    for (const Case& c : CASES) {
+        const bool plausible = isPlausibleBirthplace(c.cf, c.birthDate);
+        if (plausible != c.plausible) {
+            std::fprintf(stderr, "%s: %s il %u, atteso %d\n", c.name, c.cf, c.birthDate, c.plausible ? 1 : 0);
+            failures++;
+        }
+    }
+
+    // Il codice soppresso e' in tabella con la data di cessazione
+    const Place* place = lookup("Z111");
+    if (place == nullptr || place->validTo == 0 || !place->isForeign()) {
+        std::fprintf(stderr, "Z111 assente o senza data di cessazione\n");
+        failures++;
+    }
+    if (lookup("A000") != nullptr) {
+        std::fprintf(stderr, "A000 presente in tabella\n");
+        failures++;
+    }
+
+    if (failures == 0) {
+        std::printf("%zu casi: nessuna differenza (tabella %s, %zu codici)\n", sizeof(CASES) / sizeof(CASES[0]),
+                    isTableComplete() ? "completa" : "parziale", placeCount());
+    }
+    return failures == 0 ? 0 : 1;
+}
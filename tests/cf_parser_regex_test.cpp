@@ -0,0 +1,234 @@
+/**
+ * @file cf_parser_regex_test.cpp
+ * @brief Test differenziale dell'automa di cf_parser contro la regex originale
+ *
+ * Uso:
+ *   test_cf_parser_regex [iterazioni] [seme]
+ *
+ * Genera codici vicini ai confini della grammatica (omocodie, mesi e
+ * giorni ai limiti, CIN giusti e sbagliati, maiuscole e minuscole,
+ * caratteri alterati) immersi in testo casuale, e confronta
+ * isValidCodiceFiscale(), validateBatch() e findCodiceFiscale() con la
+ * std::wregex usata prima dell'automa (con la decina del giorno corretta
+ * in [1256MNRS]). Il primo disaccordo viene stampato e il test fallisce.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "cf_parser.h"
+
+using cfparser::findCodiceFiscale;
+using cfparser::isValidCodiceFiscale;
+
+// ============================================================================
+// Riferimento: la regex e il calcolo del CIN della versione originale
+// ============================================================================
+
+static const std::wregex REFERENCE(
+    L"(?:(?:[B-DF-HJ-NP-TV-Z]|[AEIOU])[AEIOU][AEIOUX]|[B-DF-HJ-NP-TV-Z]{2}[A-Z]){2}"
+    L"[\\dLMNP-V]{2}"
+    L"(?:[A-EHLMPR-T](?:[04LQ][1-9MNP-V]|[1256MNRS][\\dLMNP-V])|[DHPS][37PT][0L]|[ACELMRT][37PT][01LM])"
+    L"(?:[A-MZ][1-9MNP-V][\\dLMNP-V]{2}|[A-M][0L](?:[1-9MNP-V][\\dLMNP-V]|[0L][1-9MNP-V]))"
+    L"[A-Z]",
+    std::regex_constants::icase
+);
+
+static const int CIN_ODD_VALUES[] = {
+    1,  0,  5, 7, 9, 13, 15, 17, 19, 21,
+    1,  0,  5, 7, 9, 13, 15, 17, 19, 21,
+    2,  4, 18, 20, 11,  3,  6,  8, 12, 14,
+    16, 10, 22, 25, 24, 23
+};
+
+static const int CIN_EVEN_VALUES[] = {
+    0,  1,  2,  3,  4,  5,  6,  7,  8,  9,
+    0,  1,  2,  3,  4,  5,  6,  7,  8,  9,
+    10, 11, 12, 13, 14, 15, 16, 17, 18, 19,
+    20, 21, 22, 23, 24, 25
+};
+
+static int symbolIndex(wchar_t c) {
+    if (c >= L'0' && c <= L'9') {
+        return c - L'0';
+    }
+    if (c >= L'a' && c <= L'z') {
+        return c - L'a' + 10;
+    }
+    if (c >= L'A' && c <= L'Z') {
+        return c - L'A' + 10;
+    }
+    return 0;
+}
+
+static wchar_t referenceCIN(const std::wstring& cf) {
+    int sum = 0;
+    for (int i = 0; i < 15; i++) {
+        const int index = symbolIndex(cf[i]);
+        sum += i % 2 == 0 ? CIN_ODD_VALUES[index] : CIN_EVEN_VALUES[index];
+    }
+    return static_cast<wchar_t>(L'A' + sum % 26);
+}
+
+static bool referenceValid(const std::wstring& cf) {
+    if (cf.size() != 16 || !std::regex_match(cf, REFERENCE)) {
+        return false;
+    }
+    const wchar_t cin = cf[15] >= L'a' && cf[15] <= L'z' ? static_cast<wchar_t>(cf[15] - 32) : cf[15];
+    return referenceCIN(cf) == cin;
+}
+
+// ============================================================================
+// Generazione dei casi
+// ============================================================================
+
+static const std::wstring LETTERS = L"ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+static const std::wstring DIGITS_OMOCODIA = L"0123456789LMNPQRSTUV";
+static const std::wstring NOISE =
+    L"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789 -:;./\u00e0\u00c8\u20ac\uff21";
+
+class CaseGenerator {
+public:
+    explicit CaseGenerator(uint32_t seed) : m_random(seed) {}
+
+    /**
+     * @brief Codice di 16 caratteri vicino alla grammatica.
+     */
+    std::wstring code() {
+        std::wstring cf(16, L'A');
+        for (int i = 0; i < 6; i++) {
+            cf[i] = pick(chance(60) ? std::wstring(L"AEIOUX") : LETTERS);
+        }
+        cf[6] = pick(DIGITS_OMOCODIA);
+        cf[7] = pick(DIGITS_OMOCODIA);
+        cf[8] = pick(chance(90) ? std::wstring(L"ABCDEHLMPRST") : LETTERS);
+        cf[9] = pick(chance(85) ? std::wstring(L"01234567LMNPQRST") : DIGITS_OMOCODIA);
+        cf[10] = pick(DIGITS_OMOCODIA);
+        cf[11] = pick(chance(85) ? std::wstring(L"ABCDEFGHIJKLMZ") : LETTERS);
+        for (int i = 12; i < 15; i++) {
+            cf[i] = pick(chance(30) ? std::wstring(L"0L") : DIGITS_OMOCODIA);
+        }
+        cf[15] = chance(70) ? referenceCIN(cf) : pick(LETTERS);
+
+        if (chance(25)) {
+            cf[below(16)] = pick(NOISE);
+        }
+        if (chance(30)) {
+            for (wchar_t& c : cf) {
+                if (c >= L'A' && c <= L'Z' && chance(50)) {
+                    c = static_cast<wchar_t>(c + 32);
+                }
+            }
+        }
+        return cf;
+    }
+
+    /**
+     * @brief Testo con uno o due codici tra rumore prevalentemente alfanumerico.
+     */
+    std::wstring text(const std::wstring& first) {
+        std::wstring result = noise();
+        result += first;
+        result += noise();
+        if (chance(30)) {
+            result += code();
+            result += noise();
+        }
+        return result;
+    }
+
+private:
+    bool chance(unsigned percent) { return below(100) < percent; }
+    size_t below(size_t n) { return std::uniform_int_distribution<size_t>(0, n - 1)(m_random); }
+    wchar_t pick(const std::wstring& set) { return set[below(set.size())]; }
+
+    std::wstring noise() {
+        std::wstring result(below(20), L' ');
+        for (wchar_t& c : result) {
+            c = pick(NOISE);
+        }
+        return result;
+    }
+
+    std::mt19937 m_random;
+};
+
+static void printCase(const char* what, const std::wstring& text) {
+    std::string ascii;
+    for (wchar_t c : text) {
+        ascii += c < 0x80 ? static_cast<char>(c) : '?';
+    }
+    std::fprintf(stderr, "%s: \"%s\"\n", what, ascii.c_str());
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    const unsigned long iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    const uint32_t seed = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 20261017;
+    CaseGenerator generator(seed);
+
+    std::vector<char16_t> records;
+    std::vector<uint8_t> expected;
+    unsigned long validCodes = 0;
+    unsigned long matches = 0;
+
+    for (unsigned long n = 0; n < iterations; n++) {
+        const std::wstring cf = generator.code();
+        const bool reference = referenceValid(cf);
+        if (isValidCodiceFiscale(cf) != reference) {
+            printCase(reference ? "valido per la regex, rifiutato" : "non valido per la regex, accettato", cf);
+            return 1;
+        }
+        validCodes += reference ? 1 : 0;
+        records.insert(records.end(), cf.begin(), cf.end());
+        expected.push_back(reference ? 1 : 0);
+
+        // Ricerca: tutte le occorrenze, da sinistra a destra e senza sovrapposizioni
+        const std::wstring text = generator.text(cf);
+        const std::u16string text16(text.begin(), text.end());
+        std::vector<size_t> found;
+        for (auto it = std::wsregex_iterator(text.begin(), text.end(), REFERENCE); it != std::wsregex_iterator();
+             ++it) {
+            found.push_back(static_cast<size_t>(it->position()));
+        }
+        size_t k = 0;
+        size_t pos = findCodiceFiscale(std::wstring_view(text), 0);
+        while (pos != std::wstring_view::npos) {
+            if (k >= found.size() || found[k] != pos ||
+                findCodiceFiscale(std::u16string_view(text16), k == 0 ? 0 : found[k - 1] + 16) != pos) {
+                printCase("ricerca diversa dalla regex", text);
+                return 1;
+            }
+            k++;
+            pos = findCodiceFiscale(std::wstring_view(text), pos + 16);
+        }
+        if (k != found.size()) {
+            printCase("codice trovato dalla regex e non dall'automa", text);
+            return 1;
+        }
+        matches += k;
+    }
+
+    // Verifica a lotti (percorso vettoriale) sugli stessi codici
+    const size_t count = expected.size();
+    std::vector<uint8_t> results(count);
+    cfparser::validateBatch(reinterpret_cast<const char16_t(*)[16]>(records.data()), count, results.data());
+    for (size_t i = 0; i < count; i++) {
+        if ((results[i] == 0) != (expected[i] == 1)) {
+            printCase("validateBatch diverso dalla regex",
+                      std::wstring(records.begin() + i * 16, records.begin() + i * 16 + 16));
+            return 1;
+        }
+    }
+
+    std::printf("%lu codici (%lu validi), %lu occorrenze nei testi: nessuna differenza\n", iterations, validCodes,
+                matches);
+    return 0;
+}
@@ -0,0 +1,239 @@
+/**
+ * @file cf_pseudonym_test.cpp
+ * @brief Test della pseudonimizzazione dei codici fiscali
+ *
+ * - AES-128 software con i vettori di FIPS-197 (appendici B e C.1)
+ * - pseudonimi noti per una chiave e un tweak fissi
+ * - andata e ritorno su codici casuali, anche omocodici, con AES-NI e con
+ *   l'implementazione software (che devono dare gli stessi pseudonimi) e
+ *   con le versioni a lotti
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "cf_parser.h"
+#include "cf_pseudonym.h"
+
+using cfparser::Pseudonymizer;
+
+using Record = char16_t[16];
+
+/// Codici casuali per l'andata e ritorno
+static constexpr size_t RANDOM_CODES = 20000;
+
+static bool parseHex(const char* hex, uint8_t (&out)[16]) {
+    return cfparser::parseKeyHex(hex, out);
+}
+
+static std::string toText(const char16_t* code) {
+    return std::string(code, code + 16);
+}
+
+static void toRecord(const char* text, Record& out) {
+    for (size_t i = 0; i < 16; i++) {
+        out[i] = static_cast<char16_t>(text[i]);
+    }
+}
+
+// ============================================================================
+// AES-128 (FIPS-197)
+// ============================================================================
+
+struct AesVector {
+    const char* key;
+    const char* plaintext;
+    const char* ciphertext;
+};
+
+static const AesVector AES_VECTORS[] = {
+    {"2b7e151628aed2a6abf7158809cf4f3c", "3243f6a8885a308d313198a2e0370734", "3925841d02dc09fbdc118597196a0b32"},
+    {"000102030405060708090a0b0c0d0e0f", "00112233445566778899aabbccddeeff", "69c4e0d86a7b0430d8cdb78070b4c55a"},
+};
+
+static int testAes() {
+    int failures = 0;
+    for (const AesVector& v : AES_VECTORS) {
+        uint8_t key[16], block[16], expected[16];
+        parseHex(v.key, key);
+        parseHex(v.plaintext, block);
+        parseHex(v.ciphertext, expected);
+        cfparser::encryptAesBlock(key, block);
+        if (std::memcmp(block, expected, 16) != 0) {
+            std::fprintf(stderr, "AES-128, chiave %s: cifrato errato\n", v.key);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+// ============================================================================
+// Pseudonimi noti
+// ============================================================================
+
+static const char* const KNOWN_KEY = "000102030405060708090a0b0c0d0e0f";
+static const char* const KNOWN_TWEAK = "studio";
+
+struct KnownPseudonym {
+    const char* code;
+    const char* pseudonym;
+};
+
+// Pseudonimi degli export gia' consegnati: se cambiano, le nuove versioni
+// non sono piu' confrontabili con le precedenti
+static const KnownPseudonym KNOWN[] = {
+    {"RSSMRA85T10A562S", "VXYEUE48R20A381U"},
+    {"RSSMRA85T10A56NH", "VXYEUE48R20A381U"},   // omocodico: stesso pseudonimo
+    {"VRDLRA80A41H501T", "NXJRJC77P64D892A"},
+    {"BNCGPP70M15F205K", "CSENKY24M23J784U"},
+};
+
+static int testKnown(const Pseudonymizer& pseudonymizer) {
+    int failures = 0;
+    for (const KnownPseudonym& k : KNOWN) {
+        Record code, out;
+        toRecord(k.code, code);
+        if (!pseudonymizer.encrypt(code, out) || toText(out) != k.pseudonym) {
+            std::fprintf(stderr, "%s (%s): pseudonimo %s, atteso %s\n", k.code,
+                         pseudonymizer.usesHardwareAes() ? "AES-NI" : "software", toText(out).c_str(), k.pseudonym);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+// ============================================================================
+// Andata e ritorno
+// ============================================================================
+
+/**
+ * @brief Codice valido casuale; con omocodia, alcune cifre diventano lettere.
+ */
+static void randomCode(std::mt19937& random, bool omocodia, Record& out) {
+    static const char CONSONANTS[] = "BCDFGHJKLMNPQRSTVWXYZ";
+    static const char MONTHS[] = "ABCDEHLMPRST";
+    static const char OMOCODES[] = "LMNPQRSTUV";
+    static const int DIGIT_POSITIONS[] = {6, 7, 9, 10, 12, 13, 14};
+    const auto below = [&](unsigned n) { return std::uniform_int_distribution<unsigned>(0, n - 1)(random); };
+
+    char cf[16];
+    for (int i = 0; i < 6; i += 3) {
+        cf[i] = CONSONANTS[below(21)];
+        cf[i + 1] = CONSONANTS[below(21)];
+        cf[i + 2] = static_cast<char>('A' + below(26));
+    }
+    const unsigned day = 1 + below(28) + (below(2) ? 40 : 0);
+    cf[6] = static_cast<char>('0' + below(10));
+    cf[7] = static_cast<char>('0' + below(10));
+    cf[8] = MONTHS[below(12)];
+    cf[9] = static_cast<char>('0' + day / 10);
+    cf[10] = static_cast<char>('0' + day % 10);
+    cf[11] = below(10) == 0 ? 'Z' : static_cast<char>('A' + below(13));
+    cf[12] = static_cast<char>('1' + below(9));
+    cf[13] = static_cast<char>('0' + below(10));
+    cf[14] = static_cast<char>('0' + below(10));
+    if (omocodia) {
+        // Sostituzioni da destra, come negli omocodici reali
+        const unsigned count = 1 + below(7);
+        for (unsigned i = 0; i < count; i++) {
+            const int pos = DIGIT_POSITIONS[6 - i];
+            cf[pos] = OMOCODES[cf[pos] - '0'];
+        }
+    }
+    cf[15] = 'A';
+    for (size_t i = 0; i < 16; i++) {
+        out[i] = static_cast<char16_t>(cf[i]);
+    }
+    out[15] = cfparser::calculateCIN(std::u16string_view(out, 16));
+}
+
+/**
+ * @brief Codice base (senza omocodia, CIN ricalcolato), come restituito da decrypt().
+ */
+static void canonicalCode(const Record& code, Record& out) {
+    cfparser::normalizeOmocodia(std::u16string_view(code, 16), out);
+    out[15] = cfparser::calculateCIN(std::u16string_view(out, 16));
+}
+
+static int testRoundTrip(const Pseudonymizer& hardware, const Pseudonymizer& software) {
+    std::mt19937 random(20261017);
+    const std::unique_ptr<Record[]> codes(new Record[RANDOM_CODES]);
+    const std::unique_ptr<Record[]> pseudonyms(new Record[RANDOM_CODES]);
+    const std::unique_ptr<Record[]> batch(new Record[RANDOM_CODES]);
+    std::vector<uint8_t> ok(RANDOM_CODES);
+    int failures = 0;
+
+    for (size_t i = 0; i < RANDOM_CODES; i++) {
+        randomCode(random, i % 4 == 0, codes[i]);
+    }
+
+    for (size_t i = 0; i < RANDOM_CODES && failures < 10; i++) {
+        Record canonical, pseudonym, other, back;
+        canonicalCode(codes[i], canonical);
+
+        bool valid = hardware.encrypt(codes[i], pseudonym) &&
+                     cfparser::isValidCodiceFiscale(std::u16string_view(pseudonym, 16));
+        valid = valid && software.encrypt(codes[i], other) && std::memcmp(pseudonym, other, sizeof(Record)) == 0;
+        valid = valid && hardware.decrypt(pseudonym, back) && std::memcmp(back, canonical, sizeof(Record)) == 0;
+        valid = valid && software.decrypt(pseudonym, other) && std::memcmp(back, other, sizeof(Record)) == 0;
+        if (!valid) {
+            std::fprintf(stderr, "%s: pseudonimo %s, ritorno %s\n", toText(codes[i]).c_str(),
+                         toText(pseudonym).c_str(), toText(back).c_str());
+            failures++;
+        }
+        std::memcpy(pseudonyms[i], pseudonym, sizeof(Record));
+    }
+
+    // Lotti: stessi pseudonimi e ritorno ai codici canonici
+    if (hardware.encryptBatch(codes.get(), RANDOM_CODES, batch.get(), ok.data()) != RANDOM_CODES ||
+        std::memcmp(batch.get(), pseudonyms.get(), RANDOM_CODES * sizeof(Record)) != 0) {
+        std::fprintf(stderr, "encryptBatch diverso da encrypt\n");
+        failures++;
+    }
+    if (software.decryptBatch(batch.get(), RANDOM_CODES, batch.get(), ok.data()) != RANDOM_CODES) {
+        std::fprintf(stderr, "decryptBatch: codici non convertiti\n");
+        failures++;
+    }
+    for (size_t i = 0; i < RANDOM_CODES; i++) {
+        Record canonical;
+        canonicalCode(codes[i], canonical);
+        if (std::memcmp(batch[i], canonical, sizeof(Record)) != 0) {
+            std::fprintf(stderr, "decryptBatch: %s invece di %s\n", toText(batch[i]).c_str(),
+                         toText(canonical).c_str());
+            failures++;
+            break;
+        }
+    }
+
+    // Un codice non valido viene azzerato
+    Record invalid, out;
+    toRecord("RSSMRA85T10A562X", invalid);
+    if (hardware.encrypt(invalid, out) || out[0] != u'\0') {
+        std::fprintf(stderr, "RSSMRA85T10A562X: CIN errato accettato\n");
+        failures++;
+    }
+    return failures;
+}
+
+int main() {
+    int failures = testAes();
+
+    uint8_t key[16];
+    parseHex(KNOWN_KEY, key);
+    const Pseudonymizer hardware(key, KNOWN_TWEAK);
+    const Pseudonymizer software(key, KNOWN_TWEAK, false);
+    failures += testKnown(hardware);
+    failures += testKnown(software);
+    failures += testRoundTrip(hardware, software);
+
+    if (failures == 0) {
+        std::printf("AES-128, pseudonimi noti e %zu codici: nessuna differenza (%s)\n", RANDOM_CODES,
+                    hardware.usesHardwareAes() ? "AES-NI e software" : "solo software");
+    }
+    return failures == 0 ? 0 : 1;
+}
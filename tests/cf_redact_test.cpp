@@ -0,0 +1,76 @@
+/**
+ * @file cf_redact_test.cpp
+ * @brief Test di StreamRedactor: codici sovrapposti e blocchi spezzati
+ *
+ * Ogni caso viene elaborato in un solo blocco, un byte alla volta e
+ * spezzato in due blocchi in ogni punto: l'output deve essere sempre lo
+ * stesso.
+ */
+
+#include <cstdio>
+#include <string>
+#include "cf_redact.h"
+
+using cfparser::RedactOptions;
+using cfparser::StreamRedactor;
+
+struct Case {
+    const char* name;
+    const char* input;
+    const char* expected;
+    bool includeInvalidCIN;
+};
+
+// "DTSJQH0RB5PIPRSS" (offset 2, CIN errato) si sovrappone a
+// "RSSMRA85T10A562S" (offset 15, valido)
+static const Case CASES[] = {
+    {"codice valido nascosto da un CIN errato",
+     " XDTSJQH0RB5PIPRSSMRA85T10A562S \n",
+     " XDTSJQH0RB5PIP**************** \n", false},
+    {"codici sovrapposti, anche con CIN errato",
+     " XDTSJQH0RB5PIPRSSMRA85T10A562S \n",
+     " X******************************** \n", true},
+    {"codici separati e minuscole",
+     "paziente RSSMRA85T10A562S, rssmra85t10a562s; VRDLRA80A41H501T\n",
+     "paziente ****************, ****************; ****************\n", false},
+    {"CIN errato lasciato invariato",
+     "cf RSSMRA85T10A562X fine",
+     "cf RSSMRA85T10A562X fine", false},
+};
+
+static std::string redact(const Case& c, const std::string& input, size_t split) {
+    RedactOptions options;
+    options.includeInvalidCIN = c.includeInvalidCIN;
+    StreamRedactor redactor(options);
+    std::string out;
+    if (split == 0) {
+        // Un byte alla volta
+        for (char ch : input) {
+            redactor.feed(&ch, 1, out);
+        }
+    } else {
+        redactor.feed(input.data(), split, out);
+        redactor.feed(input.data() + split, input.size() - split, out);
+    }
+    redactor.finish(out);
+    return out;
+}
+
+int main() {
+    int failures = 0;
+    for (const Case& c : CASES) {
+        const std::string input = c.input;
+        for (size_t split = 0; split <= input.size(); split++) {
+            const std::string out = redact(c, input, split);
+            if (out != c.expected) {
+                std::fprintf(stderr, "%s (blocchi da %zu): \"%s\"\n", c.name, split, out.c_str());
+                failures++;
+                break;
+            }
+        }
+    }
+    if (failures == 0) {
+        std::printf("%zu casi: nessuna differenza\n", sizeof(CASES) / sizeof(CASES[0]));
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file cf_service_test.cpp
+ * @brief Test del protocollo di ServiceConnection (senza socket)
+ *
+ * Verifica le intestazioni Connection e la persistenza della connessione
+ * per HTTP/1.1 e HTTP/1.0: un client HTTP/1.0 che chiede keep-alive deve
+ * ricevere "Connection: keep-alive", altrimenti attende la chiusura.
+ */
+
+#include <cstdio>
+#include <string>
+#include "cf_service.h"
+
+using cfparser::ServiceConnection;
+using cfparser::ServiceStats;
+
+struct Case {
+    const char* name;
+    const char* request;
+    const char* connectionHeader;   ///< Intestazione attesa, nullptr se assente
+    bool open;                      ///< La connessione resta aperta
+};
+
+static const Case CASES[] = {
+    {"HTTP/1.1", "GET /validate?cf=RSSMRA85T10A562S HTTP/1.1\r\n\r\n", nullptr, true},
+    {"HTTP/1.1 con close", "GET /validate?cf=RSSMRA85T10A562S HTTP/1.1\r\nConnection: close\r\n\r\n",
+     "Connection: close", false},
+    {"HTTP/1.0", "GET /validate?cf=RSSMRA85T10A562S HTTP/1.0\r\n\r\n", "Connection: close", false},
+    {"HTTP/1.0 con keep-alive", "GET /validate?cf=RSSMRA85T10A562S HTTP/1.0\r\nConnection: Keep-Alive\r\n\r\n",
+     "Connection: keep-alive", true},
+    {"versione non supportata", "GET / HTTP/2.0\r\n\r\n", "Connection: close", false},
+};
+
+int main() {
+    ServiceStats stats(1);
+    int failures = 0;
+    for (const Case& c : CASES) {
+        ServiceConnection connection(stats);
+        const std::string request = c.request;
+        std::string out;
+        const bool open = connection.feed(request.data(), request.size(), stats.getShard(0), out);
+
+        // Intestazioni, ciascuna terminata da CRLF
+        const size_t headerEnd = out.find("\r\n\r\n");
+        const std::string head = out.substr(0, headerEnd) + "\r\n";
+        const bool headerOk = c.connectionHeader == nullptr
+                                  ? head.find("\r\nConnection:") == std::string::npos
+                                  : head.find(std::string("\r\n") + c.connectionHeader + "\r\n") != std::string::npos;
+        if (headerEnd == std::string::npos || open != c.open || !headerOk) {
+            std::fprintf(stderr, "%s: aperta %d, risposta:\n%s\n", c.name, open ? 1 : 0, out.c_str());
+            failures++;
+        }
+    }
+    if (failures == 0) {
+        std::printf("%zu casi: nessuna differenza\n", sizeof(CASES) / sizeof(CASES[0]));
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file mwcf_csv.cpp
+ * @brief Tool per validare un export CSV di anagrafiche
+ *
+ * Uso:
+ *   mwcf_csv [opzioni] <input.csv | -> [risultati.csv]
+ *
+ * Opzioni:
+ *   -j N            Numero di thread (default: tutti i core)
+ *   -d SEP          Separatore di campo (default: rilevato; "tab" per TAB)
+ *   --no-header     La prima riga contiene gia' dati
+ *   --cf N          Colonna del codice fiscale (1 = prima)
+ *   --cognome N     Colonna del cognome
+ *   --nome N        Colonna del nome
+ *   --data N        Colonna della data di nascita
+ *   --sesso N       Colonna del sesso
+ *   --comune N      Colonna del comune o codice catastale di nascita
+ *
+ * Le colonne non indicate vengono cercate per nome nell'intestazione
+ * (es. "Codice fiscale", "Cognome", "Nome", "Data di nascita", "Sesso",
+ * "Comune nascita").
+ * I risultati (una riga per record) vanno nel file indicato o su stdout;
+ * il riepilogo con il conteggio dei problemi va su stderr.
+ *
+ * Codice di uscita: 0 se tutte le righe sono valide, 1 se ci sono righe
+ * con problemi, 2 in caso di errore.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "csv_validate.h"
+#include "mapped_file.h"
+
+static void printUsage() {
+    std::fprintf(stderr,
+                 "Uso: mwcf_csv [-j thread] [-d separatore] [--no-header] [--cf N] [--cognome N]\n"
+                 "              [--nome N] [--data N] [--sesso N] [--comune N]\n"
+                 "              <input.csv | -> [risultati.csv]\n");
+}
+
+static const char* columnName(int index, char* buffer, size_t size) {
+    if (index < 0) {
+        return "-";
+    }
+    std::snprintf(buffer, size, "%d", index + 1);
+    return buffer;
+}
+
+int main(int argc, char** argv) {
+    cfparser::CsvOptions options;
+    std::string inputPath;
+    std::string outputPath;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        int* column = nullptr;
+        if (std::strcmp(arg, "--cf") == 0) {
+            column = &options.columns.codiceFiscale;
+        } else if (std::strcmp(arg, "--cognome") == 0) {
+            column = &options.columns.surname;
+        } else if (std::strcmp(arg, "--nome") == 0) {
+            column = &options.columns.name;
+        } else if (std::strcmp(arg, "--data") == 0) {
+            column = &options.columns.birthDate;
+        } else if (std::strcmp(arg, "--sesso") == 0) {
+            column = &options.columns.sex;
+        } else if (std::strcmp(arg, "--comune") == 0) {
+            column = &options.columns.birthplace;
+        }
+
+        if (column != nullptr && hasValue) {
+            *column = std::atoi(argv[++i]) - 1;
+        } else if (std::strcmp(arg, "-j") == 0 && hasValue) {
+            options.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(arg, "-d") == 0 && hasValue) {
+            const char* sep = argv[++i];
+            options.delimiter = std::strcmp(sep, "tab") == 0 ? '\t' : sep[0];
+        } else if (std::strcmp(arg, "--no-header") == 0) {
+            options.header = false;
+        } else if (column == nullptr && inputPath.empty()) {
+            inputPath = arg;
+        } else if (column == nullptr && outputPath.empty()) {
+            outputPath = arg;
+        } else {
+            printUsage();
+            return 2;
+        }
+    }
+    if (inputPath.empty()) {
+        printUsage();
+        return 2;
+    }
+
+    std::FILE* input = inputPath == "-" ? stdin : cfparser::openFile(inputPath, "rb");
+    if (input == nullptr) {
+        std::fprintf(stderr, "Impossibile aprire %s\n", inputPath.c_str());
+        return 2;
+    }
+    std::FILE* output = outputPath.empty() ? stdout : cfparser::openFile(outputPath, "wb");
+    if (output == nullptr) {
+        std::fprintf(stderr, "Impossibile creare %s\n", outputPath.c_str());
+        return 2;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    cfparser::CsvReport report;
+    const bool ok = cfparser::validateCsv(input, output, options, report);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (input != stdin) {
+        std::fclose(input);
+    }
+    const bool closed = output == stdout ? std::fflush(output) == 0 : std::fclose(output) == 0;
+    if (!ok || !closed) {
+        std::fprintf(stderr, "%s: %s\n", inputPath.c_str(), ok ? "errore di scrittura" : report.error);
+        return 2;
+    }
+
+    char cf[16], surname[16], name[16], date[16], sex[16], place[16];
+    std::fprintf(stderr, "Colonne: cf %s, cognome %s, nome %s, data %s, sesso %s, comune %s "
+                 "(separatore '%s')\n",
+                 columnName(report.columns.codiceFiscale, cf, sizeof(cf)),
+                 columnName(report.columns.surname, surname, sizeof(surname)),
+                 columnName(report.columns.name, name, sizeof(name)),
+                 columnName(report.columns.birthDate, date, sizeof(date)),
+                 columnName(report.columns.sex, sex, sizeof(sex)),
+                 columnName(report.columns.birthplace, place, sizeof(place)),
+                 report.delimiter == '\t' ? "tab" : std::string(1, report.delimiter).c_str());
+    std::fprintf(stderr, "Righe: %llu, valide: %llu, con problemi: %llu\n",
+                 static_cast<unsigned long long>(report.rows),
+                 static_cast<unsigned long long>(report.validRows),
+                 static_cast<unsigned long long>(report.rows - report.validRows));
+    for (size_t c = 0; c < cfparser::CSV_CHECK_COUNT; c++) {
+        if (report.checkCounts[c] > 0) {
+            std::fprintf(stderr, "  %-20s %llu\n", cfparser::csvCheckName(static_cast<cfparser::CsvCheck>(c)),
+                         static_cast<unsigned long long>(report.checkCounts[c]));
+        }
+    }
+    const double megabytes = static_cast<double>(report.bytes) / 1e6;
+    std::fprintf(stderr, "Dati: %.1f MB, tempo: %.2f s, %.0f MB/s\n",
+                 megabytes, seconds, seconds > 0 ? megabytes / seconds : 0.0);
+
+    return report.validRows == report.rows ? 0 : 1;
+}
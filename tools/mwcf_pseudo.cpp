@@ -0,0 +1,185 @@
+/**
+ * @file mwcf_pseudo.cpp
+ * @brief Tool per pseudonimizzare elenchi di codici fiscali
+ *
+ * Uso:
+ *   mwcf_pseudo genera-chiave <chiave.key>
+ *   mwcf_pseudo [-d] [--tweak T] <chiave.key> <input.txt | -> [output.txt]
+ *
+ * Ogni riga dell'input deve contenere un codice fiscale; in uscita c'e' una
+ * riga per riga con lo pseudonimo (con -d, il codice originale a partire
+ * dallo pseudonimo). Le righe senza un codice valido diventano righe
+ * vuote, cosi' la corrispondenza con le altre colonne dell'export resta.
+ * Il tweak (es. il nome dello studio) separa gli pseudonimi di export
+ * diversi fatti con la stessa chiave.
+ *
+ * La chiave e' un file con 32 cifre esadecimali (AES-128).
+ *
+ * Codice di uscita: 0 se tutte le righe sono state convertite, 1 se ci sono
+ * righe non valide, 2 in caso di errore.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "cf_pseudonym.h"
+#include "mapped_file.h"
+
+/// Righe convertite con una sola chiamata a encryptBatch()/decryptBatch()
+static constexpr size_t BATCH_LINES = 4096;
+
+/// Righe piu' lunghe non possono contenere solo un codice
+static constexpr size_t MAX_LINE = 256;
+
+static void printUsage() {
+    std::fprintf(stderr,
+                 "Uso: mwcf_pseudo genera-chiave <chiave.key>\n"
+                 "     mwcf_pseudo [-d] [--tweak T] <chiave.key> <input.txt | -> [output.txt]\n");
+}
+
+static int generateKey(const std::string& path) {
+    std::random_device device;
+    char hex[2 * cfparser::PSEUDONYM_KEY_BYTES + 2];
+    for (size_t i = 0; i < cfparser::PSEUDONYM_KEY_BYTES; i++) {
+        std::snprintf(hex + 2 * i, 3, "%02x", static_cast<unsigned>(device() & 0xFF));
+    }
+    std::strcat(hex, "\n");
+
+    std::FILE* f = cfparser::openFile(path, "wx");
+    if (f == nullptr) {
+        std::fprintf(stderr, "Impossibile creare %s (il file esiste gia'?)\n", path.c_str());
+        return 2;
+    }
+    const bool ok = std::fputs(hex, f) >= 0;
+    if (std::fclose(f) != 0 || !ok) {
+        std::fprintf(stderr, "Errore di scrittura su %s\n", path.c_str());
+        return 2;
+    }
+    return 0;
+}
+
+/**
+ * @brief Estrae il codice di una riga: 16 caratteri ASCII, spazi ai lati ammessi.
+ */
+static bool lineCode(const char* line, size_t length, char16_t* out) {
+    while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r' ||
+                          line[length - 1] == ' ' || line[length - 1] == '\t')) {
+        length--;
+    }
+    while (length > 0 && (*line == ' ' || *line == '\t')) {
+        line++;
+        length--;
+    }
+    if (length != 16) {
+        return false;
+    }
+    for (size_t i = 0; i < 16; i++) {
+        out[i] = static_cast<unsigned char>(line[i]);
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc == 3 && std::strcmp(argv[1], "genera-chiave") == 0) {
+        return generateKey(argv[2]);
+    }
+
+    bool inverse = false;
+    std::string tweak;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "-d") == 0) {
+            inverse = true;
+        } else if (std::strcmp(argv[i], "--tweak") == 0 && i + 1 < argc) {
+            tweak = argv[++i];
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+    if (paths.size() < 2 || paths.size() > 3) {
+        printUsage();
+        return 2;
+    }
+
+    uint8_t key[cfparser::PSEUDONYM_KEY_BYTES];
+    if (!cfparser::readKeyFile(paths[0], key)) {
+        std::fprintf(stderr, "%s: chiave non valida (servono 32 cifre esadecimali)\n", paths[0].c_str());
+        return 2;
+    }
+    const cfparser::Pseudonymizer pseudonymizer(key, tweak);
+
+    std::FILE* input = paths[1] == "-" ? stdin : cfparser::openFile(paths[1], "rb");
+    if (input == nullptr) {
+        std::fprintf(stderr, "Impossibile aprire %s\n", paths[1].c_str());
+        return 2;
+    }
+    std::FILE* output = paths.size() < 3 ? stdout : cfparser::openFile(paths[2], "wb");
+    if (output == nullptr) {
+        std::fprintf(stderr, "Impossibile creare %s\n", paths[2].c_str());
+        return 2;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const std::unique_ptr<char16_t[][16]> codes(new char16_t[BATCH_LINES][16]);
+    std::vector<uint8_t> ok(BATCH_LINES);
+    uint64_t lines = 0;
+    uint64_t converted = 0;
+    char line[MAX_LINE];
+    bool eof = false;
+    while (!eof) {
+        size_t count = 0;
+        while (count < BATCH_LINES) {
+            if (std::fgets(line, sizeof(line), input) == nullptr) {
+                eof = true;
+                break;
+            }
+            size_t length = std::strlen(line);
+            bool found = lineCode(line, length, codes[count]);
+            // Resto di una riga troppo lunga
+            while (length > 0 && line[length - 1] != '\n' && std::fgets(line, sizeof(line), input) != nullptr) {
+                found = false;
+                length = std::strlen(line);
+            }
+            if (!found) {
+                std::fill(codes[count], codes[count] + 16, u'\0');
+            }
+            count++;
+        }
+
+        converted += inverse ? pseudonymizer.decryptBatch(codes.get(), count, codes.get(), ok.data())
+                             : pseudonymizer.encryptBatch(codes.get(), count, codes.get(), ok.data());
+        for (size_t i = 0; i < count; i++) {
+            char text[18];
+            size_t length = 0;
+            if (ok[i]) {
+                for (size_t k = 0; k < 16; k++) {
+                    text[length++] = static_cast<char>(codes[i][k]);
+                }
+            }
+            text[length++] = '\n';
+            std::fwrite(text, 1, length, output);
+        }
+        lines += count;
+    }
+    const bool readError = std::ferror(input) != 0;
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (input != stdin) {
+        std::fclose(input);
+    }
+    const bool closed = output == stdout ? std::fflush(output) == 0 : std::fclose(output) == 0;
+    if (readError || !closed) {
+        std::fprintf(stderr, "%s\n", readError ? "Errore di lettura" : "Errore di scrittura");
+        return 2;
+    }
+
+    std::fprintf(stderr, "Righe: %llu, convertite: %llu, non valide: %llu, tempo: %.2f s (%s)\n",
+                 static_cast<unsigned long long>(lines), static_cast<unsigned long long>(converted),
+                 static_cast<unsigned long long>(lines - converted), seconds,
+                 cfparser::Pseudonymizer::hasHardwareAes() ? "AES-NI" : "AES software");
+    return converted == lines ? 0 : 1;
+}
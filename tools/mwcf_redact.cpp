@@ -0,0 +1,136 @@
+/**
+ * @file mwcf_redact.cpp
+ * @brief Filtro che maschera i codici fiscali in file di testo (es. log)
+ *
+ * Uso:
+ *   mwcf_redact [opzioni] [input | -] [output]
+ *
+ * Opzioni:
+ *   --maschera TESTO   Testo al posto di ogni codice (default: 16 asterischi)
+ *   --chiave FILE      Sostituisce ogni codice con il suo pseudonimo (vedi
+ *                      mwcf_pseudo), reversibile con la chiave
+ *   --tweak T          Tweak degli pseudonimi
+ *   --cin-errati       Maschera anche i codici con CIN errato
+ *
+ * Senza file legge da stdin e scrive su stdout. Il testo (UTF-8, Latin-1,
+ * ASCII) e' letto a blocchi e tutto cio' che non e' un codice fiscale passa
+ * invariato, byte per byte; la memoria usata non dipende dalla dimensione
+ * dell'input. Il riepilogo va su stderr.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include "cf_pseudonym.h"
+#include "cf_redact.h"
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+/// Dimensione dei blocchi letti
+static constexpr size_t CHUNK_BYTES = 1 << 20;
+
+static void printUsage() {
+    std::fprintf(stderr,
+                 "Uso: mwcf_redact [--maschera TESTO] [--chiave chiave.key [--tweak T]] [--cin-errati]\n"
+                 "                 [input | -] [output]\n");
+}
+
+int main(int argc, char** argv) {
+    cfparser::RedactOptions options;
+    std::string keyPath;
+    std::string tweak;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--maschera") == 0 && hasValue) {
+            options.mask = argv[++i];
+        } else if (std::strcmp(argv[i], "--chiave") == 0 && hasValue) {
+            keyPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--tweak") == 0 && hasValue) {
+            tweak = argv[++i];
+        } else if (std::strcmp(argv[i], "--cin-errati") == 0) {
+            options.includeInvalidCIN = true;
+        } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            printUsage();
+            return 2;
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+    if (paths.size() > 2) {
+        printUsage();
+        return 2;
+    }
+
+    std::unique_ptr<cfparser::Pseudonymizer> pseudonymizer;
+    if (!keyPath.empty()) {
+        uint8_t key[cfparser::PSEUDONYM_KEY_BYTES];
+        if (!cfparser::readKeyFile(keyPath, key)) {
+            std::fprintf(stderr, "%s: chiave non valida (servono 32 cifre esadecimali)\n", keyPath.c_str());
+            return 2;
+        }
+        pseudonymizer = std::make_unique<cfparser::Pseudonymizer>(key, tweak);
+        options.pseudonymizer = pseudonymizer.get();
+    }
+
+#ifdef _WIN32
+    // I byte devono passare invariati: niente conversione degli a capo
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    const bool useStdin = paths.empty() || paths[0] == "-";
+    std::FILE* input = useStdin ? stdin : cfparser::openFile(paths[0], "rb");
+    if (input == nullptr) {
+        std::fprintf(stderr, "Impossibile aprire %s\n", paths[0].c_str());
+        return 2;
+    }
+    std::FILE* output = paths.size() < 2 ? stdout : cfparser::openFile(paths[1], "wb");
+    if (output == nullptr) {
+        std::fprintf(stderr, "Impossibile creare %s\n", paths[1].c_str());
+        return 2;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    cfparser::StreamRedactor redactor(options);
+    std::vector<char> chunk(CHUNK_BYTES);
+    std::string out;
+    out.reserve(CHUNK_BYTES + CHUNK_BYTES / 8);
+    uint64_t bytes = 0;
+    bool writeError = false;
+    size_t length;
+    while ((length = std::fread(chunk.data(), 1, chunk.size(), input)) > 0) {
+        bytes += length;
+        out.clear();
+        redactor.feed(chunk.data(), length, out);
+        writeError |= std::fwrite(out.data(), 1, out.size(), output) != out.size();
+    }
+    out.clear();
+    redactor.finish(out);
+    writeError |= std::fwrite(out.data(), 1, out.size(), output) != out.size();
+    const bool readError = std::ferror(input) != 0;
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (input != stdin) {
+        std::fclose(input);
+    }
+    const bool closed = output == stdout ? std::fflush(output) == 0 : std::fclose(output) == 0;
+    if (readError || writeError || !closed) {
+        std::fprintf(stderr, "%s\n", readError ? "Errore di lettura" : "Errore di scrittura");
+        return 2;
+    }
+
+    const double megabytes = static_cast<double>(bytes) / 1e6;
+    std::fprintf(stderr, "Codici mascherati: %llu, con CIN errato non mascherati: %llu, dati: %.1f MB, "
+                 "tempo: %.2f s, %.0f MB/s\n",
+                 static_cast<unsigned long long>(redactor.getRedactedCount()),
+                 static_cast<unsigned long long>(redactor.getSkippedCount()), megabytes, seconds,
+                 seconds > 0 ? megabytes / seconds : 0.0);
+    return 0;
+}
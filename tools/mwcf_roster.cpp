@@ -0,0 +1,196 @@
+/**
+ * @file mwcf_roster.cpp
+ * @brief Tool per costruire e interrogare i file dell'anagrafica pazienti
+ *
+ * Uso:
+ *   mwcf_roster build-filter <anagrafica.txt> <filtro.bin>
+ *   mwcf_roster query <filtro.bin> <codice fiscale>...
+ *   mwcf_roster build-index <anagrafica.txt> <indice.bin>
+ *   mwcf_roster lookup <indice.bin> <codice fiscale>...
+ *
+ * Il file dell'anagrafica e' un testo UTF-8 con un codice fiscale per riga
+ * (il codice puo' essere circondato da altro testo, es. una riga CSV).
+ * L'indice associa a ogni codice l'offset in byte della sua riga.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "cf_parser.h"
+#include "packed_cf.h"
+#include "roster_filter.h"
+#include "roster_index.h"
+
+using cfparser::IndexEntry;
+using cfparser::PackedCF;
+using cfparser::RosterFilter;
+using cfparser::RosterIndex;
+
+// ============================================================================
+// Lettura dell'anagrafica
+// ============================================================================
+
+/**
+ * @brief Legge i codici dell'anagrafica, uno per riga, con l'offset della riga.
+ *
+ * @param rejected Numero di righe non vuote senza un codice valido
+ * @return false se il file non si apre
+ */
+static bool readRoster(const char* path, std::vector<IndexEntry>& roster, size_t& rejected) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    rejected = 0;
+    uint64_t offset = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+        const uint64_t lineOffset = offset;
+        offset += line.size() + 1;
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+        auto code = cfparser::extractCodiceFiscale(std::string_view(line));
+        auto packed = code ? PackedCF::pack(code->data()) : std::nullopt;
+        if (packed) {
+            roster.push_back({*packed, lineOffset});
+        } else {
+            rejected++;
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// Comandi
+// ============================================================================
+
+static int buildFilter(const char* rosterPath, const char* outPath) {
+    std::vector<IndexEntry> roster;
+    size_t rejected = 0;
+    if (!readRoster(rosterPath, roster, rejected)) {
+        std::fprintf(stderr, "Impossibile leggere %s\n", rosterPath);
+        return 1;
+    }
+
+    std::vector<PackedCF> codes;
+    codes.reserve(roster.size());
+    for (const IndexEntry& entry : roster) {
+        codes.push_back(entry.cf);
+    }
+
+    const std::optional<RosterFilter> filter = RosterFilter::build(codes);
+    if (!filter) {
+        std::fprintf(stderr, "Costruzione del filtro non riuscita\n");
+        return 1;
+    }
+    if (!filter->save(outPath)) {
+        std::fprintf(stderr, "Impossibile scrivere %s\n", outPath);
+        return 1;
+    }
+
+    std::printf("Codici letti: %zu (righe scartate: %zu)\n", roster.size(), rejected);
+    std::printf("Pazienti distinti: %llu\n", static_cast<unsigned long long>(filter->getKeyCount()));
+    std::printf("Filtro: %zu byte\n", filter->getSizeBytes());
+    return 0;
+}
+
+static int query(const char* filterPath, int count, char** codes) {
+    RosterFilter filter;
+    if (!filter.load(filterPath)) {
+        std::fprintf(stderr, "Filtro non valido: %s\n", filterPath);
+        return 1;
+    }
+
+    int unknown = 0;
+    for (int i = 0; i < count; i++) {
+        auto code = cfparser::extractCodiceFiscale(std::string_view(codes[i]));
+        auto packed = code ? PackedCF::pack(code->data()) : std::nullopt;
+        if (!packed) {
+            std::printf("%s\tnon valido\n", codes[i]);
+            unknown++;
+        } else if (filter.contains(*packed)) {
+            std::printf("%s\tin anagrafica\n", codes[i]);
+        } else {
+            std::printf("%s\tnon in anagrafica\n", codes[i]);
+            unknown++;
+        }
+    }
+    return unknown == 0 ? 0 : 2;
+}
+
+static int buildIndex(const char* rosterPath, const char* outPath) {
+    std::vector<IndexEntry> roster;
+    size_t rejected = 0;
+    if (!readRoster(rosterPath, roster, rejected)) {
+        std::fprintf(stderr, "Impossibile leggere %s\n", rosterPath);
+        return 1;
+    }
+    const size_t records = roster.size();
+
+    RosterIndex index = RosterIndex::build(std::move(roster));
+    if (!index.save(outPath)) {
+        std::fprintf(stderr, "Impossibile scrivere %s\n", outPath);
+        return 1;
+    }
+
+    std::printf("Codici letti: %zu (righe scartate: %zu)\n", records, rejected);
+    std::printf("Pazienti distinti: %llu\n", static_cast<unsigned long long>(index.getKeyCount()));
+    return 0;
+}
+
+static int lookup(const char* indexPath, int count, char** codes) {
+    RosterIndex index;
+    if (!index.load(indexPath)) {
+        std::fprintf(stderr, "Indice non valido: %s\n", indexPath);
+        return 1;
+    }
+
+    int unknown = 0;
+    for (int i = 0; i < count; i++) {
+        auto code = cfparser::extractCodiceFiscale(std::string_view(codes[i]));
+        auto packed = code ? PackedCF::pack(code->data()) : std::nullopt;
+        auto offset = packed ? index.lookup(*packed) : std::nullopt;
+        if (!packed) {
+            std::printf("%s\tnon valido\n", codes[i]);
+            unknown++;
+        } else if (offset) {
+            std::printf("%s\t%llu\n", codes[i], static_cast<unsigned long long>(*offset));
+        } else {
+            std::printf("%s\tnon in anagrafica\n", codes[i]);
+            unknown++;
+        }
+    }
+    return unknown == 0 ? 0 : 2;
+}
+
+static void printUsage() {
+    std::fprintf(stderr,
+        "Uso:\n"
+        "  mwcf_roster build-filter <anagrafica.txt> <filtro.bin>\n"
+        "  mwcf_roster query <filtro.bin> <codice fiscale>...\n"
+        "  mwcf_roster build-index <anagrafica.txt> <indice.bin>\n"
+        "  mwcf_roster lookup <indice.bin> <codice fiscale>...\n");
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 4 && std::strcmp(argv[1], "build-filter") == 0) {
+        return buildFilter(argv[2], argv[3]);
+    }
+    if (argc >= 4 && std::strcmp(argv[1], "query") == 0) {
+        return query(argv[2], argc - 3, argv + 3);
+    }
+    if (argc >= 4 && std::strcmp(argv[1], "build-index") == 0) {
+        return buildIndex(argv[2], argv[3]);
+    }
+    if (argc >= 4 && std::strcmp(argv[1], "lookup") == 0) {
+        return lookup(argv[2], argc - 3, argv + 3);
+    }
+    printUsage();
+    return 1;
+}
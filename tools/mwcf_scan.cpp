@@ -0,0 +1,346 @@
+/**
+ * @file mwcf_scan.cpp
+ * @brief Tool per cercare codici fiscali in file e cartelle (stile grep)
+ *
+ * Uso:
+ *   mwcf_scan [-j thread] [--json] <file o cartella>...
+ *
+ * Le cartelle vengono esplorate ricorsivamente. Per ogni codice trovato
+ * stampa file, offset in byte, codice, validita' del CIN e forma
+ * normalizzata (senza omocodia); con --json una riga JSON per codice. Il
+ * riepilogo (file, byte, codici, velocita') va su stderr.
+ *
+ * I file vengono mappati in memoria e divisi in blocchi, distribuiti tra i
+ * thread con work stealing. I file UTF-16 (con BOM FF FE) sono letti come
+ * UTF-16; gli altri byte per byte (ASCII, UTF-8, Latin-1).
+ *
+ * Codice di uscita: 0 se e' stato trovato almeno un codice, 1 se nessuno,
+ * 2 in caso di errori di lettura.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+#include "cf_matcher.h"
+#include "cf_parser.h"
+#include "mapped_file.h"
+#include "work_pool.h"
+
+namespace fs = std::filesystem;
+
+/// Dimensione nominale di un blocco
+static constexpr size_t CHUNK_BYTES = 8 << 20;
+
+/// Dati oltre la fine di un blocco letti in anticipo (per trovarne il confine)
+static constexpr size_t BOUNDARY_READAHEAD = 4096;
+
+struct InputFile {
+    fs::path path;
+    std::string displayName;    ///< Percorso in UTF-8, come stampato
+    uint64_t size;
+};
+
+struct Task {
+    size_t file;
+    uint64_t chunk;             ///< Indice del blocco nel file
+};
+
+struct Options {
+    unsigned threads = 0;
+    bool json = false;
+};
+
+// ============================================================================
+// Output ordinato
+// ============================================================================
+
+/**
+ * @brief Scrive i risultati dei blocchi nell'ordine dei blocchi.
+ *
+ * Ogni blocco consegna il proprio testo appena finito; il testo viene
+ * scritto quando anche tutti i blocchi precedenti sono stati scritti.
+ */
+class OrderedOutput {
+public:
+    explicit OrderedOutput(size_t count) : m_pending(count), m_ready(count, false) {}
+
+    void submit(size_t index, std::string&& text) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending[index] = std::move(text);
+        m_ready[index] = true;
+        while (m_next < m_ready.size() && m_ready[m_next]) {
+            std::string& ready = m_pending[m_next];
+            std::fwrite(ready.data(), 1, ready.size(), stdout);
+            std::string().swap(ready);
+            m_next++;
+        }
+    }
+
+private:
+    std::mutex m_mutex;
+    std::vector<std::string> m_pending;
+    std::vector<bool> m_ready;
+    size_t m_next = 0;
+};
+
+// ============================================================================
+// Scansione di un blocco
+// ============================================================================
+
+/**
+ * @brief Confine sicuro vicino a position: la prima posizione in cui non
+ *        termina ne' prosegue alcun codice iniziato prima.
+ *
+ * Un codice non attraversa mai un separatore, quindi di solito il confine
+ * e' il primo separatore. Dentro una sequenza alfanumerica lunga (es. dati
+ * base64) il confine e' la prima posizione q per cui nessun codice inizia
+ * in [q - 15, q - 1]: la ricerca del file intero arriva in q senza un
+ * codice aperto e da li' trova gli stessi codici di una ricerca che parte
+ * da q. In entrambi i casi i blocchi danno esattamente gli stessi
+ * risultati del file intero, ogni codice in un solo blocco.
+ */
+template <typename CharT>
+static size_t safeBoundary(const CharT* text, size_t length, size_t position) {
+    using cfparser::matcher::CF_LENGTH;
+    if (position == 0 || position >= length) {
+        return std::min(position, length);
+    }
+    // Posizioni consecutive, prima di i, in cui non inizia un codice (quelle
+    // prima dell'inizio del file contano come libere)
+    const size_t start = position >= CF_LENGTH - 1 ? position - (CF_LENGTH - 1) : 0;
+    size_t clear = CF_LENGTH - 1 - (position - start);
+    for (size_t i = start; i < length; i++) {
+        if (i >= position && (clear >= CF_LENGTH - 1 ||
+                              cfparser::matcher::symbolOf(text[i]) == cfparser::matcher::SYMBOL_OTHER)) {
+            return i;
+        }
+        const bool starts = i + CF_LENGTH <= length && cfparser::matcher::matchesAt(text + i);
+        clear = starts ? 0 : clear + 1;
+    }
+    return length;
+}
+
+static void appendJsonString(std::string& out, std::string_view text) {
+    out += '"';
+    for (char c : text) {
+        const unsigned char u = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (u < 0x20) {
+            char escape[8];
+            std::snprintf(escape, sizeof(escape), "\\u%04x", u);
+            out += escape;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+struct ChunkStats {
+    uint64_t matches = 0;
+    uint64_t valid = 0;
+};
+
+/**
+ * @brief Cerca i codici nel blocco chunk di un testo e li formatta in out.
+ */
+template <typename CharT>
+static ChunkStats scanChunk(const CharT* text, size_t length, uint64_t chunk,
+                            const InputFile& file, const Options& options, std::string& out) {
+    ChunkStats stats;
+    const size_t chunkUnits = CHUNK_BYTES / sizeof(CharT);
+    const size_t begin = safeBoundary(text, length, static_cast<size_t>(chunk) * chunkUnits);
+    const size_t end = safeBoundary(text, length, static_cast<size_t>(chunk + 1) * chunkUnits);
+    // Nessun codice attraversa end (vedi safeBoundary())
+    const std::basic_string_view<CharT> view(text + begin, end - begin);
+
+    size_t pos = cfparser::findCodiceFiscale(view, 0);
+    while (pos != view.npos) {
+        char code[17];
+        for (size_t i = 0; i < 16; i++) {
+            code[i] = static_cast<char>(view[pos + i]);
+        }
+        code[16] = '\0';
+
+        // Forma normalizzata: cifre al posto delle lettere omocodiche e, se
+        // il codice e' valido, CIN ricalcolato (il codice base della persona)
+        const std::string_view found(code, 16);
+        const bool valid = cfparser::verifyCIN(found);
+        char normalized[17];
+        cfparser::normalizeOmocodia(found, normalized);
+        if (valid) {
+            normalized[15] = cfparser::calculateCIN(std::string_view(normalized, 16));
+        }
+        normalized[16] = '\0';
+
+        const unsigned long long offset =
+            static_cast<unsigned long long>((begin + pos) * sizeof(CharT));
+        char buffer[96];
+        if (options.json) {
+            out += "{\"file\":";
+            appendJsonString(out, file.displayName);
+            std::snprintf(buffer, sizeof(buffer),
+                          ",\"offset\":%llu,\"cf\":\"%s\",\"valid\":%s,\"normalized\":\"%s\"}\n",
+                          offset, code, valid ? "true" : "false", normalized);
+        } else {
+            out += file.displayName;
+            std::snprintf(buffer, sizeof(buffer), ":%llu: %s %s %s\n",
+                          offset, code, valid ? "valido" : "CIN-errato", normalized);
+        }
+        out += buffer;
+
+        stats.matches++;
+        stats.valid += valid ? 1 : 0;
+        pos = cfparser::findCodiceFiscale(view, pos + 16);
+    }
+    return stats;
+}
+
+// ============================================================================
+// Elenco dei file
+// ============================================================================
+
+static void addFile(const fs::path& path, std::vector<InputFile>& files, size_t& errors) {
+    std::error_code error;
+    const uint64_t size = fs::file_size(path, error);
+    if (error) {
+        std::fprintf(stderr, "mwcf_scan: %s: %s\n", path.u8string().c_str(), error.message().c_str());
+        errors++;
+        return;
+    }
+    files.push_back({path, path.u8string(), size});
+}
+
+static void collectFiles(const fs::path& root, std::vector<InputFile>& files, size_t& errors) {
+    std::error_code error;
+    if (!fs::is_directory(root, error)) {
+        addFile(root, files, errors);
+        return;
+    }
+
+    fs::recursive_directory_iterator it(root, fs::directory_options::skip_permission_denied, error);
+    for (; !error && it != fs::recursive_directory_iterator(); it.increment(error)) {
+        std::error_code typeError;
+        if (it->is_regular_file(typeError)) {
+            addFile(it->path(), files, errors);
+        }
+    }
+    if (error) {
+        std::fprintf(stderr, "mwcf_scan: %s: %s\n", root.u8string().c_str(), error.message().c_str());
+        errors++;
+    }
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+static void printUsage() {
+    std::fprintf(stderr, "Uso: mwcf_scan [-j thread] [--json] <file o cartella>...\n");
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    std::vector<fs::path> roots;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            options.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--json") == 0) {
+            options.json = true;
+        } else {
+            roots.push_back(fs::u8path(argv[i]));
+        }
+    }
+    if (roots.empty()) {
+        printUsage();
+        return 2;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<InputFile> files;
+    size_t openErrors = 0;
+    for (const fs::path& root : roots) {
+        collectFiles(root, files, openErrors);
+    }
+
+    std::vector<Task> tasks;
+    for (size_t f = 0; f < files.size(); f++) {
+        const uint64_t chunks = std::max<uint64_t>(1, (files[f].size + CHUNK_BYTES - 1) / CHUNK_BYTES);
+        for (uint64_t chunk = 0; chunk < chunks; chunk++) {
+            tasks.push_back({f, chunk});
+        }
+    }
+
+    OrderedOutput output(tasks.size());
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> matches{0};
+    std::atomic<uint64_t> valid{0};
+    std::atomic<size_t> readErrors{0};
+
+    cfparser::WorkPool pool(options.threads);
+    pool.run(tasks.size(), [&](size_t index, unsigned) {
+        const Task& task = tasks[index];
+        const InputFile& file = files[task.file];
+        std::string text;
+
+        // Ogni blocco mappa il file per conto proprio: vengono lette solo
+        // le pagine del blocco (e dei separatori vicini)
+        cfparser::MappedFile map;
+        if (!map.open(file.path)) {
+            if (task.chunk == 0) {
+                std::fprintf(stderr, "mwcf_scan: %s: impossibile leggere il file\n",
+                             file.displayName.c_str());
+                readErrors++;
+            }
+            output.submit(index, std::move(text));
+            return;
+        }
+
+        const uint8_t* data = map.getData();
+        const size_t size = map.getSize();
+        map.adviseSequential(static_cast<size_t>(task.chunk * CHUNK_BYTES), CHUNK_BYTES + BOUNDARY_READAHEAD);
+
+        ChunkStats stats;
+        if (size >= 2 && data[0] == 0xFF && data[1] == 0xFE) {
+            stats = scanChunk(reinterpret_cast<const char16_t*>(data), size / 2, task.chunk,
+                              file, options, text);
+        } else if (size > 0) {
+            stats = scanChunk(reinterpret_cast<const char*>(data), size, task.chunk,
+                              file, options, text);
+        }
+
+        const uint64_t chunkBegin = task.chunk * CHUNK_BYTES;
+        bytes += std::min<uint64_t>(CHUNK_BYTES, size > chunkBegin ? size - chunkBegin : 0);
+        matches += stats.matches;
+        valid += stats.valid;
+        output.submit(index, std::move(text));
+    });
+    std::fflush(stdout);
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const double megabytes = static_cast<double>(bytes.load()) / 1e6;
+    std::fprintf(stderr,
+                 "File: %zu (errori: %zu), dati: %.1f MB, codici: %llu (validi: %llu), "
+                 "tempo: %.2f s, %.0f MB/s, thread: %u\n",
+                 files.size(), openErrors + readErrors.load(), megabytes,
+                 static_cast<unsigned long long>(matches.load()),
+                 static_cast<unsigned long long>(valid.load()),
+                 seconds, seconds > 0 ? megabytes / seconds : 0.0, pool.getThreadCount());
+
+    if (openErrors + readErrors.load() > 0) {
+        return 2;
+    }
+    return matches.load() > 0 ? 0 : 1;
+}
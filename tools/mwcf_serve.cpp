@@ -0,0 +1,61 @@
+/**
+ * @file mwcf_serve.cpp
+ * @brief Servizio HTTP locale di verifica dei codici fiscali
+ *
+ * Uso:
+ *   mwcf_serve [--porta N] [-j thread]
+ *
+ * Ascolta solo su 127.0.0.1 (default porta 8765, 1 thread) per le
+ * postazioni e le applicazioni dello studio:
+ *
+ *   GET  /validate?cf=RSSMRA85T10A562S
+ *   POST /validate          ["RSSMRA85T10A562S", "VRDLRA80A41H501T", ...]
+ *   GET  /decode?cf=...     POST /decode con lo stesso corpo di /validate
+ *   POST /extract           testo qualsiasi: codici trovati con offset
+ *   GET  /stats             contatori del servizio
+ *
+ * Le connessioni restano aperte (keep-alive) e accettano richieste in
+ * pipelining. Si arresta con Ctrl+C.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "cf_server.h"
+
+static void printUsage() {
+    std::fprintf(stderr, "Uso: mwcf_serve [--porta N] [-j thread]\n");
+}
+
+int main(int argc, char** argv) {
+    cfparser::ServerOptions options;
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--porta") == 0 && hasValue) {
+            char* end = nullptr;
+            const long port = std::strtol(argv[++i], &end, 10);
+            if (end == argv[i] || *end != '\0' || port < 0 || port > 65535) {
+                printUsage();
+                return 2;
+            }
+            options.port = static_cast<uint16_t>(port);
+        } else if (std::strcmp(argv[i], "-j") == 0 && hasValue) {
+            options.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            printUsage();
+            return 2;
+        }
+    }
+
+    cfparser::ServiceServer server;
+    std::string error;
+    if (!server.start(options, error)) {
+        std::fprintf(stderr, "mwcf_serve: %s\n", error.c_str());
+        return 2;
+    }
+    std::fprintf(stderr, "In ascolto su http://127.0.0.1:%u/ (%u thread)\n", static_cast<unsigned>(server.getPort()),
+                 server.getThreadCount());
+    server.run();
+    return 0;
+}
@@ -0,0 +1,157 @@
+/**
+ * @file mwcf_stats.cpp
+ * @brief Tool per le statistiche demografiche di un elenco di codici fiscali
+ *
+ * Uso:
+ *   mwcf_stats [-j thread] [--data AAAAMMGG] <elenco.txt>
+ *
+ * Legge un codice fiscale per riga (il primo codice di ogni riga) e stampa
+ * i conteggi per sesso, fascia d'eta' (5 anni), provincia di nascita e
+ * stato estero di nascita. L'eta' e' calcolata alla data indicata
+ * (default: oggi). La provincia richiede la tabella completa dei codici
+ * catastali: con quella parziale si stampa solo il totale dei nati in
+ * Italia.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "belfiore.h"
+#include "cf_stats.h"
+#include "mapped_file.h"
+
+namespace fs = std::filesystem;
+
+static double percent(uint64_t part, uint64_t total) {
+    return total > 0 ? 100.0 * static_cast<double>(part) / static_cast<double>(total) : 0.0;
+}
+
+/**
+ * @brief Indici non nulli di un istogramma, dal piu' frequente.
+ */
+static std::vector<size_t> sortedSlots(const uint64_t* counts, size_t size) {
+    std::vector<size_t> slots;
+    for (size_t i = 0; i < size; i++) {
+        if (counts[i] > 0) {
+            slots.push_back(i);
+        }
+    }
+    std::stable_sort(slots.begin(), slots.end(),
+                     [counts](size_t a, size_t b) { return counts[a] > counts[b]; });
+    return slots;
+}
+
+/**
+ * @brief Nati in Italia per provincia, dalla piu' frequente.
+ */
+static void printProvinces(const cfparser::PopulationStats& stats) {
+    std::printf("\n%-10s %12s\n", "Provincia", "Nati");
+    for (size_t slot : sortedSlots(stats.byProvince, cfparser::PROVINCE_SLOTS)) {
+        const char province[3] = {static_cast<char>('A' + slot / 26), static_cast<char>('A' + slot % 26), '\0'};
+        std::printf("%-10s %12llu\n", province, static_cast<unsigned long long>(stats.byProvince[slot]));
+    }
+    if (stats.unknownBirthplace > 0) {
+        std::printf("%-10s %12llu\n", "(ignota)", static_cast<unsigned long long>(stats.unknownBirthplace));
+    }
+}
+
+static void printReport(const cfparser::PopulationStats& stats) {
+    const uint64_t total = stats.codes;
+    std::printf("Codici validi: %llu (righe scartate: %llu)\n",
+                static_cast<unsigned long long>(total),
+                static_cast<unsigned long long>(stats.rejected));
+    std::printf("Maschi: %llu (%.1f%%), femmine: %llu (%.1f%%)\n\n",
+                static_cast<unsigned long long>(stats.bySex[0]), percent(stats.bySex[0], total),
+                static_cast<unsigned long long>(stats.bySex[1]), percent(stats.bySex[1], total));
+
+    std::printf("%-10s %12s %12s %12s\n", "Eta'", "Maschi", "Femmine", "Totale");
+    for (size_t band = 0; band < cfparser::AGE_BAND_COUNT; band++) {
+        const uint64_t males = stats.byAgeBand[band][0];
+        const uint64_t females = stats.byAgeBand[band][1];
+        char label[16];
+        std::snprintf(label, sizeof(label), "%zu-%zu", band * cfparser::AGE_BAND_YEARS,
+                      (band + 1) * cfparser::AGE_BAND_YEARS - 1);
+        std::printf("%-10s %12llu %12llu %12llu\n", label, static_cast<unsigned long long>(males),
+                    static_cast<unsigned long long>(females),
+                    static_cast<unsigned long long>(males + females));
+    }
+
+    // Con la tabella parziale quasi tutti i comuni sarebbero "(ignota)": la
+    // ripartizione per provincia non e' significativa e non viene stampata
+    if (cfparser::belfiore::isTableComplete()) {
+        printProvinces(stats);
+    } else {
+        uint64_t italy = stats.unknownBirthplace;
+        for (size_t slot = 0; slot < cfparser::PROVINCE_SLOTS; slot++) {
+            italy += stats.byProvince[slot];
+        }
+        std::printf("\nNati in Italia: %llu (%.1f%%)\n"
+                    "Provincia di nascita non disponibile: la tabella dei codici catastali\n"
+                    "incorporata e' parziale (rigenerarla con scripts/Generate-BelfioreTable.ps1)\n",
+                    static_cast<unsigned long long>(italy), percent(italy, total));
+    }
+
+    std::printf("\n%-30s %12s\n", "Stato estero", "Nati");
+    for (size_t slot : sortedSlots(stats.byCountry, cfparser::COUNTRY_SLOTS)) {
+        char code[5];
+        std::snprintf(code, sizeof(code), "Z%03zu", slot);
+        char label[64];
+        const cfparser::belfiore::Place* place = cfparser::belfiore::lookup(code);
+        if (place != nullptr) {
+            // Denominazione ASCII per la console (le lettere accentate restano '?')
+            size_t n = 0;
+            for (const wchar_t* p = place->name; *p != L'\0' && n < 24; p++) {
+                label[n++] = *p < 0x80 ? static_cast<char>(*p) : '?';
+            }
+            std::snprintf(label + n, sizeof(label) - n, " (%s)", code);
+        } else {
+            std::snprintf(label, sizeof(label), "%s", code);
+        }
+        std::printf("%-30s %12llu\n", label, static_cast<unsigned long long>(stats.byCountry[slot]));
+    }
+}
+
+int main(int argc, char** argv) {
+    unsigned threads = 0;
+    uint32_t referenceDate = 0;
+    const char* path = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--data") == 0 && i + 1 < argc) {
+            referenceDate = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (path == nullptr) {
+            path = argv[i];
+        } else {
+            path = nullptr;
+            break;
+        }
+    }
+    if (path == nullptr) {
+        std::fprintf(stderr, "Uso: mwcf_stats [-j thread] [--data AAAAMMGG] <elenco.txt>\n");
+        return 2;
+    }
+
+    cfparser::MappedFile file;
+    if (!file.open(fs::u8path(path))) {
+        std::fprintf(stderr, "Impossibile leggere %s\n", path);
+        return 2;
+    }
+    file.adviseSequential(0, file.getSize());
+
+    const auto start = std::chrono::steady_clock::now();
+    const std::string_view text(reinterpret_cast<const char*>(file.getData()), file.getSize());
+    const cfparser::PopulationStats stats = cfparser::aggregateCodeList(text, referenceDate, threads);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printReport(stats);
+    std::fprintf(stderr, "Tempo: %.2f s (%.1f milioni di codici al secondo)\n", seconds,
+                 seconds > 0 ? static_cast<double>(stats.codes + stats.rejected) / seconds / 1e6 : 0.0);
+    return 0;
+}